@@ -16,6 +16,11 @@
  */
 
 #include "ARIA.h"
+#include "../CIPHER/CIPHER.h"
+#include "../PROFILE/PROFILE.h"
+
+// keys interleaved by ARIA_init_many
+#define INIT_GROUP 8
 
 // constants
 const uint32_t C1[4] = { 0x517cc1b7, 0x27220a94, 0xfe13abe8, 0xfa9a6ee0 };
@@ -254,6 +259,10 @@ static void A(uint32_t* input, uint32_t* output)
 	output[3] = y12 << 24 | y13 << 16 | y14 << 8 | y15;
 }
 
+#ifdef CIPHER_PROFILE
+#define A(input, output) PROFILE_CALL_VOID(PROFILE_ARIA_A, A(input, output))
+#endif
+
 static void FO(uint32_t* D, uint32_t* RK, uint32_t* output)
 {
 	// A(SL1(D ^ RK))
@@ -384,23 +393,14 @@ static void generateDecryptionKeys(uint32_t eks[][4], uint32_t dks[][4], uint32_
 	MOV_128(dks[dkPos], eks[ekPos]);
 }
 
-void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
+/*
+	KR, the key words past the first 128 bits, and the constants in the
+	order of the key length; returns the number of rounds
+*/
+static uint32_t loadKey(const uint32_t* key, uint32_t keyLength, uint32_t* KR, uint32_t* CK1, uint32_t* CK2, uint32_t* CK3)
 {
-	uint32_t W0[4];
-	uint32_t W1[4];
-	uint32_t W2[4];
-	uint32_t W3[4];
-
-	uint32_t CK1[4];
-	uint32_t CK2[4];
-	uint32_t CK3[4];
-
-	uint32_t KR[4];
-
 	if (keyLength == 128)
 	{
-		context->rounds = 13;
-
 		KR[0] = 0;
 		KR[1] = 0;
 		KR[2] = 0;
@@ -409,11 +409,11 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 		MOV_128(CK1, C1);
 		MOV_128(CK2, C2);
 		MOV_128(CK3, C3);
+
+		return 13;
 	}
 	else if (keyLength == 192)
 	{
-		context->rounds = 15;
-
 		KR[0] = key[4];
 		KR[1] = key[5];
 		KR[2] = 0;
@@ -422,11 +422,11 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 		MOV_128(CK1, C2);
 		MOV_128(CK2, C3);
 		MOV_128(CK3, C1);
+
+		return 15;
 	}
 	else // 256
 	{
-		context->rounds = 17;
-
 		KR[0] = key[4];
 		KR[1] = key[5];
 		KR[2] = key[6];
@@ -435,7 +435,29 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 		MOV_128(CK1, C3);
 		MOV_128(CK2, C1);
 		MOV_128(CK3, C2);
+
+		return 17;
 	}
+}
+
+/*
+	Expands only the encryption subkeys (eks). Enough for modes that never
+	call ARIA_decrypt (CTR, CFB, OFB, GCM), skipping the dks derivation.
+*/
+void ARIA_init_encrypt(AriaContext* context, const uint32_t* key, uint32_t keyLength)
+{
+	uint32_t W0[4];
+	uint32_t W1[4];
+	uint32_t W2[4];
+	uint32_t W3[4];
+
+	uint32_t CK1[4];
+	uint32_t CK2[4];
+	uint32_t CK3[4];
+
+	uint32_t KR[4];
+
+	context->rounds = loadKey(key, keyLength, KR, CK1, CK2, CK3);
 
 	// Init registers
 	MOV_128(W0, key);
@@ -449,11 +471,96 @@ void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
 	FO(W2, CK3, W3);
 	XOR_128(W3, W1);
 
-	// generate encryption and decryption keys
+	// generate encryption keys
 	generateEncryptionKeys(W0, W1, W2, W3, context->eks);
+}
+
+void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength)
+{
+	ARIA_init_encrypt(context, key, keyLength);
+
+	// decryption keys are derived from the encryption ones
 	generateDecryptionKeys(context->eks, context->dks, context->rounds);
 }
 
+/*
+	count key schedules, INIT_GROUP keys interleaved: each of the FO, FE,
+	FO steps that give W1, W2 and W3 runs for every key of the group
+	before the next one, so the table lookups of different keys overlap.
+*/
+void ARIA_init_many(AriaContext** contexts, const uint32_t* keys, uint32_t keyLength, size_t count)
+{
+	size_t nrWords = keyLength / 32;
+	uint32_t W0[INIT_GROUP][4];
+	uint32_t W1[INIT_GROUP][4];
+	uint32_t W2[INIT_GROUP][4];
+	uint32_t W3[INIT_GROUP][4];
+	uint32_t KR[INIT_GROUP][4];
+
+	uint32_t CK1[4];
+	uint32_t CK2[4];
+	uint32_t CK3[4];
+
+	size_t n;
+	size_t l;
+
+	for (; count > 0; count -= n, contexts += n, keys += n * nrWords)
+	{
+		n = count < INIT_GROUP ? count : INIT_GROUP;
+
+		for (l = 0; l < n; l++)
+		{
+			contexts[l]->rounds = loadKey(keys + l * nrWords, keyLength, KR[l], CK1, CK2, CK3);
+			MOV_128(W0[l], keys + l * nrWords);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			FO(W0[l], CK1, W1[l]);
+			XOR_128(W1[l], KR[l]);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			FE(W1[l], CK2, W2[l]);
+			XOR_128(W2[l], W0[l]);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			FO(W2[l], CK3, W3[l]);
+			XOR_128(W3[l], W1[l]);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			generateEncryptionKeys(W0[l], W1[l], W2[l], W3[l], contexts[l]->eks);
+			generateDecryptionKeys(contexts[l]->eks, contexts[l]->dks, contexts[l]->rounds);
+		}
+	}
+}
+
+/*
+	ARIA_init_encrypt and ARIA_encrypt of nrBlocks blocks (4 words each)
+	under one key, with the encryption subkeys in a context on the stack.
+*/
+void ARIA_encrypt_keyed(const uint32_t* key, uint32_t keyLength, const uint32_t* blocks, uint32_t* out, size_t nrBlocks)
+{
+	AriaContext context;
+	uint32_t block[4];
+	size_t i;
+
+	ARIA_init_encrypt(&context, key, keyLength);
+
+	for (i = 0; i < nrBlocks; i++)
+	{
+		MOV_128(block, blocks + 4 * i);
+		ARIA_encrypt(&context, block, out + 4 * i);
+	}
+
+	CIPHER_wipe(&context, sizeof(context));
+}
+
 void ARIA_encrypt(AriaContext* context, uint32_t* block, uint32_t* P)
 {
 	uint32_t round = 0;
@@ -519,6 +626,21 @@ void ARIA_decrypt(AriaContext* context, uint32_t* block, uint32_t* P)
 	XOR_128(P, context->dks[subkey++]);
 }
 
+// SL1/SL2 read SB1..SB4, returns the size of the table or 0 past the last one
+size_t ARIA_lookup_table(int index, const void** address)
+{
+	static const void* tables[4] = { SB1, SB2, SB3, SB4 };
+	static const size_t sizes[4] = { sizeof(SB1), sizeof(SB2), sizeof(SB3), sizeof(SB4) };
+
+	if (index < 0 || index >= 4)
+	{
+		return 0;
+	}
+
+	*address = tables[index];
+	return sizes[index];
+}
+
 void ARIA_main(void)
 {
 	AriaContext context;
@@ -19,7 +19,13 @@ typedef struct
 } AriaContext;
 
 void ARIA_init(AriaContext* context, const uint32_t* key, uint32_t keyLength);
+void ARIA_init_encrypt(AriaContext* context, const uint32_t* key, uint32_t keyLength);
+// count keys of keyLength / 32 words one after the other, same as ARIA_init on each
+void ARIA_init_many(AriaContext** contexts, const uint32_t* keys, uint32_t keyLength, size_t count);
 void ARIA_encrypt(AriaContext* context, uint32_t* block, uint32_t* P);
 void ARIA_decrypt(AriaContext* context, uint32_t* block, uint32_t* P);
+// ARIA_init_encrypt + ARIA_encrypt of nrBlocks blocks of 4 words under the key, without a context
+void ARIA_encrypt_keyed(const uint32_t* key, uint32_t keyLength, const uint32_t* blocks, uint32_t* out, size_t nrBlocks);
+size_t ARIA_lookup_table(int index, const void** address);
 
 void ARIA_main(void);
\ No newline at end of file
@@ -0,0 +1,307 @@
+/* BCHASH.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Hash functions built from the 128 bits block ciphers: Matyas-Meyer-Oseas
+ * and Miyaguchi-Preneel (single block length) and Hirose (double block
+ * length, with a 256 bits key).
+ *
+ * This code follows a specification:
+ *		- Handbook of Applied Cryptography, section 9.4.1 (MMO and MP)
+ *		- S. Hirose, Some Plausible Constructions of Double-Block-Length
+ *		  Hash Functions, FSE 2006
+ *
+ * Messages are padded with 0x80, zeros and their 64 bits big-endian
+ * length in bits, to a multiple of 16 bytes; the chaining values start
+ * at zero. The key of every compression is the chaining value, so each
+ * one goes through CIPHER_encrypt_keyed (key schedule merged with the
+ * rounds). BCHASH_hash_many runs the chains of up to BCHASH_GROUP
+ * messages side by side: step j compresses block j of every message that
+ * is still running in a single keyed call, which fills the vector lanes.
+ *
+ */
+
+#include <string.h>
+
+#include "BCHASH.h"
+#include "../SELFTEST/SELFTEST.h"
+
+// messages hashed together by BCHASH_hash_many
+#define BCHASH_GROUP 64
+// Hirose constant, xored into the last byte of G
+#define HIROSE_C 0x01
+
+typedef struct
+{
+	const uint8_t* message;
+	size_t length;
+	size_t nrBlocks;
+	uint8_t state[BCHASH_MAX_DIGEST_SIZE];
+} Chain;
+
+// keys and plaintexts of a step laid out for CIPHER_encrypt_keyed
+typedef struct
+{
+	uint8_t keys[BCHASH_GROUP * 32];
+	uint8_t in[BCHASH_GROUP * 32];
+	uint8_t out[BCHASH_GROUP * 32];
+} Workspace;
+
+static const char* names[BCHASH_MODE_COUNT] = { "MMO", "MP", "HIROSE" };
+
+const char* BCHASH_name(BchashMode mode)
+{
+	return (unsigned)mode < BCHASH_MODE_COUNT ? names[mode] : NULL;
+}
+
+size_t BCHASH_digest_size(BchashMode mode)
+{
+	return mode == BCHASH_HIROSE ? 32 : 16;
+}
+
+/*
+	One compression of count chains, block i of blocks into states[i]: the
+	encryptions of all of them (two per chain for Hirose, under the same
+	key) in one CIPHER_encrypt_keyed call.
+*/
+static void compress(BchashMode mode, CipherId id, uint8_t** states, const uint8_t* blocks, size_t count, Workspace* w)
+{
+	uint8_t* keys = w->keys;
+	uint8_t* in = w->in;
+	uint8_t* out = w->out;
+	size_t i;
+	int b;
+
+	if (mode == BCHASH_HIROSE)
+	{
+		// key H || m, plaintexts G and G ^ c
+		for (i = 0; i < count; i++)
+		{
+			memcpy(keys + 32 * i, states[i] + 16, 16);
+			memcpy(keys + 32 * i + 16, blocks + 16 * i, 16);
+			memcpy(in + 32 * i, states[i], 16);
+			memcpy(in + 32 * i + 16, states[i], 16);
+			in[32 * i + 31] ^= HIROSE_C;
+		}
+
+		CIPHER_encrypt_keyed(id, keys, 256, in, out, count, 2);
+
+		for (i = 0; i < count; i++)
+		{
+			for (b = 0; b < 32; b++)
+			{
+				states[i][b] = out[32 * i + b] ^ in[32 * i + b];
+			}
+		}
+	}
+	else
+	{
+		for (i = 0; i < count; i++)
+		{
+			memcpy(keys + 16 * i, states[i], 16);
+		}
+
+		CIPHER_encrypt_keyed(id, keys, 128, blocks, out, count, 1);
+
+		for (i = 0; i < count; i++)
+		{
+			for (b = 0; b < 16; b++)
+			{
+				states[i][b] = (mode == BCHASH_MP ? states[i][b] : 0) ^ out[16 * i + b] ^ blocks[16 * i + b];
+			}
+		}
+	}
+}
+
+CipherStatus BCHASH_init(BchashContext* context, BchashMode mode, CipherId id)
+{
+	const CipherDescriptor* cipher = CIPHER_get(id);
+
+	if (cipher == NULL || cipher->blockSize != BCHASH_BLOCK_SIZE || (unsigned)mode >= BCHASH_MODE_COUNT)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	if (!CIPHER_supports_key_length(cipher, mode == BCHASH_HIROSE ? 256 : 128))
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+
+#ifndef CIPHER_NO_SELFTEST
+	if (SELFTEST_cipher(id) != CIPHER_OK)
+	{
+		return CIPHER_ERROR_SELFTEST;
+	}
+#endif
+
+	context->mode = mode;
+	context->id = id;
+	memset(context->state, 0, sizeof(context->state));
+	context->bufferLength = 0;
+	context->length = 0;
+
+	return CIPHER_OK;
+}
+
+void BCHASH_update(BchashContext* context, const uint8_t* data, size_t length)
+{
+	Workspace workspace;
+	uint8_t* state = context->state;
+	size_t n;
+
+	context->length += length;
+
+	if (context->bufferLength > 0)
+	{
+		n = BCHASH_BLOCK_SIZE - context->bufferLength;
+		n = length < n ? length : n;
+		memcpy(context->buffer + context->bufferLength, data, n);
+		context->bufferLength += n;
+		data += n;
+		length -= n;
+
+		if (context->bufferLength < BCHASH_BLOCK_SIZE)
+		{
+			return;
+		}
+
+		compress(context->mode, context->id, &state, context->buffer, 1, &workspace);
+		context->bufferLength = 0;
+	}
+
+	for (; length >= BCHASH_BLOCK_SIZE; data += BCHASH_BLOCK_SIZE, length -= BCHASH_BLOCK_SIZE)
+	{
+		compress(context->mode, context->id, &state, data, 1, &workspace);
+	}
+
+	memcpy(context->buffer, data, length);
+	context->bufferLength = length;
+}
+
+void BCHASH_final(BchashContext* context, uint8_t* digest)
+{
+	Workspace workspace;
+	uint8_t* state = context->state;
+	uint64_t bits = context->length * 8;
+	int i;
+
+	context->buffer[context->bufferLength++] = 0x80;
+	if (context->bufferLength > BCHASH_BLOCK_SIZE - 8)
+	{
+		memset(context->buffer + context->bufferLength, 0, BCHASH_BLOCK_SIZE - context->bufferLength);
+		compress(context->mode, context->id, &state, context->buffer, 1, &workspace);
+		context->bufferLength = 0;
+	}
+
+	memset(context->buffer + context->bufferLength, 0, BCHASH_BLOCK_SIZE - 8 - context->bufferLength);
+	for (i = 0; i < 8; i++)
+	{
+		context->buffer[BCHASH_BLOCK_SIZE - 8 + i] = (uint8_t)(bits >> (56 - 8 * i));
+	}
+	compress(context->mode, context->id, &state, context->buffer, 1, &workspace);
+
+	memcpy(digest, context->state, BCHASH_digest_size(context->mode));
+}
+
+static size_t paddedBlocks(size_t length)
+{
+	return (length + 1 + 8 + BCHASH_BLOCK_SIZE - 1) / BCHASH_BLOCK_SIZE;
+}
+
+// block index of the padded message of the chain
+static void paddedBlock(const Chain* chain, size_t index, uint8_t* out)
+{
+	size_t offset = index * BCHASH_BLOCK_SIZE;
+	size_t lengthStart = chain->nrBlocks * BCHASH_BLOCK_SIZE - 8;
+	uint64_t bits = (uint64_t)chain->length * 8;
+	size_t position;
+	int i;
+
+	if (offset + BCHASH_BLOCK_SIZE <= chain->length)
+	{
+		memcpy(out, chain->message + offset, BCHASH_BLOCK_SIZE);
+		return;
+	}
+
+	for (i = 0; i < BCHASH_BLOCK_SIZE; i++)
+	{
+		position = offset + i;
+		if (position < chain->length)
+		{
+			out[i] = chain->message[position];
+		}
+		else if (position == chain->length)
+		{
+			out[i] = 0x80;
+		}
+		else if (position >= lengthStart)
+		{
+			out[i] = (uint8_t)(bits >> (56 - 8 * (position - lengthStart)));
+		}
+		else
+		{
+			out[i] = 0;
+		}
+	}
+}
+
+CipherStatus BCHASH_hash_many(BchashMode mode, CipherId id, const uint8_t* const* messages, const size_t* lengths,
+							  uint8_t* const* digests, size_t count)
+{
+	BchashContext check;
+	Chain chains[BCHASH_GROUP];
+	uint8_t* states[BCHASH_GROUP];
+	uint8_t blocks[BCHASH_GROUP * BCHASH_BLOCK_SIZE];
+	Workspace workspace;
+	CipherStatus status;
+	size_t nrSteps;
+	size_t active;
+	size_t step;
+	size_t n;
+	size_t i;
+
+	status = BCHASH_init(&check, mode, id);
+	if (status != CIPHER_OK)
+	{
+		return status;
+	}
+
+	for (; count > 0; count -= n, messages += n, lengths += n, digests += n)
+	{
+		n = count < BCHASH_GROUP ? count : BCHASH_GROUP;
+
+		nrSteps = 0;
+		for (i = 0; i < n; i++)
+		{
+			chains[i].message = messages[i];
+			chains[i].length = lengths[i];
+			chains[i].nrBlocks = paddedBlocks(lengths[i]);
+			memset(chains[i].state, 0, sizeof(chains[i].state));
+			nrSteps = chains[i].nrBlocks > nrSteps ? chains[i].nrBlocks : nrSteps;
+		}
+
+		// the chains that are done drop out, the others are packed
+		for (step = 0; step < nrSteps; step++)
+		{
+			active = 0;
+			for (i = 0; i < n; i++)
+			{
+				if (step < chains[i].nrBlocks)
+				{
+					paddedBlock(&chains[i], step, blocks + active * BCHASH_BLOCK_SIZE);
+					states[active++] = chains[i].state;
+				}
+			}
+
+			compress(mode, id, states, blocks, active, &workspace);
+		}
+
+		for (i = 0; i < n; i++)
+		{
+			memcpy(digests[i], chains[i].state, BCHASH_digest_size(mode));
+		}
+	}
+
+	return CIPHER_OK;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+/* BCHASH.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+#define BCHASH_BLOCK_SIZE 16
+#define BCHASH_MAX_DIGEST_SIZE 32
+
+typedef enum
+{
+	// H' = E_H(m) ^ m, 128 bits digest
+	BCHASH_MMO = 0,
+	// H' = E_H(m) ^ m ^ H, 128 bits digest
+	BCHASH_MP,
+	// G' = E_H||m(G) ^ G, H' = E_H||m(G ^ c) ^ G ^ c, 256 bits digest G || H
+	BCHASH_HIROSE,
+	BCHASH_MODE_COUNT
+} BchashMode;
+
+typedef struct
+{
+	BchashMode mode;
+	CipherId id;
+	// H, or G || H for Hirose
+	uint8_t state[BCHASH_MAX_DIGEST_SIZE];
+	uint8_t buffer[BCHASH_BLOCK_SIZE];
+	size_t bufferLength;
+	uint64_t length;
+} BchashContext;
+
+const char* BCHASH_name(BchashMode mode);
+size_t BCHASH_digest_size(BchashMode mode);
+
+/*
+	MMO and MP need a 128 bits cipher with 128 bits keys, Hirose a 128 bits
+	cipher with 256 bits keys: CIPHER_ERROR_ID or CIPHER_ERROR_KEY_LENGTH
+	otherwise, CIPHER_ERROR_SELFTEST when its known answers fail.
+*/
+CipherStatus BCHASH_init(BchashContext* context, BchashMode mode, CipherId id);
+void BCHASH_update(BchashContext* context, const uint8_t* data, size_t length);
+void BCHASH_final(BchashContext* context, uint8_t* digest);
+
+/*
+	digests[i] of messages[i] (lengths[i] bytes) for count messages, the
+	same as init/update/final on each: the chains of many messages advance
+	together, every encryption of a step in one key-agile batch call.
+*/
+CipherStatus BCHASH_hash_many(BchashMode mode, CipherId id, const uint8_t* const* messages, const size_t* lengths,
+							  uint8_t* const* digests, size_t count);
\ No newline at end of file
@@ -0,0 +1,486 @@
+/* BURST.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Burst of independent operations (GCM seal/open, CTR), as a packet
+ * gateway receives them: many short payloads, each with its own key,
+ * nonce and AAD. Calling GCM_seal per packet leaves most lanes of the
+ * batch kernels empty, so the burst is processed as a whole.
+ *
+ * The operations are grouped by key, then for each key:
+ *		- the GHASH of every open (AAD, ciphertext, lengths) runs on all
+ *		  of them at once with GCM_ghash_many, before the keystream can
+ *		  overwrite an in-place ciphertext
+ *		- the counter blocks of all the operations, tag masks E(J0)
+ *		  included, are packed into shared CIPHER_encrypt_blocks calls of
+ *		  BATCH_BLOCKS blocks, whatever the payload lengths
+ *		- the GHASH of every seal then runs at once on the ciphertexts
+ *		- the tags are finished (seal) or checked (open)
+ *
+ */
+
+#include <string.h>
+
+#include "BURST.h"
+#include "../MODES/MODES.h"
+#include "../STATS/STATS.h"
+
+// counter blocks per shared batch call
+#define BATCH_BLOCKS 64
+// offset of the keystream block that is the tag mask E(J0)
+#define MASK_BLOCK SIZE_MAX
+
+typedef struct
+{
+	// valid operations grouped by key, in their order within a group
+	size_t order[BURST_MAX_OPS];
+	uint8_t J0[BURST_MAX_OPS][GCM_BLOCK_SIZE];
+	uint8_t S[BURST_MAX_OPS][GCM_BLOCK_SIZE];
+	uint8_t mask[BURST_MAX_OPS][GCM_BLOCK_SIZE];
+	uint8_t lengths[BURST_MAX_OPS][GCM_BLOCK_SIZE];
+} Workspace;
+
+/*
+	Counter blocks of a shared batch call, as runs of consecutive blocks
+	of the same operation: its index, payload offset and number of blocks
+*/
+typedef struct
+{
+	uint8_t blocks[BATCH_BLOCKS * CIPHER_MAX_BLOCK_SIZE];
+	size_t owner[BATCH_BLOCKS];
+	size_t offset[BATCH_BLOCKS];
+	size_t runBlocks[BATCH_BLOCKS];
+	size_t nrRuns;
+	size_t nrBlocks;
+} Batch;
+
+static void STORE_64(uint8_t* p, uint64_t x)
+{
+	int i;
+
+	for (i = 7; i >= 0; i--)
+	{
+		p[i] = (uint8_t)x;
+		x >>= 8;
+	}
+}
+
+// increments the rightmost 32 bits of the counter block, as GCM
+static void inc32(uint8_t* counter)
+{
+	int i;
+
+	for (i = 15; i >= 12; i--)
+	{
+		if (++counter[i] != 0)
+		{
+			break;
+		}
+	}
+}
+
+static int isGcm(const BurstOp* op)
+{
+	return op->operation == BURST_GCM_SEAL || op->operation == BURST_GCM_OPEN;
+}
+
+// GHASH tables of the operation, none for CTR
+static const GcmContext* tablesOf(const BurstOp* op)
+{
+	return isGcm(op) ? op->gcm : NULL;
+}
+
+static CipherContext* keyOf(const BurstOp* op)
+{
+	return isGcm(op) ? op->gcm->cipher : op->cipher;
+}
+
+static CipherStatus validate(const BurstOp* op)
+{
+	if (isGcm(op))
+	{
+		if (op->gcm == NULL)
+		{
+			return CIPHER_ERROR_ID;
+		}
+
+		return op->nonceLength == 0 || op->tagLength < 4 || op->tagLength > GCM_TAG_SIZE ? CIPHER_ERROR_LENGTH : CIPHER_OK;
+	}
+
+	if (op->operation != BURST_CTR || op->cipher == NULL)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	return op->nonceLength == op->cipher->cipher->blockSize ? CIPHER_OK : CIPHER_ERROR_LENGTH;
+}
+
+// encrypts the counter blocks of the batch and applies them to their operations
+static void flush(CipherContext* cipher, BurstOp* ops, Workspace* w, Batch* batch)
+{
+	size_t blockSize = cipher->cipher->blockSize;
+	const uint8_t* keystream = batch->blocks;
+	size_t r;
+	size_t i;
+
+	CIPHER_encrypt_blocks(cipher, batch->blocks, batch->blocks, batch->nrBlocks);
+
+	for (r = 0; r < batch->nrRuns; r++)
+	{
+		const BurstOp* op = &ops[batch->owner[r]];
+		size_t offset = batch->offset[r];
+		size_t chunk = batch->runBlocks[r] * blockSize;
+
+		if (offset == MASK_BLOCK)
+		{
+			memcpy(w->mask[batch->owner[r]], keystream, GCM_BLOCK_SIZE);
+		}
+		else
+		{
+			const uint8_t* in = op->in + offset;
+			uint8_t* out = op->out + offset;
+			size_t length = op->length - offset < chunk ? op->length - offset : chunk;
+
+			for (i = 0; i < length; i++)
+			{
+				out[i] = in[i] ^ keystream[i];
+			}
+		}
+
+		keystream += chunk;
+	}
+
+	batch->nrRuns = 0;
+	batch->nrBlocks = 0;
+}
+
+// appends a run of the operation, flushes the batch once full
+static void addRun(CipherContext* cipher, BurstOp* ops, Workspace* w, Batch* batch, size_t owner, size_t offset, size_t nrBlocks)
+{
+	batch->owner[batch->nrRuns] = owner;
+	batch->offset[batch->nrRuns] = offset;
+	batch->runBlocks[batch->nrRuns] = nrBlocks;
+	batch->nrRuns++;
+	batch->nrBlocks += nrBlocks;
+
+	if (batch->nrBlocks == BATCH_BLOCKS)
+	{
+		flush(cipher, ops, w, batch);
+	}
+}
+
+// the keystream of the operations order[first .. last - 1], all of the same cipher
+static void keystream(BurstOp* ops, Workspace* w, size_t first, size_t last)
+{
+	CipherContext* cipher = keyOf(&ops[w->order[first]]);
+	size_t blockSize = cipher->cipher->blockSize;
+	uint8_t counter[CIPHER_MAX_BLOCK_SIZE];
+	Batch batch;
+	size_t remaining;
+	size_t offset;
+	size_t n;
+	size_t b;
+	size_t k;
+
+	batch.nrRuns = 0;
+	batch.nrBlocks = 0;
+
+	for (k = first; k < last; k++)
+	{
+		size_t index = w->order[k];
+		BurstOp* op = &ops[index];
+		int gcm = isGcm(op);
+
+		if (gcm)
+		{
+			memcpy(batch.blocks + batch.nrBlocks * blockSize, w->J0[index], GCM_BLOCK_SIZE);
+			addRun(cipher, ops, w, &batch, index, MASK_BLOCK, 1);
+			memcpy(counter, w->J0[index], GCM_BLOCK_SIZE);
+			inc32(counter);
+		}
+		else
+		{
+			memcpy(counter, op->nonce, blockSize);
+		}
+
+		remaining = (op->length + blockSize - 1) / blockSize;
+		for (offset = 0; remaining > 0; offset += n * blockSize, remaining -= n)
+		{
+			n = BATCH_BLOCKS - batch.nrBlocks < remaining ? BATCH_BLOCKS - batch.nrBlocks : remaining;
+			for (b = 0; b < n; b++)
+			{
+				memcpy(batch.blocks + (batch.nrBlocks + b) * blockSize, counter, blockSize);
+				if (gcm)
+				{
+					inc32(counter);
+				}
+				else
+				{
+					MODES_counter_increment(counter, blockSize);
+				}
+			}
+			addRun(cipher, ops, w, &batch, index, offset, n);
+		}
+	}
+
+	if (batch.nrBlocks > 0)
+	{
+		flush(cipher, ops, w, &batch);
+	}
+}
+
+/*
+	S = GHASH(AAD, ciphertext, lengths) of the operations of the given
+	kind in order[first .. last - 1], with one GCM_ghash_many per run of
+	operations sharing the same tables. The ciphertext is the input of an
+	open and the output of a seal.
+*/
+static void ghash(BurstOp* ops, Workspace* w, size_t first, size_t last, BurstOperation operation)
+{
+	uint8_t* X[BURST_MAX_OPS];
+	const uint8_t* data[BURST_MAX_OPS];
+	size_t lengths[BURST_MAX_OPS];
+	size_t n;
+	size_t i;
+	size_t k;
+	size_t end;
+
+	for (k = first; k < last; k = end)
+	{
+		const GcmContext* gcm = tablesOf(&ops[w->order[k]]);
+
+		for (end = k; end < last && tablesOf(&ops[w->order[end]]) == gcm; end++)
+		{
+		}
+
+		if (gcm == NULL)
+		{
+			continue;
+		}
+
+		n = 0;
+		for (i = k; i < end; i++)
+		{
+			size_t index = w->order[i];
+			BurstOp* op = &ops[index];
+
+			if (op->operation == operation)
+			{
+				memset(w->S[index], 0, GCM_BLOCK_SIZE);
+				STORE_64(w->lengths[index], (uint64_t)op->aadLength * 8);
+				STORE_64(w->lengths[index] + 8, (uint64_t)op->length * 8);
+				X[n] = w->S[index];
+				data[n] = op->aad;
+				lengths[n] = op->aadLength;
+				n++;
+			}
+		}
+
+		if (n == 0)
+		{
+			continue;
+		}
+
+		GCM_ghash_many(gcm, X, data, lengths, n);
+
+		n = 0;
+		for (i = k; i < end; i++)
+		{
+			BurstOp* op = &ops[w->order[i]];
+
+			if (op->operation == operation)
+			{
+				data[n] = operation == BURST_GCM_OPEN ? op->in : op->out;
+				lengths[n] = op->length;
+				n++;
+			}
+		}
+		GCM_ghash_many(gcm, X, data, lengths, n);
+
+		n = 0;
+		for (i = k; i < end; i++)
+		{
+			size_t index = w->order[i];
+
+			if (ops[index].operation == operation)
+			{
+				data[n] = w->lengths[index];
+				lengths[n] = GCM_BLOCK_SIZE;
+				n++;
+			}
+		}
+		GCM_ghash_many(gcm, X, data, lengths, n);
+	}
+}
+
+static void finish(BurstOp* op, Workspace* w, size_t index)
+{
+	uint8_t fullTag[GCM_BLOCK_SIZE];
+	uint8_t difference = 0;
+	size_t i;
+
+	if (!isGcm(op))
+	{
+		op->status = CIPHER_OK;
+		return;
+	}
+
+	for (i = 0; i < GCM_BLOCK_SIZE; i++)
+	{
+		fullTag[i] = w->S[index][i] ^ w->mask[index][i];
+	}
+
+	if (op->operation == BURST_GCM_SEAL)
+	{
+		memcpy(op->tag, fullTag, op->tagLength);
+		op->status = CIPHER_OK;
+		return;
+	}
+
+	// constant time comparison
+	for (i = 0; i < op->tagLength; i++)
+	{
+		difference |= fullTag[i] ^ op->tag[i];
+	}
+
+	if (difference != 0)
+	{
+		// the payload was decrypted with the others, it must not be released
+		memset(op->out, 0, op->length);
+		op->status = CIPHER_ERROR_TAG;
+		return;
+	}
+
+	op->status = CIPHER_OK;
+}
+
+/*
+	Groups the valid operations by key (cipher and GHASH tables) into
+	w->order, returns the number of groups and their ends in groupEnd.
+	Bursts carry a few keys, the group of an operation is searched
+	linearly from the one of the previous operation.
+*/
+static size_t groupByKey(BurstOp* ops, const size_t* valid, size_t nrValid, Workspace* w, size_t* groupEnd)
+{
+	const CipherContext* groupCipher[BURST_MAX_OPS];
+	const GcmContext* groupTables[BURST_MAX_OPS];
+	size_t groupOf[BURST_MAX_OPS];
+	size_t nrGroups = 0;
+	size_t g = 0;
+	size_t i;
+
+	for (i = 0; i < nrValid; i++)
+	{
+		const BurstOp* op = &ops[valid[i]];
+		const CipherContext* cipher = keyOf(op);
+		const GcmContext* tables = tablesOf(op);
+		size_t tries;
+
+		for (tries = 0; tries < nrGroups; tries++, g = g + 1 < nrGroups ? g + 1 : 0)
+		{
+			if (groupCipher[g] == cipher && groupTables[g] == tables)
+			{
+				break;
+			}
+		}
+
+		if (tries == nrGroups)
+		{
+			g = nrGroups++;
+			groupCipher[g] = cipher;
+			groupTables[g] = tables;
+			groupEnd[g] = 0;
+		}
+
+		groupOf[i] = g;
+		groupEnd[g]++;
+	}
+
+	// counting sort, stable within a group
+	for (g = 1; g < nrGroups; g++)
+	{
+		groupEnd[g] += groupEnd[g - 1];
+	}
+	for (i = nrValid; i > 0; i--)
+	{
+		w->order[--groupEnd[groupOf[i - 1]]] = valid[i - 1];
+	}
+	for (g = 0; g < nrGroups; g++)
+	{
+		groupEnd[g] = g + 1 < nrGroups ? groupEnd[g + 1] : nrValid;
+	}
+
+	return nrGroups;
+}
+
+static size_t processPart(BurstOp* ops, size_t count)
+{
+	Workspace w;
+	size_t valid[BURST_MAX_OPS];
+	size_t groupEnd[BURST_MAX_OPS];
+	size_t nrValid = 0;
+	size_t nrFailed = 0;
+	size_t nrGroups;
+	size_t first;
+	size_t last;
+	size_t g;
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		ops[i].status = validate(&ops[i]);
+		if (ops[i].status != CIPHER_OK)
+		{
+			nrFailed++;
+			continue;
+		}
+
+		valid[nrValid++] = i;
+	}
+
+	nrGroups = groupByKey(ops, valid, nrValid, &w, groupEnd);
+
+	for (g = 0, first = 0; g < nrGroups; g++, first = last)
+	{
+		last = groupEnd[g];
+
+		for (i = first; i < last; i++)
+		{
+			BurstOp* op = &ops[w.order[i]];
+
+			if (isGcm(op))
+			{
+				GCM_pre_counter(op->gcm, op->nonce, op->nonceLength, w.J0[w.order[i]]);
+			}
+			STATS_MODE(isGcm(op) ? STATS_MODE_GCM : STATS_MODE_CTR, op->length);
+		}
+
+		// opens hash their ciphertext before it may be overwritten
+		ghash(ops, &w, first, last, BURST_GCM_OPEN);
+		keystream(ops, &w, first, last);
+		ghash(ops, &w, first, last, BURST_GCM_SEAL);
+
+		for (i = first; i < last; i++)
+		{
+			finish(&ops[w.order[i]], &w, w.order[i]);
+			nrFailed += ops[w.order[i]].status != CIPHER_OK;
+		}
+	}
+
+	return nrFailed;
+}
+
+size_t BURST_process(BurstOp* ops, size_t count)
+{
+	size_t nrFailed = 0;
+	size_t n;
+
+	for (; count > 0; count -= n, ops += n)
+	{
+		n = count < BURST_MAX_OPS ? count : BURST_MAX_OPS;
+		nrFailed += processPart(ops, n);
+	}
+
+	return nrFailed;
+}
\ No newline at end of file
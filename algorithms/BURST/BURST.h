@@ -0,0 +1,54 @@
+/* BURST.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+#include "../GCM/GCM.h"
+
+// operations grouped by key at once, larger bursts are processed in parts
+#define BURST_MAX_OPS 256
+
+typedef enum
+{
+	BURST_GCM_SEAL = 0,
+	BURST_GCM_OPEN,
+	// CTR keystream, the nonce is the initial counter block (one block long)
+	BURST_CTR
+} BurstOperation;
+
+/*
+	One independent operation of a burst, with its own key, nonce, AAD and
+	payload. in and out may be the same buffer; an open whose tag does not
+	match has its out zeroed.
+*/
+typedef struct
+{
+	BurstOperation operation;
+	// key: gcm for the GCM operations, cipher for CTR
+	GcmContext* gcm;
+	CipherContext* cipher;
+	const uint8_t* nonce;
+	size_t nonceLength;
+	const uint8_t* aad;
+	size_t aadLength;
+	const uint8_t* in;
+	uint8_t* out;
+	size_t length;
+	// written by a seal, checked by an open, from 4 to 16 bytes
+	uint8_t* tag;
+	size_t tagLength;
+	// set by BURST_process, as GCM_seal/GCM_open would return it
+	CipherStatus status;
+} BurstOp;
+
+// processes count operations, returns how many did not end with CIPHER_OK
+size_t BURST_process(BurstOp* ops, size_t count);
\ No newline at end of file
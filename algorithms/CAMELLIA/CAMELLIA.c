@@ -17,6 +17,11 @@
  */
 
 #include "CAMELLIA.h"
+#include "../CIPHER/CIPHER.h"
+#include "../PROFILE/PROFILE.h"
+
+// keys interleaved by CAMELLIA_init_many
+#define INIT_GROUP 8
 
 static const uint64_t sigma[6] =
 {
@@ -186,19 +191,18 @@ uint64_t FLINV(uint64_t FLINV_IN, uint64_t KE)
 	return ((uint64_t)y1 << 32) | y2;
 }
 
-void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLen)
+#ifdef CIPHER_PROFILE
+#define F(F_IN, KE) PROFILE_CALL(PROFILE_CAMELLIA_F, F(F_IN, KE))
+#define FL(FL_IN, KE) PROFILE_CALL(PROFILE_CAMELLIA_FL, FL(FL_IN, KE))
+#define FLINV(FLINV_IN, KE) PROFILE_CALL(PROFILE_CAMELLIA_FLINV, FLINV(FLINV_IN, KE))
+#endif
+
+/*
+	KL and KR of the key, and the number of Feistel iterations and subkeys
+	of its length (128, 192 or 256)
+*/
+static void splitKey(CamelliaContext* context, const uint64_t* key, uint16_t keyLen, uint64_t* KL, uint64_t* KR)
 {
-	uint8_t i;
-	uint64_t temp[2];
-
-	uint64_t KL[2];
-	uint64_t KR[2];
-	uint64_t KA[2];
-	uint64_t KB[2];
-	uint64_t D1;
-	uint64_t D2;
-
-	// generate KL and KR
 	if (keyLen == 128)
 	{
 		// 18 (nr rounds) / 6 (nr rounds required for each feistel iteration)
@@ -210,7 +214,7 @@ void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLe
 		KR[0] = 0;
 		KR[1] = 0;
 	}
-	else if (keyLen == 192 || keyLen == 256)
+	else
 	{
 		// 24 (nr rounds) / 6 (nr rounds required for each feistel iteration)
 		context->feistelIterations = 4;
@@ -219,21 +223,18 @@ void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLe
 		KL[0] = key[0];
 		KL[1] = key[1];
 		KR[0] = key[2];
-		KR[1] = key[3];
 
 		// special treatment for 192-bits key
-		if (keyLen == 192)
-		{
-			KR[1] = ~key[2];
-		}
-	}
-	else
-	{
-		//TODO create return status
-		return;
+		KR[1] = keyLen == 192 ? ~key[2] : key[3];
 	}
+}
+
+// KB is only used by 192 and 256 bits keys
+static void generateKAKB(const uint64_t* KL, const uint64_t* KR, uint64_t* KA, uint64_t* KB, uint16_t keyLen)
+{
+	uint64_t D1;
+	uint64_t D2;
 
-	// generate KA and KB
 	D1 = KL[0] ^ KR[0];
 	D2 = KL[1] ^ KR[1];
 	D2 = D2 ^ F(D1, sigma[0]);
@@ -244,12 +245,23 @@ void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLe
 	D1 = D1 ^ F(D2, sigma[3]);
 	KA[0] = D1;
 	KA[1] = D2;
+	if (keyLen == 128)
+	{
+		return;
+	}
+
 	D1 = KA[0] ^ KR[0];
 	D2 = KA[1] ^ KR[1];
 	D2 = D2 ^ F(D1, sigma[4]);
 	D1 = D1 ^ F(D2, sigma[5]);
 	KB[0] = D1;
 	KB[1] = D2;
+}
+
+static void generateSubkeys(CamelliaContext* context, uint64_t* KL, uint64_t* KR, uint64_t* KA, uint64_t* KB, uint16_t keyLen)
+{
+	uint8_t i;
+	uint64_t temp[2];
 
 	// generate subkeys
 	i = 0;
@@ -385,6 +397,122 @@ void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLe
 	}
 }
 
+void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLen)
+{
+	uint64_t KL[2];
+	uint64_t KR[2];
+	uint64_t KA[2];
+	uint64_t KB[2];
+
+	if (keyLen != 128 && keyLen != 192 && keyLen != 256)
+	{
+		//TODO create return status
+		return;
+	}
+
+	// generate KL and KR
+	splitKey(context, key, keyLen, KL, KR);
+
+	// generate KA and KB
+	generateKAKB(KL, KR, KA, KB, keyLen);
+
+	generateSubkeys(context, KL, KR, KA, KB, keyLen);
+}
+
+/*
+	count key schedules, INIT_GROUP keys interleaved: each of the six F()
+	that give KA and KB runs for every key of the group before the next
+	one, so the s-box lookups of different keys overlap.
+*/
+void CAMELLIA_init_many(CamelliaContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count)
+{
+	size_t nrWords = keyLen / 64;
+	uint64_t KL[INIT_GROUP][2];
+	uint64_t KR[INIT_GROUP][2];
+	uint64_t KA[INIT_GROUP][2];
+	uint64_t KB[INIT_GROUP][2];
+	uint64_t D1[INIT_GROUP];
+	uint64_t D2[INIT_GROUP];
+	size_t n;
+	size_t l;
+
+	for (; count > 0; count -= n, contexts += n, keys += n * nrWords)
+	{
+		n = count < INIT_GROUP ? count : INIT_GROUP;
+
+		for (l = 0; l < n; l++)
+		{
+			splitKey(contexts[l], keys + l * nrWords, keyLen, KL[l], KR[l]);
+			D1[l] = KL[l][0] ^ KR[l][0];
+			D2[l] = KL[l][1] ^ KR[l][1];
+			D2[l] ^= F(D1[l], sigma[0]);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			D1[l] ^= F(D2[l], sigma[1]);
+			D1[l] ^= KL[l][0];
+			D2[l] ^= KL[l][1];
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			D2[l] ^= F(D1[l], sigma[2]);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			D1[l] ^= F(D2[l], sigma[3]);
+			KA[l][0] = D1[l];
+			KA[l][1] = D2[l];
+			D1[l] ^= KR[l][0];
+			D2[l] ^= KR[l][1];
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			D2[l] ^= F(D1[l], sigma[4]);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			D1[l] ^= F(D2[l], sigma[5]);
+			KB[l][0] = D1[l];
+			KB[l][1] = D2[l];
+			generateSubkeys(contexts[l], KL[l], KR[l], KA[l], KB[l], keyLen);
+		}
+	}
+}
+
+/*
+	CAMELLIA_init and CAMELLIA_encrypt of nrBlocks blocks (2 words each)
+	under one key, with the schedule in a context on the stack.
+*/
+void CAMELLIA_encrypt_keyed(const uint64_t* key, uint16_t keyLen, const uint64_t* blocks, uint64_t* out, size_t nrBlocks)
+{
+	CamelliaContext context;
+	uint64_t KL[2];
+	uint64_t KR[2];
+	uint64_t KA[2];
+	uint64_t KB[2];
+	size_t i;
+
+	splitKey(&context, key, keyLen, KL, KR);
+	generateKAKB(KL, KR, KA, KB, keyLen);
+	generateSubkeys(&context, KL, KR, KA, KB, keyLen);
+
+	for (i = 0; i < nrBlocks; i++)
+	{
+		CAMELLIA_encrypt(&context, blocks + 2 * i, out + 2 * i);
+	}
+
+	CIPHER_wipe(&context, sizeof(context));
+	CIPHER_wipe(KL, sizeof(KL));
+	CIPHER_wipe(KR, sizeof(KR));
+	CIPHER_wipe(KA, sizeof(KA));
+	CIPHER_wipe(KB, sizeof(KB));
+}
+
 void CAMELLIA_encrypt(const CamelliaContext* context, const uint64_t* block, uint64_t* out)
 {
 	// D[0] is D1 and D[1] is D2
@@ -477,6 +605,21 @@ void CAMELLIA_decrypt(const CamelliaContext* context, const uint64_t* block, uin
 	out[1] = D[0];
 }
 
+// F() reads sbox1..sbox4, returns the size of the table or 0 past the last one
+size_t CAMELLIA_lookup_table(int index, const void** address)
+{
+	static const void* tables[4] = { sbox1, sbox2, sbox3, sbox4 };
+	static const size_t sizes[4] = { sizeof(sbox1), sizeof(sbox2), sizeof(sbox3), sizeof(sbox4) };
+
+	if (index < 0 || index >= 4)
+	{
+		return 0;
+	}
+
+	*address = tables[index];
+	return sizes[index];
+}
+
 void CAMELLIA_main(void)
 {
 	CamelliaContext context;
@@ -18,7 +18,12 @@ typedef struct
 } CamelliaContext;
 
 void CAMELLIA_init(CamelliaContext* context, const uint64_t* key, uint16_t keyLen);
+// count keys of keyLen / 64 words one after the other, same as CAMELLIA_init on each
+void CAMELLIA_init_many(CamelliaContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count);
 void CAMELLIA_encrypt(const CamelliaContext* context, const uint64_t* block, uint64_t* out);
 void CAMELLIA_decrypt(const CamelliaContext* context, const uint64_t* block, uint64_t* out);
+// CAMELLIA_init + CAMELLIA_encrypt of nrBlocks blocks of 2 words under the key, without a context
+void CAMELLIA_encrypt_keyed(const uint64_t* key, uint16_t keyLen, const uint64_t* blocks, uint64_t* out, size_t nrBlocks);
+size_t CAMELLIA_lookup_table(int index, const void** address);
 
 void CAMELLIA_main(void);
\ No newline at end of file
@@ -0,0 +1,141 @@
+/* CASCADE.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Cascade of two block ciphers with independent keys (e.g. CAMELLIA
+ * then SEED) in a single pass over the data.
+ *
+ * The data is cut in L1 sized tiles and each tile goes through both
+ * ciphers before the next one is read, instead of two full passes over
+ * memory. Inside a tile the two ciphers are software pipelined: the
+ * first one runs one group of blocks ahead of the second, so the calls
+ * alternate on independent data and the core can overlap the table
+ * lookups of one cipher with the ALU work of the other.
+ *
+ */
+
+#include "CASCADE.h"
+
+// smallest group of blocks per kernel call, to amortize the call
+#define MIN_GROUP_BLOCKS 16
+
+typedef void (*BlocksFunction)(CipherContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks);
+
+// multiple of the lanes of both kernels, so no call leaves a partial vector
+static size_t groupBlocks(const CipherContext* a, const CipherContext* b)
+{
+	size_t x = CIPHER_kernel_lanes(a->cipher, a->kernel);
+	size_t y = CIPHER_kernel_lanes(b->cipher, b->kernel);
+	size_t gcd = x;
+	size_t r = y;
+	size_t group;
+
+	while (r != 0)
+	{
+		size_t t = gcd % r;
+
+		gcd = r;
+		r = t;
+	}
+
+	group = x / gcd * y;
+	while (group < MIN_GROUP_BLOCKS)
+	{
+		group *= 2;
+	}
+
+	return group;
+}
+
+static void cascade(CipherContext* a, CipherContext* b, BlocksFunction pass,
+					const uint8_t* in, uint8_t* out, size_t nrBlocks)
+{
+	size_t blockSize = a->cipher->blockSize;
+	size_t tileBlocks = CASCADE_TILE_SIZE / blockSize;
+	size_t group = groupBlocks(a, b);
+	size_t tile;
+	size_t offset;
+	size_t previous;
+	size_t count;
+
+	if (group > tileBlocks)
+	{
+		tileBlocks = group;
+	}
+
+	while (nrBlocks > 0)
+	{
+		tile = nrBlocks < tileBlocks ? nrBlocks : tileBlocks;
+		previous = 0;
+
+		for (offset = 0; offset < tile; offset += count)
+		{
+			count = tile - offset < group ? tile - offset : group;
+
+			// group k through the first cipher, then group k - 1 (still in L1) through the second
+			pass(a, in + offset * blockSize, out + offset * blockSize, count);
+			if (offset > 0)
+			{
+				pass(b, out + (offset - previous) * blockSize, out + (offset - previous) * blockSize, previous);
+			}
+			previous = count;
+		}
+		pass(b, out + (tile - previous) * blockSize, out + (tile - previous) * blockSize, previous);
+
+		in += tile * blockSize;
+		out += tile * blockSize;
+		nrBlocks -= tile;
+	}
+}
+
+CipherStatus CASCADE_init(CascadeContext* context, CipherContext* first, CipherContext* second)
+{
+	if (first->cipher->blockSize != second->cipher->blockSize)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	context->first = first;
+	context->second = second;
+
+	return CIPHER_OK;
+}
+
+void CASCADE_encrypt_blocks(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks)
+{
+	cascade(context->first, context->second, CIPHER_encrypt_blocks, in, out, nrBlocks);
+}
+
+void CASCADE_decrypt_blocks(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks)
+{
+	cascade(context->second, context->first, CIPHER_decrypt_blocks, in, out, nrBlocks);
+}
+
+CipherStatus CASCADE_ecb_encrypt(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t length)
+{
+	size_t blockSize = context->first->cipher->blockSize;
+
+	if (length % blockSize != 0)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	CASCADE_encrypt_blocks(context, in, out, length / blockSize);
+
+	return CIPHER_OK;
+}
+
+CipherStatus CASCADE_ecb_decrypt(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t length)
+{
+	size_t blockSize = context->first->cipher->blockSize;
+
+	if (length % blockSize != 0)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	CASCADE_decrypt_blocks(context, in, out, length / blockSize);
+
+	return CIPHER_OK;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+/* CASCADE.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+// data encrypted by both ciphers before moving on, sized to stay in L1
+#define CASCADE_TILE_SIZE 4096
+
+typedef struct
+{
+	// independent keys, the first cipher is applied first when encrypting
+	CipherContext* first;
+	CipherContext* second;
+} CascadeContext;
+
+// CIPHER_ERROR_ID when the two ciphers have different block sizes
+CipherStatus CASCADE_init(CascadeContext* context, CipherContext* first, CipherContext* second);
+
+// second(first(block)) for nrBlocks blocks, in and out may be the same buffer
+void CASCADE_encrypt_blocks(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks);
+void CASCADE_decrypt_blocks(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks);
+
+// length must be a multiple of the block size
+CipherStatus CASCADE_ecb_encrypt(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t length);
+CipherStatus CASCADE_ecb_decrypt(CascadeContext* context, const uint8_t* in, uint8_t* out, size_t length);
\ No newline at end of file
@@ -0,0 +1,1152 @@
+/* CIPHER.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Generic, byte oriented access to every block cipher of the
+ * repository through a table of descriptors, so benchmarks and
+ * modes of operation can be written once for all of them.
+ *
+ */
+
+#include <string.h>
+
+#include "CIPHER.h"
+#include "../PROBES/PROBES.h"
+#include "../SELFTEST/SELFTEST.h"
+#include "../STATS/STATS.h"
+
+// keys handed to the initMany function of a descriptor at once
+#define INIT_MANY_GROUP 64
+// blocks encrypted per key schedule by the scalar encryptKeyed functions
+#define KEYED_BLOCKS 8
+// contexts of the CIPHER_encrypt_keyed fallback
+#define KEYED_GROUP 16
+
+static uint16_t LOAD_16(const uint8_t* p)
+{
+	return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+static void STORE_16(uint8_t* p, uint16_t x)
+{
+	p[0] = (uint8_t)(x >> 8);
+	p[1] = (uint8_t)x;
+}
+
+static uint32_t LOAD_32(const uint8_t* p)
+{
+	return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static void STORE_32(uint8_t* p, uint32_t x)
+{
+	p[0] = (uint8_t)(x >> 24);
+	p[1] = (uint8_t)(x >> 16);
+	p[2] = (uint8_t)(x >> 8);
+	p[3] = (uint8_t)x;
+}
+
+static uint64_t LOAD_64(const uint8_t* p)
+{
+	return (uint64_t)LOAD_32(p) << 32 | LOAD_32(p + 4);
+}
+
+static void STORE_64(uint8_t* p, uint64_t x)
+{
+	STORE_32(p, (uint32_t)(x >> 32));
+	STORE_32(p + 4, (uint32_t)x);
+}
+
+static uint32_t LOAD_32_LE(const uint8_t* p)
+{
+	return (uint32_t)p[3] << 24 | (uint32_t)p[2] << 16 | (uint32_t)p[1] << 8 | p[0];
+}
+
+static uint64_t LOAD_64_LE(const uint8_t* p)
+{
+	return (uint64_t)LOAD_32_LE(p + 4) << 32 | LOAD_32_LE(p);
+}
+
+static void STORE_64_LE(uint8_t* p, uint64_t x)
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		p[i] = (uint8_t)(x >> (8 * i));
+	}
+}
+
+// ARIA
+
+static void ariaInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t k[8] = { 0 };
+	int i;
+
+	for (i = 0; i < keyLen / 32; i++)
+	{
+		k[i] = LOAD_32(key + 4 * i);
+	}
+	ARIA_init((AriaContext*)context, k, keyLen);
+}
+
+static void ariaInitEncrypt(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t k[8] = { 0 };
+	int i;
+
+	for (i = 0; i < keyLen / 32; i++)
+	{
+		k[i] = LOAD_32(key + 4 * i);
+	}
+	ARIA_init_encrypt((AriaContext*)context, k, keyLen);
+}
+
+static void ariaInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	AriaContext* c[INIT_MANY_GROUP];
+	uint32_t k[INIT_MANY_GROUP * 8];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (AriaContext*)contexts[i];
+	}
+	for (i = 0; i < count * keyLen / 32; i++)
+	{
+		k[i] = LOAD_32(keys + 4 * i);
+	}
+	ARIA_init_many(c, k, keyLen, count);
+}
+
+static void ariaEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t b[4] = { LOAD_32(block), LOAD_32(block + 4), LOAD_32(block + 8), LOAD_32(block + 12) };
+	uint32_t o[4];
+	int i;
+
+	ARIA_encrypt((AriaContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_32(out + 4 * i, o[i]);
+	}
+}
+
+static void ariaDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t b[4] = { LOAD_32(block), LOAD_32(block + 4), LOAD_32(block + 8), LOAD_32(block + 12) };
+	uint32_t o[4];
+	int i;
+
+	ARIA_decrypt((AriaContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_32(out + 4 * i, o[i]);
+	}
+}
+
+static void ariaEncryptKeyed(const uint8_t* keys, uint16_t keyLen, const uint8_t* in, uint8_t* out, size_t count, size_t blocksPerKey)
+{
+	uint32_t k[8] = { 0 };
+	uint32_t b[KEYED_BLOCKS * 4];
+	size_t n;
+	size_t i;
+	size_t j;
+	size_t l;
+
+	for (i = 0; i < count; i++, keys += keyLen / 8)
+	{
+		for (l = 0; l < keyLen / 32u; l++)
+		{
+			k[l] = LOAD_32(keys + 4 * l);
+		}
+
+		for (j = 0; j < blocksPerKey; j += n, in += n * 16, out += n * 16)
+		{
+			n = blocksPerKey - j < KEYED_BLOCKS ? blocksPerKey - j : KEYED_BLOCKS;
+			for (l = 0; l < 4 * n; l++)
+			{
+				b[l] = LOAD_32(in + 4 * l);
+			}
+			ARIA_encrypt_keyed(k, keyLen, b, b, n);
+			for (l = 0; l < 4 * n; l++)
+			{
+				STORE_32(out + 4 * l, b[l]);
+			}
+		}
+	}
+}
+
+// CAMELLIA
+
+static void camelliaInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t k[4] = { 0 };
+	int i;
+
+	for (i = 0; i < keyLen / 64; i++)
+	{
+		k[i] = LOAD_64(key + 8 * i);
+	}
+	CAMELLIA_init((CamelliaContext*)context, k, keyLen);
+}
+
+static void camelliaInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	CamelliaContext* c[INIT_MANY_GROUP];
+	uint64_t k[INIT_MANY_GROUP * 4];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (CamelliaContext*)contexts[i];
+	}
+	for (i = 0; i < count * keyLen / 64; i++)
+	{
+		k[i] = LOAD_64(keys + 8 * i);
+	}
+	CAMELLIA_init_many(c, k, keyLen, count);
+}
+
+static void camelliaEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t b[2] = { LOAD_64(block), LOAD_64(block + 8) };
+	uint64_t o[2];
+
+	CAMELLIA_encrypt((CamelliaContext*)context, b, o);
+	STORE_64(out, o[0]);
+	STORE_64(out + 8, o[1]);
+}
+
+static void camelliaDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t b[2] = { LOAD_64(block), LOAD_64(block + 8) };
+	uint64_t o[2];
+
+	CAMELLIA_decrypt((CamelliaContext*)context, b, o);
+	STORE_64(out, o[0]);
+	STORE_64(out + 8, o[1]);
+}
+
+static void camelliaEncryptKeyed(const uint8_t* keys, uint16_t keyLen, const uint8_t* in, uint8_t* out, size_t count, size_t blocksPerKey)
+{
+	uint64_t k[4] = { 0 };
+	uint64_t b[KEYED_BLOCKS * 2];
+	size_t n;
+	size_t i;
+	size_t j;
+	size_t l;
+
+	for (i = 0; i < count; i++, keys += keyLen / 8)
+	{
+		for (l = 0; l < keyLen / 64u; l++)
+		{
+			k[l] = LOAD_64(keys + 8 * l);
+		}
+
+		for (j = 0; j < blocksPerKey; j += n, in += n * 16, out += n * 16)
+		{
+			n = blocksPerKey - j < KEYED_BLOCKS ? blocksPerKey - j : KEYED_BLOCKS;
+			for (l = 0; l < 2 * n; l++)
+			{
+				b[l] = LOAD_64(in + 8 * l);
+			}
+			CAMELLIA_encrypt_keyed(k, keyLen, b, b, n);
+			for (l = 0; l < 2 * n; l++)
+			{
+				STORE_64(out + 8 * l, b[l]);
+			}
+		}
+	}
+}
+
+// GOST
+
+static void gostInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t* k = (uint32_t*)context;
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		k[i] = LOAD_32_LE(key + 4 * i);
+	}
+}
+
+static void gostEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	STORE_64_LE(out, GOST_encrypt(LOAD_64_LE(block), (uint32_t*)context));
+}
+
+static void gostDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	STORE_64_LE(out, GOST_decrypt(LOAD_64_LE(block), (uint32_t*)context));
+}
+
+// HIGHT
+
+static void hightInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint8_t k[16];
+
+	memcpy(k, key, sizeof(k));
+	HIGHT_init((HightContext*)context, k);
+}
+
+static void hightInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	HightContext* c[INIT_MANY_GROUP];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (HightContext*)contexts[i];
+	}
+	HIGHT_init_many(c, keys, count);
+}
+
+static void hightEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint8_t b[8];
+
+	memcpy(b, block, sizeof(b));
+	HIGHT_encrypt((HightContext*)context, b, out);
+}
+
+static void hightDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint8_t b[8];
+
+	memcpy(b, block, sizeof(b));
+	HIGHT_decrypt((HightContext*)context, b, out);
+}
+
+// IDEA
+
+static void ideaInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint16_t k[8];
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		k[i] = LOAD_16(key + 2 * i);
+	}
+	IDEA_init((IdeaContext*)context, k);
+}
+
+static void ideaInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	IdeaContext* c[INIT_MANY_GROUP];
+	uint16_t k[INIT_MANY_GROUP * 8];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (IdeaContext*)contexts[i];
+	}
+	for (i = 0; i < count * 8; i++)
+	{
+		k[i] = LOAD_16(keys + 2 * i);
+	}
+	IDEA_init_many(c, k, count);
+}
+
+static void ideaInitEncrypt(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint16_t k[8];
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		k[i] = LOAD_16(key + 2 * i);
+	}
+	IDEA_init_encrypt((IdeaContext*)context, k);
+}
+
+static void ideaEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t b[4] = { LOAD_16(block), LOAD_16(block + 2), LOAD_16(block + 4), LOAD_16(block + 6) };
+	uint16_t o[4];
+	int i;
+
+	IDEA_encrypt((IdeaContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_16(out + 2 * i, o[i]);
+	}
+}
+
+static void ideaDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t b[4] = { LOAD_16(block), LOAD_16(block + 2), LOAD_16(block + 4), LOAD_16(block + 6) };
+	uint16_t o[4];
+	int i;
+
+	IDEA_decrypt((IdeaContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_16(out + 2 * i, o[i]);
+	}
+}
+
+// NOEKEON
+
+static void noekeonInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint32_t* k = (uint32_t*)context;
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		k[i] = LOAD_32(key + 4 * i);
+	}
+}
+
+static void noekeonEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t b[4] = { LOAD_32(block), LOAD_32(block + 4), LOAD_32(block + 8), LOAD_32(block + 12) };
+	uint32_t o[4];
+	int i;
+
+	NOEKEON_encrypt(b, (uint32_t*)context, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_32(out + 4 * i, o[i]);
+	}
+}
+
+static void noekeonDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t b[4] = { LOAD_32(block), LOAD_32(block + 4), LOAD_32(block + 8), LOAD_32(block + 12) };
+	uint32_t o[4];
+	int i;
+
+	NOEKEON_decrypt(b, (uint32_t*)context, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_32(out + 4 * i, o[i]);
+	}
+}
+
+// PRESENT
+
+static void presentInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint16_t k[8];
+	int i;
+
+	for (i = 0; i < keyLen / 16; i++)
+	{
+		k[i] = LOAD_16(key + 2 * i);
+	}
+	PRESENT_init((PresentContext*)context, k, keyLen);
+}
+
+static void presentInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	PresentContext* c[INIT_MANY_GROUP];
+	uint16_t k[INIT_MANY_GROUP * 8];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (PresentContext*)contexts[i];
+	}
+	for (i = 0; i < count * keyLen / 16; i++)
+	{
+		k[i] = LOAD_16(keys + 2 * i);
+	}
+	PRESENT_init_many(c, k, keyLen, count);
+}
+
+static void presentEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t b[4] = { LOAD_16(block), LOAD_16(block + 2), LOAD_16(block + 4), LOAD_16(block + 6) };
+	uint16_t o[4];
+	int i;
+
+	PRESENT_encrypt((PresentContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_16(out + 2 * i, o[i]);
+	}
+}
+
+static void presentDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint16_t b[4] = { LOAD_16(block), LOAD_16(block + 2), LOAD_16(block + 4), LOAD_16(block + 6) };
+	uint16_t o[4];
+	int i;
+
+	PRESENT_decrypt((PresentContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_16(out + 2 * i, o[i]);
+	}
+}
+
+// SEED
+
+static void seedInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	// SEED_init rotates the key words in place, so they must be a copy
+	uint32_t k[4] = { LOAD_32(key), LOAD_32(key + 4), LOAD_32(key + 8), LOAD_32(key + 12) };
+
+	SEED_init((SeedContext*)context, k);
+}
+
+static void seedInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	SeedContext* c[INIT_MANY_GROUP];
+	uint32_t k[INIT_MANY_GROUP * 4];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (SeedContext*)contexts[i];
+	}
+	for (i = 0; i < count * 4; i++)
+	{
+		k[i] = LOAD_32(keys + 4 * i);
+	}
+	SEED_init_many(c, k, count);
+}
+
+static void seedEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t b[4] = { LOAD_32(block), LOAD_32(block + 4), LOAD_32(block + 8), LOAD_32(block + 12) };
+	uint32_t o[4];
+	int i;
+
+	SEED_encrypt((SeedContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_32(out + 4 * i, o[i]);
+	}
+}
+
+static void seedDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint32_t b[4] = { LOAD_32(block), LOAD_32(block + 4), LOAD_32(block + 8), LOAD_32(block + 12) };
+	uint32_t o[4];
+	int i;
+
+	SEED_decrypt((SeedContext*)context, b, o);
+	for (i = 0; i < 4; i++)
+	{
+		STORE_32(out + 4 * i, o[i]);
+	}
+}
+
+// SIMON
+
+static void simonInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t k[4];
+	int i;
+
+	for (i = 0; i < keyLen / 64; i++)
+	{
+		k[i] = LOAD_64(key + 8 * i);
+	}
+	SIMON_init((SimonContext*)context, k, keyLen);
+}
+
+static void simonInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	SimonContext* c[INIT_MANY_GROUP];
+	uint64_t k[INIT_MANY_GROUP * 4];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (SimonContext*)contexts[i];
+	}
+	for (i = 0; i < count * keyLen / 64; i++)
+	{
+		k[i] = LOAD_64(keys + 8 * i);
+	}
+	SIMON_init_many(c, k, keyLen, count);
+}
+
+static void simonEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t b[2] = { LOAD_64(block), LOAD_64(block + 8) };
+	uint64_t o[2];
+
+	SIMON_encrypt((SimonContext*)context, b, o);
+	STORE_64(out, o[0]);
+	STORE_64(out + 8, o[1]);
+}
+
+static void simonDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t b[2] = { LOAD_64(block), LOAD_64(block + 8) };
+	uint64_t o[2];
+
+	SIMON_decrypt((SimonContext*)context, b, o);
+	STORE_64(out, o[0]);
+	STORE_64(out + 8, o[1]);
+}
+
+// SPECK
+
+static void speckInit(void* context, const uint8_t* key, uint16_t keyLen)
+{
+	uint64_t k[4];
+	int i;
+
+	for (i = 0; i < keyLen / 64; i++)
+	{
+		k[i] = LOAD_64(key + 8 * i);
+	}
+	SPECK_init((SpeckContext*)context, k, keyLen);
+}
+
+static void speckInitMany(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	SpeckContext* c[INIT_MANY_GROUP];
+	uint64_t k[INIT_MANY_GROUP * 4];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		c[i] = (SpeckContext*)contexts[i];
+	}
+	for (i = 0; i < count * keyLen / 64; i++)
+	{
+		k[i] = LOAD_64(keys + 8 * i);
+	}
+	SPECK_init_many(c, k, keyLen, count);
+}
+
+static void speckEncrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t b[2] = { LOAD_64(block), LOAD_64(block + 8) };
+	uint64_t o[2];
+
+	SPECK_encrypt((SpeckContext*)context, b, o);
+	STORE_64(out, o[0]);
+	STORE_64(out + 8, o[1]);
+}
+
+static void speckDecrypt(void* context, const uint8_t* block, uint8_t* out)
+{
+	uint64_t b[2] = { LOAD_64(block), LOAD_64(block + 8) };
+	uint64_t o[2];
+
+	SPECK_decrypt((SpeckContext*)context, b, o);
+	STORE_64(out, o[0]);
+	STORE_64(out + 8, o[1]);
+}
+
+/*
+	With vectors every lane takes the next block and the key words of the
+	key it falls under, so short runs of blocksPerKey still fill the lanes.
+	The blocks left for a less than half full vector go key by key.
+*/
+static void speckEncryptKeyed(const uint8_t* keys, uint16_t keyLen, const uint8_t* in, uint8_t* out, size_t count, size_t blocksPerKey)
+{
+	size_t keySize = keyLen / 8;
+	size_t nrBlocks = count * blocksPerKey;
+	size_t block = 0;
+	SpeckContext context;
+	uint64_t k[4];
+	uint64_t b[2];
+	uint64_t o[2];
+	size_t run;
+	size_t i;
+	int j;
+#if defined(SIMD_AVAILABLE) && SIMD_LANES_64 >= 4
+	SimdU64 lanes[4];
+	SimdU64 x[2];
+	size_t n;
+	size_t l;
+
+	for (; nrBlocks - block >= SIMD_LANES_64 / 2; block += n, in += n * 16, out += n * 16)
+	{
+		n = nrBlocks - block < SIMD_LANES_64 ? nrBlocks - block : SIMD_LANES_64;
+		for (j = 0; j < keyLen / 64; j++)
+		{
+			for (l = 0; l < SIMD_LANES_64; l++)
+			{
+				lanes[j][l] = l < n ? LOAD_64(keys + (block + l) / blocksPerKey * keySize + 8 * j) : 0;
+			}
+		}
+		SIMD_load_be64(x, 2, in, n);
+		SPECK_encrypt_keyed_lanes(lanes, keyLen, &x[0], &x[1]);
+		SIMD_store_be64(x, 2, out, n);
+	}
+#endif
+
+	// the rest key by key: merged with the rounds for a single block, a schedule on the stack for more
+	for (; block < nrBlocks; block += run)
+	{
+		run = (block / blocksPerKey + 1) * blocksPerKey - block;
+		run = run < nrBlocks - block ? run : nrBlocks - block;
+		for (j = 0; j < keyLen / 64; j++)
+		{
+			k[j] = LOAD_64(keys + block / blocksPerKey * keySize + 8 * j);
+		}
+		if (run > 1)
+		{
+			SPECK_init(&context, k, keyLen);
+		}
+
+		for (i = 0; i < run; i++, in += 16, out += 16)
+		{
+			b[0] = LOAD_64(in);
+			b[1] = LOAD_64(in + 8);
+			if (run > 1)
+			{
+				SPECK_encrypt(&context, b, o);
+			}
+			else
+			{
+				SPECK_encrypt_keyed(k, keyLen, b, o);
+			}
+			STORE_64(out, o[0]);
+			STORE_64(out + 8, o[1]);
+		}
+	}
+}
+
+// width-generic batch kernels
+
+#ifdef SIMD_AVAILABLE
+/*
+	A kernel over the *_lanes function of a cipher: blocks are transposed
+	into one vector of blocks at a time, the last chunk is partial (its
+	zero lanes are encrypted too and dropped).
+*/
+#define LANES_KERNEL(name, Type, lanes, nrWords, blockSize, load, store, call) \
+	static void name(void* context, const uint8_t* in, uint8_t* out, size_t nrBlocks) \
+	{ \
+		Type x[nrWords]; \
+		size_t count; \
+		while (nrBlocks > 0) \
+		{ \
+			count = nrBlocks < (lanes) ? nrBlocks : (lanes); \
+			load(x, nrWords, in, count); \
+			call; \
+			store(x, nrWords, out, count); \
+			in += count * (blockSize); \
+			out += count * (blockSize); \
+			nrBlocks -= count; \
+		} \
+	}
+
+/*
+	Each cipher registers its kernel only from the width where it beats
+	the scalar code: 2 lanes of 64 bits do not pay for the transposes of
+	SIMON/SPECK, and the branch-free IDEA multiplication needs 8 lanes to
+	beat mul().
+*/
+LANES_KERNEL(hightEncryptLanes, SimdU8, SIMD_LANES_8, 8, 8, SIMD_load_8, SIMD_store_8, HIGHT_encrypt_lanes((HightContext*)context, x))
+LANES_KERNEL(hightDecryptLanes, SimdU8, SIMD_LANES_8, 8, 8, SIMD_load_8, SIMD_store_8, HIGHT_decrypt_lanes((HightContext*)context, x))
+LANES_KERNEL(noekeonEncryptLanes, SimdU32, SIMD_LANES_32, 4, 16, SIMD_load_be32, SIMD_store_be32, NOEKEON_encrypt_lanes((uint32_t*)context, x))
+LANES_KERNEL(noekeonDecryptLanes, SimdU32, SIMD_LANES_32, 4, 16, SIMD_load_be32, SIMD_store_be32, NOEKEON_decrypt_lanes((uint32_t*)context, x))
+
+static const CipherKernel hightKernels[] = { { "vector", SIMD_LANES_8, hightEncryptLanes, hightDecryptLanes } };
+static const CipherKernel noekeonKernels[] = { { "vector", SIMD_LANES_32, noekeonEncryptLanes, noekeonDecryptLanes } };
+
+#define KERNELS(table) sizeof(table) / sizeof(table[0]), table
+#define HIGHT_KERNELS KERNELS(hightKernels)
+#define NOEKEON_KERNELS KERNELS(noekeonKernels)
+
+#if SIMD_LANES_32 >= 8
+LANES_KERNEL(ideaEncryptLanes, SimdU32, SIMD_LANES_32, 4, 8, SIMD_load_be16, SIMD_store_be16, IDEA_encrypt_lanes((IdeaContext*)context, x))
+LANES_KERNEL(ideaDecryptLanes, SimdU32, SIMD_LANES_32, 4, 8, SIMD_load_be16, SIMD_store_be16, IDEA_decrypt_lanes((IdeaContext*)context, x))
+
+static const CipherKernel ideaKernels[] = { { "vector", SIMD_LANES_32, ideaEncryptLanes, ideaDecryptLanes } };
+
+#define IDEA_KERNELS KERNELS(ideaKernels)
+#endif
+
+#if SIMD_LANES_64 >= 4
+LANES_KERNEL(simonEncryptLanes, SimdU64, SIMD_LANES_64, 2, 16, SIMD_load_be64, SIMD_store_be64, SIMON_encrypt_lanes((SimonContext*)context, &x[0], &x[1]))
+LANES_KERNEL(simonDecryptLanes, SimdU64, SIMD_LANES_64, 2, 16, SIMD_load_be64, SIMD_store_be64, SIMON_decrypt_lanes((SimonContext*)context, &x[0], &x[1]))
+LANES_KERNEL(speckEncryptLanes, SimdU64, SIMD_LANES_64, 2, 16, SIMD_load_be64, SIMD_store_be64, SPECK_encrypt_lanes((SpeckContext*)context, &x[0], &x[1]))
+LANES_KERNEL(speckDecryptLanes, SimdU64, SIMD_LANES_64, 2, 16, SIMD_load_be64, SIMD_store_be64, SPECK_decrypt_lanes((SpeckContext*)context, &x[0], &x[1]))
+
+static const CipherKernel simonKernels[] = { { "vector", SIMD_LANES_64, simonEncryptLanes, simonDecryptLanes } };
+static const CipherKernel speckKernels[] = { { "vector", SIMD_LANES_64, speckEncryptLanes, speckDecryptLanes } };
+
+#define SIMON_KERNELS KERNELS(simonKernels)
+#define SPECK_KERNELS KERNELS(speckKernels)
+#endif
+#endif
+
+#ifndef HIGHT_KERNELS
+#define HIGHT_KERNELS 0, NULL
+#define NOEKEON_KERNELS 0, NULL
+#endif
+#ifndef IDEA_KERNELS
+#define IDEA_KERNELS 0, NULL
+#endif
+#ifndef SIMON_KERNELS
+#define SIMON_KERNELS 0, NULL
+#define SPECK_KERNELS 0, NULL
+#endif
+
+static const CipherDescriptor descriptors[CIPHER_COUNT] =
+{
+	{ CIPHER_ARIA, "ARIA", 16, 3, { 128, 192, 256 }, ariaInit, ariaInitEncrypt, ariaEncrypt, ariaDecrypt, ARIA_lookup_table, 0, NULL, ariaInitMany, ariaEncryptKeyed },
+	{ CIPHER_CAMELLIA, "CAMELLIA", 16, 3, { 128, 192, 256 }, camelliaInit, camelliaInit, camelliaEncrypt, camelliaDecrypt, CAMELLIA_lookup_table, 0, NULL, camelliaInitMany, camelliaEncryptKeyed },
+	{ CIPHER_GOST, "GOST", 8, 1, { 256 }, gostInit, gostInit, gostEncrypt, gostDecrypt, GOST_lookup_table, 0, NULL, NULL, NULL },
+	{ CIPHER_HIGHT, "HIGHT", 8, 1, { 128 }, hightInit, hightInit, hightEncrypt, hightDecrypt, NULL, HIGHT_KERNELS, hightInitMany, NULL },
+	{ CIPHER_IDEA, "IDEA", 8, 1, { 128 }, ideaInit, ideaInitEncrypt, ideaEncrypt, ideaDecrypt, NULL, IDEA_KERNELS, ideaInitMany, NULL },
+	{ CIPHER_NOEKEON, "NOEKEON", 16, 1, { 128 }, noekeonInit, noekeonInit, noekeonEncrypt, noekeonDecrypt, NULL, NOEKEON_KERNELS, NULL, NULL },
+	{ CIPHER_PRESENT, "PRESENT", 8, 2, { 80, 128 }, presentInit, presentInit, presentEncrypt, presentDecrypt, PRESENT_lookup_table, 0, NULL, presentInitMany, NULL },
+	{ CIPHER_SEED, "SEED", 16, 1, { 128 }, seedInit, seedInit, seedEncrypt, seedDecrypt, SEED_lookup_table, 0, NULL, seedInitMany, NULL },
+	{ CIPHER_SIMON, "SIMON", 16, 3, { 128, 192, 256 }, simonInit, simonInit, simonEncrypt, simonDecrypt, NULL, SIMON_KERNELS, simonInitMany, NULL },
+	{ CIPHER_SPECK, "SPECK", 16, 3, { 128, 192, 256 }, speckInit, speckInit, speckEncrypt, speckDecrypt, NULL, SPECK_KERNELS, speckInitMany, speckEncryptKeyed }
+};
+
+const CipherDescriptor* CIPHER_get(CipherId id)
+{
+	if ((unsigned)id >= CIPHER_COUNT)
+	{
+		return NULL;
+	}
+
+	return &descriptors[id];
+}
+
+const CipherDescriptor* CIPHER_find(const char* name)
+{
+	int i;
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		if (strcmp(descriptors[i].name, name) == 0)
+		{
+			return &descriptors[i];
+		}
+	}
+
+	return NULL;
+}
+
+int CIPHER_supports_key_length(const CipherDescriptor* cipher, uint16_t keyLen)
+{
+	int i;
+
+	for (i = 0; i < cipher->nrKeyLengths; i++)
+	{
+		if (cipher->keyLengths[i] == keyLen)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+size_t CIPHER_lookup_table(const CipherDescriptor* cipher, int index, const void** address)
+{
+	if (cipher->lookupTable == NULL)
+	{
+		return 0;
+	}
+
+	return cipher->lookupTable(index, address);
+}
+
+int CIPHER_kernel_count(const CipherDescriptor* cipher)
+{
+	return 1 + cipher->nrKernels;
+}
+
+const char* CIPHER_kernel_name(const CipherDescriptor* cipher, int kernel)
+{
+	if (kernel == 0)
+	{
+		return "reference";
+	}
+
+	return kernel > 0 && kernel <= cipher->nrKernels ? cipher->kernels[kernel - 1].name : NULL;
+}
+
+uint16_t CIPHER_kernel_lanes(const CipherDescriptor* cipher, int kernel)
+{
+	return kernel > 0 && kernel <= cipher->nrKernels ? cipher->kernels[kernel - 1].lanes : 1;
+}
+
+CipherStatus CIPHER_set_kernel(CipherContext* context, int kernel)
+{
+	if (kernel < 0 || kernel > context->cipher->nrKernels)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	context->kernel = (uint8_t)kernel;
+
+	return CIPHER_OK;
+}
+
+CipherStatus CIPHER_init(CipherContext* context, CipherId id, const uint8_t* key, uint16_t keyLen)
+{
+	const CipherDescriptor* cipher = CIPHER_get(id);
+
+	if (cipher == NULL)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	if (!CIPHER_supports_key_length(cipher, keyLen))
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+
+#ifndef CIPHER_NO_SELFTEST
+	// known answers checked on the first use of the cipher only
+	if (SELFTEST_cipher(id) != CIPHER_OK)
+	{
+		return CIPHER_ERROR_SELFTEST;
+	}
+#endif
+
+	context->cipher = cipher;
+	context->keyLen = keyLen;
+	context->kernel = cipher->nrKernels;
+	PROBE_KEY_SETUP_ENTRY(id, keyLen, 0);
+	cipher->init(&context->u, key, keyLen);
+	PROBE_KEY_SETUP_EXIT(id, keyLen, 0);
+	STATS_KEY_SETUP(id);
+
+	return CIPHER_OK;
+}
+
+CipherStatus CIPHER_init_encrypt(CipherContext* context, CipherId id, const uint8_t* key, uint16_t keyLen)
+{
+	const CipherDescriptor* cipher = CIPHER_get(id);
+
+	if (cipher == NULL)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	if (!CIPHER_supports_key_length(cipher, keyLen))
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+
+#ifndef CIPHER_NO_SELFTEST
+	// known answers checked on the first use of the cipher only
+	if (SELFTEST_cipher(id) != CIPHER_OK)
+	{
+		return CIPHER_ERROR_SELFTEST;
+	}
+#endif
+
+	context->cipher = cipher;
+	context->keyLen = keyLen;
+	context->kernel = cipher->nrKernels;
+	PROBE_KEY_SETUP_ENTRY(id, keyLen, 1);
+	cipher->initEncrypt(&context->u, key, keyLen);
+	PROBE_KEY_SETUP_EXIT(id, keyLen, 1);
+	STATS_KEY_SETUP(id);
+
+	return CIPHER_OK;
+}
+
+/*
+	count key schedules into contexts[0 .. count - 1], from count keys of
+	keyLen / 8 bytes one after the other. The contexts are the same as
+	after count CIPHER_init calls, the ciphers with an initMany function
+	batch or interleave the schedules of the keys.
+*/
+CipherStatus CIPHER_init_many(CipherContext* contexts, CipherId id, const uint8_t* keys, uint16_t keyLen, size_t count)
+{
+	const CipherDescriptor* cipher = CIPHER_get(id);
+	void* group[INIT_MANY_GROUP];
+	size_t keySize = keyLen / 8;
+	size_t n;
+	size_t i;
+
+	if (cipher == NULL)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	if (!CIPHER_supports_key_length(cipher, keyLen))
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+
+#ifndef CIPHER_NO_SELFTEST
+	// known answers checked on the first use of the cipher only
+	if (SELFTEST_cipher(id) != CIPHER_OK)
+	{
+		return CIPHER_ERROR_SELFTEST;
+	}
+#endif
+
+	for (; count > 0; count -= n, contexts += n, keys += n * keySize)
+	{
+		n = count < INIT_MANY_GROUP ? count : INIT_MANY_GROUP;
+
+		PROBE_KEY_SETUP_ENTRY(id, keyLen, 0);
+		for (i = 0; i < n; i++)
+		{
+			contexts[i].cipher = cipher;
+			contexts[i].keyLen = keyLen;
+			contexts[i].kernel = cipher->nrKernels;
+			group[i] = &contexts[i].u;
+		}
+
+		if (cipher->initMany != NULL)
+		{
+			cipher->initMany(group, keys, keyLen, n);
+		}
+		else
+		{
+			for (i = 0; i < n; i++)
+			{
+				cipher->init(group[i], keys + i * keySize, keyLen);
+			}
+		}
+		PROBE_KEY_SETUP_EXIT(id, keyLen, 0);
+
+		for (i = 0; i < n; i++)
+		{
+			STATS_KEY_SETUP(id);
+		}
+	}
+
+	return CIPHER_OK;
+}
+
+void CIPHER_encrypt(CipherContext* context, const uint8_t* block, uint8_t* out)
+{
+	context->cipher->encrypt(&context->u, block, out);
+	STATS_BLOCKS(context->cipher->id, 0, 1, context->cipher->blockSize);
+}
+
+void CIPHER_decrypt(CipherContext* context, const uint8_t* block, uint8_t* out)
+{
+	context->cipher->decrypt(&context->u, block, out);
+	STATS_BLOCKS(context->cipher->id, 0, 1, context->cipher->blockSize);
+}
+
+void CIPHER_encrypt_blocks(CipherContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks)
+{
+	size_t blockSize = context->cipher->blockSize;
+	size_t i;
+
+	PROBE_BATCH_ENTRY(context->cipher->id, context->kernel, nrBlocks, nrBlocks * blockSize, 0);
+	if (context->kernel != 0)
+	{
+		context->cipher->kernels[context->kernel - 1].encryptBlocks(&context->u, in, out, nrBlocks);
+	}
+	else
+	{
+		for (i = 0; i < nrBlocks; i++)
+		{
+			context->cipher->encrypt(&context->u, in + i * blockSize, out + i * blockSize);
+		}
+	}
+	PROBE_BATCH_EXIT(context->cipher->id, context->kernel, nrBlocks, nrBlocks * blockSize, 0);
+	STATS_BLOCKS(context->cipher->id, context->kernel, nrBlocks, nrBlocks * blockSize);
+}
+
+void CIPHER_decrypt_blocks(CipherContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks)
+{
+	size_t blockSize = context->cipher->blockSize;
+	size_t i;
+
+	PROBE_BATCH_ENTRY(context->cipher->id, context->kernel, nrBlocks, nrBlocks * blockSize, 1);
+	if (context->kernel != 0)
+	{
+		context->cipher->kernels[context->kernel - 1].decryptBlocks(&context->u, in, out, nrBlocks);
+	}
+	else
+	{
+		for (i = 0; i < nrBlocks; i++)
+		{
+			context->cipher->decrypt(&context->u, in + i * blockSize, out + i * blockSize);
+		}
+	}
+	PROBE_BATCH_EXIT(context->cipher->id, context->kernel, nrBlocks, nrBlocks * blockSize, 1);
+	STATS_BLOCKS(context->cipher->id, context->kernel, nrBlocks, nrBlocks * blockSize);
+}
+
+CipherStatus CIPHER_encrypt_keyed(CipherId id, const uint8_t* keys, uint16_t keyLen, const uint8_t* in, uint8_t* out, size_t count, size_t blocksPerKey)
+{
+	const CipherDescriptor* cipher = CIPHER_get(id);
+	CipherContext contexts[KEYED_GROUP];
+	size_t keySize = keyLen / 8;
+	CipherStatus status;
+	size_t blockSize;
+	size_t n;
+	size_t i;
+	size_t j;
+
+	if (cipher == NULL)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	if (!CIPHER_supports_key_length(cipher, keyLen))
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+
+	if (cipher->encryptKeyed == NULL)
+	{
+		// CIPHER_init_many runs the self-test and counts the key setups
+		blockSize = cipher->blockSize;
+		for (; count > 0; count -= n, keys += n * keySize)
+		{
+			n = count < KEYED_GROUP ? count : KEYED_GROUP;
+			status = CIPHER_init_many(contexts, id, keys, keyLen, n);
+			if (status != CIPHER_OK)
+			{
+				CIPHER_wipe(contexts, sizeof(contexts));
+				return status;
+			}
+			for (i = 0; i < n; i++, in += blocksPerKey * blockSize, out += blocksPerKey * blockSize)
+			{
+				// fewer blocks than lanes do not pay for the transposes of a batch kernel
+				if (blocksPerKey < CIPHER_kernel_lanes(cipher, contexts[i].kernel))
+				{
+					for (j = 0; j < blocksPerKey; j++)
+					{
+						CIPHER_encrypt(&contexts[i], in + j * blockSize, out + j * blockSize);
+					}
+				}
+				else
+				{
+					CIPHER_encrypt_blocks(&contexts[i], in, out, blocksPerKey);
+				}
+			}
+		}
+
+		// the round keys of the last group
+		CIPHER_wipe(contexts, sizeof(contexts));
+		return CIPHER_OK;
+	}
+
+#ifndef CIPHER_NO_SELFTEST
+	// known answers checked on the first use of the cipher only
+	if (SELFTEST_cipher(id) != CIPHER_OK)
+	{
+		return CIPHER_ERROR_SELFTEST;
+	}
+#endif
+
+	PROBE_BATCH_ENTRY(id, 0, count * blocksPerKey, count * blocksPerKey * cipher->blockSize, 0);
+	cipher->encryptKeyed(keys, keyLen, in, out, count, blocksPerKey);
+	PROBE_BATCH_EXIT(id, 0, count * blocksPerKey, count * blocksPerKey * cipher->blockSize, 0);
+	for (i = 0; i < count; i++)
+	{
+		STATS_KEY_SETUP(id);
+	}
+	STATS_BLOCKS(id, 0, count * blocksPerKey, count * blocksPerKey * cipher->blockSize);
+
+	return CIPHER_OK;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+/* CIPHER.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../ARIA/ARIA.h"
+#include "../CAMELLIA/CAMELLIA.h"
+#include "../GOST/GOST.h"
+#include "../HIGHT/HIGHT.h"
+#include "../IDEA/IDEA.h"
+#include "../NOEKEON/NOEKEON.h"
+#include "../PRESENT/PRESENT.h"
+#include "../SEED/SEED.h"
+#include "../SIMON/SIMON.h"
+#include "../SPECK/SPECK.h"
+
+#define CIPHER_MAX_BLOCK_SIZE 16
+#define CIPHER_MAX_KEY_SIZE 32
+// kernel 0 is the reference one, calling encrypt/decrypt block by block
+#define CIPHER_MAX_KERNELS 4
+
+typedef enum
+{
+	CIPHER_ARIA = 0,
+	CIPHER_CAMELLIA,
+	CIPHER_GOST,
+	CIPHER_HIGHT,
+	CIPHER_IDEA,
+	CIPHER_NOEKEON,
+	CIPHER_PRESENT,
+	CIPHER_SEED,
+	CIPHER_SIMON,
+	CIPHER_SPECK,
+	CIPHER_COUNT
+} CipherId;
+
+typedef enum
+{
+	CIPHER_OK = 0,
+	CIPHER_ERROR_ID = -1,
+	CIPHER_ERROR_KEY_LENGTH = -2,
+	CIPHER_ERROR_LENGTH = -3,
+	CIPHER_ERROR_TAG = -4,
+	// the known answer tests of the cipher failed, see SELFTEST
+	CIPHER_ERROR_SELFTEST = -5,
+	// the entropy source of a random bit generator failed, see DRBG
+	CIPHER_ERROR_ENTROPY = -6,
+	// a context could not be allocated, see KEYHANDLE
+	CIPHER_ERROR_MEMORY = -7
+} CipherStatus;
+
+// zeroes length bytes of key material, with stores the compiler cannot drop
+// (inline, the ciphers wipe their own key schedules without linking CIPHER.c)
+static inline void CIPHER_wipe(void* data, size_t length)
+{
+	volatile uint8_t* p = data;
+
+	while (length-- > 0)
+	{
+		*p++ = 0;
+	}
+}
+
+/*
+	Batch implementation of a cipher. Every kernel must produce exactly
+	the output of the reference single block functions, for any number
+	of blocks, including counts that are not a multiple of lanes.
+*/
+typedef struct
+{
+	const char* name;
+	// blocks processed together
+	uint16_t lanes;
+	void (*encryptBlocks)(void* context, const uint8_t* in, uint8_t* out, size_t nrBlocks);
+	void (*decryptBlocks)(void* context, const uint8_t* in, uint8_t* out, size_t nrBlocks);
+} CipherKernel;
+
+/*
+	Byte oriented front-end over the word oriented block ciphers.
+
+	Keys and blocks are byte strings. They are loaded into the word arrays
+	of each cipher big-endian, in array order (so the test vectors of the
+	*_main functions read the same as hex strings), except for GOST which
+	follows RFC 5830 and loads its words little-endian.
+*/
+typedef struct
+{
+	CipherId id;
+	const char* name;
+	uint8_t blockSize; // in bytes
+	uint8_t nrKeyLengths;
+	uint16_t keyLengths[3]; // in bits
+	// full key schedule, usable for encryption and decryption
+	void (*init)(void* context, const uint8_t* key, uint16_t keyLen);
+	// encryption-only key schedule (same as init for most ciphers)
+	void (*initEncrypt)(void* context, const uint8_t* key, uint16_t keyLen);
+	void (*encrypt)(void* context, const uint8_t* block, uint8_t* out);
+	void (*decrypt)(void* context, const uint8_t* block, uint8_t* out);
+	// lookup tables of the round function, NULL for table-free ciphers
+	size_t (*lookupTable)(int index, const void** address);
+	// kernels besides the reference one, fastest last
+	uint8_t nrKernels;
+	const CipherKernel* kernels;
+	// init of count keys (one after the other) at once, NULL when init is a plain key copy
+	void (*initMany)(void** contexts, const uint8_t* keys, uint16_t keyLen, size_t count);
+	// blocksPerKey blocks under each of count keys, schedule merged with the rounds; NULL: init_many + encrypt
+	void (*encryptKeyed)(const uint8_t* keys, uint16_t keyLen, const uint8_t* in, uint8_t* out, size_t count, size_t blocksPerKey);
+} CipherDescriptor;
+
+typedef struct
+{
+	const CipherDescriptor* cipher;
+	uint16_t keyLen;
+	// used by the *_blocks functions, the fastest one after init
+	uint8_t kernel;
+	union
+	{
+		AriaContext aria;
+		CamelliaContext camellia;
+		uint32_t gost[8];
+		HightContext hight;
+		IdeaContext idea;
+		uint32_t noekeon[4];
+		PresentContext present;
+		SeedContext seed;
+		SimonContext simon;
+		SpeckContext speck;
+	} u;
+} CipherContext;
+
+const CipherDescriptor* CIPHER_get(CipherId id);
+const CipherDescriptor* CIPHER_find(const char* name);
+int CIPHER_supports_key_length(const CipherDescriptor* cipher, uint16_t keyLen);
+size_t CIPHER_lookup_table(const CipherDescriptor* cipher, int index, const void** address);
+
+// number of kernels including the reference one, and their names
+int CIPHER_kernel_count(const CipherDescriptor* cipher);
+const char* CIPHER_kernel_name(const CipherDescriptor* cipher, int kernel);
+uint16_t CIPHER_kernel_lanes(const CipherDescriptor* cipher, int kernel);
+CipherStatus CIPHER_set_kernel(CipherContext* context, int kernel);
+
+CipherStatus CIPHER_init(CipherContext* context, CipherId id, const uint8_t* key, uint16_t keyLen);
+CipherStatus CIPHER_init_encrypt(CipherContext* context, CipherId id, const uint8_t* key, uint16_t keyLen);
+// count contexts from count keys of keyLen / 8 bytes, same as CIPHER_init on each
+CipherStatus CIPHER_init_many(CipherContext* contexts, CipherId id, const uint8_t* keys, uint16_t keyLen, size_t count);
+void CIPHER_encrypt(CipherContext* context, const uint8_t* block, uint8_t* out);
+void CIPHER_decrypt(CipherContext* context, const uint8_t* block, uint8_t* out);
+
+// nrBlocks consecutive blocks, in and out may be the same buffer
+void CIPHER_encrypt_blocks(CipherContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks);
+void CIPHER_decrypt_blocks(CipherContext* context, const uint8_t* in, uint8_t* out, size_t nrBlocks);
+
+/*
+	Key-agile encryption, for constructions that rekey on every block:
+	blocks i * blocksPerKey .. (i + 1) * blocksPerKey - 1 of in are encrypted
+	under key i of keys (count keys of keyLen / 8 bytes), without contexts.
+*/
+CipherStatus CIPHER_encrypt_keyed(CipherId id, const uint8_t* keys, uint16_t keyLen, const uint8_t* in, uint8_t* out, size_t count, size_t blocksPerKey);
\ No newline at end of file
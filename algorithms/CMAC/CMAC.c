@@ -0,0 +1,93 @@
+/* CMAC.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * CMAC message authentication code over the generic CIPHER front-end.
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-38b.pdf
+ *
+ */
+
+#include <string.h>
+
+#include "CMAC.h"
+
+// subkey doubling in GF(2^b), with R64 = 0x1b and R128 = 0x87
+static void doubleBlock(const uint8_t* in, uint8_t* out, size_t blockSize)
+{
+	uint8_t msb = in[0] >> 7;
+	size_t i;
+
+	for (i = 0; i + 1 < blockSize; i++)
+	{
+		out[i] = (uint8_t)(in[i] << 1 | in[i + 1] >> 7);
+	}
+	out[blockSize - 1] = (uint8_t)(in[blockSize - 1] << 1) ^ (uint8_t)(-msb & (blockSize == 16 ? 0x87 : 0x1b));
+}
+
+CipherStatus CMAC_init(CmacContext* context, CipherContext* cipher)
+{
+	uint8_t L[CIPHER_MAX_BLOCK_SIZE] = { 0 };
+	size_t blockSize = cipher->cipher->blockSize;
+
+	if (blockSize != 8 && blockSize != 16)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	context->cipher = cipher;
+	CIPHER_encrypt(cipher, L, L);
+	doubleBlock(L, context->K1, blockSize);
+	doubleBlock(context->K1, context->K2, blockSize);
+
+	return CIPHER_OK;
+}
+
+void CMAC_last_block(const CmacContext* context, const uint8_t* last, size_t length, uint8_t* block)
+{
+	size_t blockSize = context->cipher->cipher->blockSize;
+	const uint8_t* mask = length == blockSize ? context->K1 : context->K2;
+	size_t i;
+
+	memset(block, 0, blockSize);
+	memcpy(block, last, length);
+	if (length < blockSize)
+	{
+		block[length] = 0x80;
+	}
+
+	for (i = 0; i < blockSize; i++)
+	{
+		block[i] ^= mask[i];
+	}
+}
+
+void CMAC_compute(const CmacContext* context, const uint8_t* message, size_t length, uint8_t* mac)
+{
+	size_t blockSize = context->cipher->cipher->blockSize;
+	uint8_t block[CIPHER_MAX_BLOCK_SIZE];
+	size_t i;
+
+	memset(mac, 0, blockSize);
+
+	// every block but the last one, which may be full
+	while (length > blockSize)
+	{
+		for (i = 0; i < blockSize; i++)
+		{
+			mac[i] ^= message[i];
+		}
+		CIPHER_encrypt(context->cipher, mac, mac);
+		message += blockSize;
+		length -= blockSize;
+	}
+
+	CMAC_last_block(context, message, length, block);
+	for (i = 0; i < blockSize; i++)
+	{
+		mac[i] ^= block[i];
+	}
+	CIPHER_encrypt(context->cipher, mac, mac);
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+/* CMAC.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+typedef struct
+{
+	// 64 or 128 bits block cipher, only its encryption direction is used
+	CipherContext* cipher;
+	uint8_t K1[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t K2[CIPHER_MAX_BLOCK_SIZE];
+} CmacContext;
+
+CipherStatus CMAC_init(CmacContext* context, CipherContext* cipher);
+
+// full block MAC of the message, truncate it as needed
+void CMAC_compute(const CmacContext* context, const uint8_t* message, size_t length, uint8_t* mac);
+
+/*
+	Final block of a message from its last length bytes (1 to block size,
+	0 for the empty message): padded when partial and masked with K1 or K2.
+	For callers that run the CBC chain themselves, as KDF does for many
+	messages at once.
+*/
+void CMAC_last_block(const CmacContext* context, const uint8_t* last, size_t length, uint8_t* block);
\ No newline at end of file
@@ -0,0 +1,484 @@
+/* COLUMN.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Encryption of whole columns of values (fixed width, or Arrow-like
+ * offsets + values) for columnar stores. Instead of one CTR call per
+ * value, the counter blocks of many consecutive values are laid out
+ * together and encrypted in one batch call, then the keystream is
+ * scattered to the values through their offsets; short values share
+ * batches and only the last block of each value is partial.
+ *
+ * The deterministic mode is a length-preserving cipher of each value: a
+ * Feistel network over the two halves of the value, whose round functions
+ * are the CTR keystream from a CMAC of the other half, prefixed by the
+ * nonce, the round and the length of the value. Every ciphertext byte
+ * depends on every plaintext byte, so only whole equal values show. The
+ * values of a group run in lockstep, so the steps of their CMAC chains and
+ * their keystreams are large batch calls, as in the randomized mode.
+ *
+ */
+
+#include <string.h>
+
+#include "COLUMN.h"
+#include "../CMAC/CMAC.h"
+#include "../PROBES/PROBES.h"
+#include "../STATS/STATS.h"
+
+// number of keystream blocks generated per batch call
+#define COLUMN_BATCH 256
+// Feistel rounds of the deterministic mode, more when the halves are under COLUMN_WIDE_HALF bytes
+#define COLUMN_WIDE_HALF 8
+#define COLUMN_WIDE_ROUNDS 4
+#define COLUMN_SHORT_ROUNDS 10
+// values of the deterministic mode advanced together
+#define COLUMN_GROUP 128
+
+typedef struct
+{
+	// NULL for values of width bytes
+	const uint32_t* offsets;
+	size_t width;
+	size_t count;
+} Layout;
+
+static size_t valueStart(const Layout* layout, size_t i)
+{
+	return layout->offsets != NULL ? layout->offsets[i] : i * layout->width;
+}
+
+static size_t valueLength(const Layout* layout, size_t i)
+{
+	return layout->offsets != NULL ? layout->offsets[i + 1] - layout->offsets[i] : layout->width;
+}
+
+// adds value to the big-endian integer block[0 .. end - 1]
+static void add(uint8_t* block, size_t end, uint64_t value)
+{
+	unsigned int sum;
+	size_t i;
+
+	for (i = end; i > 0 && value != 0; i--)
+	{
+		sum = block[i - 1] + (unsigned int)(value & 0xff);
+		block[i - 1] = (uint8_t)sum;
+		value = (value >> 8) + (sum >> 8);
+	}
+}
+
+// nonce + (row << 32) + j
+static void makeCounter(uint8_t* block, const uint8_t* nonce, size_t blockSize, uint64_t row, uint32_t j)
+{
+	memcpy(block, nonce, blockSize);
+	add(block, blockSize, j);
+	add(block, blockSize - 4, row);
+}
+
+static void cryptRandomized(CipherContext* context, const uint8_t* nonce, uint64_t firstRow,
+							const Layout* layout, const uint8_t* in, uint8_t* out)
+{
+	size_t blockSize = context->cipher->blockSize;
+	uint8_t keystream[COLUMN_BATCH * CIPHER_MAX_BLOCK_SIZE];
+	// bytes of the values each keystream block applies to
+	size_t targets[COLUMN_BATCH];
+	size_t sizes[COLUMN_BATCH];
+	size_t row = 0;
+	size_t position = 0;
+	size_t nrBlocks;
+	size_t length;
+	size_t b;
+	size_t i;
+
+	while (row < layout->count)
+	{
+		// counter blocks of the next values, from byte position of row
+		nrBlocks = 0;
+		while (nrBlocks < COLUMN_BATCH && row < layout->count)
+		{
+			length = valueLength(layout, row);
+			if (position >= length)
+			{
+				row++;
+				position = 0;
+				continue;
+			}
+
+			makeCounter(keystream + nrBlocks * blockSize, nonce, blockSize, firstRow + row, (uint32_t)(position / blockSize));
+			targets[nrBlocks] = valueStart(layout, row) + position;
+			sizes[nrBlocks] = length - position < blockSize ? length - position : blockSize;
+			position += blockSize;
+			nrBlocks++;
+		}
+		if (nrBlocks == 0)
+		{
+			break;
+		}
+		CIPHER_encrypt_blocks(context, keystream, keystream, nrBlocks);
+
+		for (b = 0; b < nrBlocks; b++)
+		{
+			const uint8_t* k = keystream + b * blockSize;
+
+			for (i = 0; i < sizes[b]; i++)
+			{
+				out[targets[b] + i] = in[targets[b] + i] ^ k[i];
+			}
+		}
+	}
+}
+
+// first CMAC block of the round functions of a value: nonce ^ (round << 32 | length)
+static void roundBlock(uint8_t* block, const uint8_t* nonce, size_t blockSize, uint32_t round, size_t length)
+{
+	int i;
+
+	memcpy(block, nonce, blockSize);
+	for (i = 0; i < 4; i++)
+	{
+		block[blockSize - 1 - i] ^= (uint8_t)(length >> (8 * i));
+		block[blockSize - 5 - i] ^= (uint8_t)(round >> (8 * i));
+	}
+}
+
+// halves of a value of the deterministic mode, x and y of a round are halves[round & 1] and halves[~round & 1]
+typedef struct
+{
+	uint8_t* halves[2];
+	size_t lengths[2];
+	// the halves of a single byte value
+	uint8_t nibbles[2];
+	// keeps the low bits of every keystream byte (0x0f for nibbles)
+	uint8_t mask;
+	uint32_t nrRounds;
+	size_t length;
+} Value;
+
+// values advanced together by the deterministic mode, and their batches
+typedef struct
+{
+	Value values[COLUMN_GROUP];
+	// CMAC chain of every value, then the first counter block of its keystream
+	uint8_t macs[COLUMN_GROUP * CIPHER_MAX_BLOCK_SIZE];
+	uint8_t batch[COLUMN_BATCH * CIPHER_MAX_BLOCK_SIZE];
+	size_t owners[COLUMN_BATCH];
+	uint8_t* targets[COLUMN_BATCH];
+	size_t sizes[COLUMN_BATCH];
+} Group;
+
+static void setupValue(Value* value, uint8_t* data, size_t length)
+{
+	value->length = length;
+	value->mask = 0xff;
+
+	if (length == 1)
+	{
+		value->nibbles[0] = data[0] >> 4;
+		value->nibbles[1] = data[0] & 0x0f;
+		value->halves[0] = &value->nibbles[0];
+		value->halves[1] = &value->nibbles[1];
+		value->lengths[0] = 1;
+		value->lengths[1] = 1;
+		value->mask = 0x0f;
+	}
+	else
+	{
+		value->halves[0] = data;
+		value->halves[1] = data + length / 2;
+		value->lengths[0] = length / 2;
+		value->lengths[1] = length - length / 2;
+	}
+
+	// short halves need more rounds, as FF1
+	value->nrRounds = length == 0 ? 0 : value->lengths[0] >= COLUMN_WIDE_HALF ? COLUMN_WIDE_ROUNDS : COLUMN_SHORT_ROUNDS;
+}
+
+// Feistel round of a value at step r of the group, rounds in reverse order to decrypt
+static uint32_t valueRound(const Value* value, uint32_t r, int decrypt)
+{
+	return decrypt ? value->nrRounds - 1 - r : r;
+}
+
+/*
+	T = CMAC(roundBlock || x) of every value still running at step r, the
+	chains advancing together: each step of the chains is one batch call.
+*/
+static void roundMacs(const CmacContext* cmac, const uint8_t* nonce, Group* group, size_t count, uint32_t r, int decrypt)
+{
+	size_t blockSize = cmac->cipher->cipher->blockSize;
+	uint8_t first[CIPHER_MAX_BLOCK_SIZE];
+	size_t maxBlocks = 0;
+	size_t nrBlocks;
+	size_t nrActive;
+	size_t step;
+	size_t tail;
+	size_t a;
+	size_t v;
+	size_t i;
+
+	memset(group->macs, 0, count * blockSize);
+	for (v = 0; v < count; v++)
+	{
+		nrBlocks = 1 + (group->values[v].lengths[valueRound(&group->values[v], r, decrypt) & 1] + blockSize - 1) / blockSize;
+		maxBlocks = r < group->values[v].nrRounds && nrBlocks > maxBlocks ? nrBlocks : maxBlocks;
+	}
+
+	for (step = 0; step < maxBlocks; step++)
+	{
+		nrActive = 0;
+		for (v = 0; v < count; v++)
+		{
+			const Value* value = &group->values[v];
+			uint32_t round = valueRound(value, r, decrypt);
+			const uint8_t* x = value->halves[round & 1];
+			size_t xLength = value->lengths[round & 1];
+			uint8_t* input = group->batch + nrActive * blockSize;
+
+			// the prefix block, then the x blocks, the last one masked
+			nrBlocks = xLength == 0 ? 1 : 1 + (xLength + blockSize - 1) / blockSize;
+			if (r >= value->nrRounds || step >= nrBlocks)
+			{
+				continue;
+			}
+
+			if (step == 0)
+			{
+				roundBlock(first, nonce, blockSize, round, value->length);
+				if (nrBlocks == 1)
+				{
+					CMAC_last_block(cmac, first, blockSize, input);
+				}
+				else
+				{
+					memcpy(input, first, blockSize);
+				}
+			}
+			else if (step + 1 < nrBlocks)
+			{
+				memcpy(input, x + (step - 1) * blockSize, blockSize);
+			}
+			else
+			{
+				tail = xLength - (step - 1) * blockSize;
+				CMAC_last_block(cmac, x + (step - 1) * blockSize, tail, input);
+			}
+
+			for (i = 0; i < blockSize; i++)
+			{
+				input[i] ^= group->macs[v * blockSize + i];
+			}
+			group->owners[nrActive++] = v;
+		}
+
+		CIPHER_encrypt_blocks(cmac->cipher, group->batch, group->batch, nrActive);
+		for (a = 0; a < nrActive; a++)
+		{
+			memcpy(group->macs + group->owners[a] * blockSize, group->batch + a * blockSize, blockSize);
+		}
+	}
+}
+
+// encrypts the nrBlocks counter blocks of the batch and xors them into their targets
+static void applyKeystream(CipherContext* context, Group* group, size_t nrBlocks)
+{
+	size_t blockSize = context->cipher->blockSize;
+	size_t b;
+	size_t i;
+
+	CIPHER_encrypt_blocks(context, group->batch, group->batch, nrBlocks);
+	for (b = 0; b < nrBlocks; b++)
+	{
+		const uint8_t* k = group->batch + b * blockSize;
+		uint8_t mask = group->values[group->owners[b]].mask;
+
+		for (i = 0; i < group->sizes[b]; i++)
+		{
+			group->targets[b][i] ^= k[i] & mask;
+		}
+	}
+}
+
+// y ^= E(T + j) of every value still running at step r, in COLUMN_BATCH blocks calls
+static void roundKeystreams(CipherContext* context, Group* group, size_t count, uint32_t r, int decrypt)
+{
+	size_t blockSize = context->cipher->blockSize;
+	size_t nrBlocks = 0;
+	size_t done;
+	size_t v;
+
+	for (v = 0; v < count; v++)
+	{
+		const Value* value = &group->values[v];
+		uint32_t round = valueRound(value, r, decrypt);
+		uint8_t* y = value->halves[~round & 1];
+		size_t yLength = value->lengths[~round & 1];
+
+		if (r >= value->nrRounds)
+		{
+			continue;
+		}
+
+		for (done = 0; done < yLength; done += blockSize)
+		{
+			if (nrBlocks == COLUMN_BATCH)
+			{
+				applyKeystream(context, group, nrBlocks);
+				nrBlocks = 0;
+			}
+
+			memcpy(group->batch + nrBlocks * blockSize, group->macs + v * blockSize, blockSize);
+			add(group->batch + nrBlocks * blockSize, blockSize, done / blockSize);
+			group->owners[nrBlocks] = v;
+			group->targets[nrBlocks] = y + done;
+			group->sizes[nrBlocks] = yLength - done < blockSize ? yLength - done : blockSize;
+			nrBlocks++;
+		}
+	}
+
+	if (nrBlocks > 0)
+	{
+		applyKeystream(context, group, nrBlocks);
+	}
+}
+
+/*
+	Values go COLUMN_GROUP at a time through the Feistel network: round r
+	of every value of the group runs before round r + 1, so the CMAC chains
+	and the keystreams of all of them share batch calls.
+*/
+static void cryptDeterministic(CipherContext* context, const uint8_t* nonce, const Layout* layout,
+							   const uint8_t* in, uint8_t* out, int decrypt)
+{
+	Group group;
+	CmacContext cmac;
+	uint32_t maxRounds;
+	uint32_t r;
+	size_t start;
+	size_t length;
+	size_t first;
+	size_t n;
+	size_t v;
+
+	CMAC_init(&cmac, context);
+
+	for (first = 0; first < layout->count; first += n)
+	{
+		n = layout->count - first < COLUMN_GROUP ? layout->count - first : COLUMN_GROUP;
+
+		maxRounds = 0;
+		for (v = 0; v < n; v++)
+		{
+			start = valueStart(layout, first + v);
+			length = valueLength(layout, first + v);
+			memmove(out + start, in + start, length);
+			setupValue(&group.values[v], out + start, length);
+			maxRounds = group.values[v].nrRounds > maxRounds ? group.values[v].nrRounds : maxRounds;
+		}
+
+		for (r = 0; r < maxRounds; r++)
+		{
+			roundMacs(&cmac, nonce, &group, n, r, decrypt);
+			roundKeystreams(context, &group, n, r, decrypt);
+		}
+
+		for (v = 0; v < n; v++)
+		{
+			if (group.values[v].length == 1)
+			{
+				out[valueStart(layout, first + v)] = (uint8_t)(group.values[v].nibbles[0] << 4 | group.values[v].nibbles[1]);
+			}
+		}
+	}
+
+	CIPHER_wipe(&cmac, sizeof(cmac));
+}
+
+static CipherStatus crypt(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+						  const Layout* layout, const uint8_t* in, uint8_t* out, int decrypt)
+{
+	size_t blockSize = context->cipher->blockSize;
+	size_t total = layout->offsets != NULL ? layout->offsets[layout->count] - layout->offsets[0] : layout->width * layout->count;
+
+	// 32 bits block indices, and rows in the 32 bits above them
+	if (mode == COLUMN_RANDOMIZED && blockSize < 12 && (firstRow > UINT32_MAX || layout->count > UINT32_MAX - firstRow + 1))
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	STATS_MODE(STATS_MODE_CTR, total);
+	PROBE_MODE_ENTRY(STATS_MODE_CTR, context->cipher->id, total);
+	if (mode == COLUMN_DETERMINISTIC)
+	{
+		cryptDeterministic(context, nonce, layout, in, out, decrypt);
+	}
+	else
+	{
+		cryptRandomized(context, nonce, firstRow, layout, in, out);
+	}
+	PROBE_MODE_EXIT(STATS_MODE_CTR, context->cipher->id, total);
+
+	return CIPHER_OK;
+}
+
+static CipherStatus cryptFixed(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+							  const uint8_t* in, uint8_t* out, size_t width, size_t count, int decrypt)
+{
+	Layout layout;
+
+	if (width / context->cipher->blockSize > UINT32_MAX)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	layout.offsets = NULL;
+	layout.width = width;
+	layout.count = count;
+
+	return crypt(context, mode, nonce, firstRow, &layout, in, out, decrypt);
+}
+
+static CipherStatus cryptVariable(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+								  const uint32_t* offsets, const uint8_t* in, uint8_t* out, size_t count, int decrypt)
+{
+	Layout layout;
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		if (offsets[i + 1] < offsets[i])
+		{
+			return CIPHER_ERROR_LENGTH;
+		}
+	}
+
+	layout.offsets = offsets;
+	layout.width = 0;
+	layout.count = count;
+
+	return crypt(context, mode, nonce, firstRow, &layout, in, out, decrypt);
+}
+
+CipherStatus COLUMN_encrypt_fixed(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+								  const uint8_t* in, uint8_t* out, size_t width, size_t count)
+{
+	return cryptFixed(context, mode, nonce, firstRow, in, out, width, count, 0);
+}
+
+CipherStatus COLUMN_decrypt_fixed(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+								  const uint8_t* in, uint8_t* out, size_t width, size_t count)
+{
+	return cryptFixed(context, mode, nonce, firstRow, in, out, width, count, 1);
+}
+
+CipherStatus COLUMN_encrypt_variable(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+									 const uint32_t* offsets, const uint8_t* in, uint8_t* out, size_t count)
+{
+	return cryptVariable(context, mode, nonce, firstRow, offsets, in, out, count, 0);
+}
+
+CipherStatus COLUMN_decrypt_variable(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+									 const uint32_t* offsets, const uint8_t* in, uint8_t* out, size_t count)
+{
+	return cryptVariable(context, mode, nonce, firstRow, offsets, in, out, count, 1);
+}
\ No newline at end of file
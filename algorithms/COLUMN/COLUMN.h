@@ -0,0 +1,51 @@
+/* COLUMN.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+typedef enum
+{
+	// keystream of each value from its row ID, equal values give different ciphertexts
+	COLUMN_RANDOMIZED = 0,
+	/*
+		length-preserving cipher of each value (Feistel network with CMAC
+		round functions), so equal values give equal ciphertexts and can be
+		filtered on; nothing else of the values shows but their lengths
+	*/
+	COLUMN_DETERMINISTIC
+} ColumnMode;
+
+/*
+	Encrypt or decrypt every value of a column into out, with the same layout
+	(out may be in). nonce is one block, unique per key and column. In the
+	randomized mode value i is row firstRow + i, whose counter blocks are
+	nonce + (row << 32) + j, and decryption is the same operation; with 64
+	bits ciphers, rows must stay below 2^32 (CIPHER_ERROR_LENGTH otherwise).
+	The deterministic mode ignores firstRow.
+*/
+
+// count values of width bytes each
+CipherStatus COLUMN_encrypt_fixed(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+								  const uint8_t* in, uint8_t* out, size_t width, size_t count);
+CipherStatus COLUMN_decrypt_fixed(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+								  const uint8_t* in, uint8_t* out, size_t width, size_t count);
+
+/*
+	count variable length values, value i is in[offsets[i] .. offsets[i + 1] - 1]
+	(Arrow layout, offsets has count + 1 non-decreasing entries,
+	CIPHER_ERROR_LENGTH otherwise).
+*/
+CipherStatus COLUMN_encrypt_variable(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+									 const uint32_t* offsets, const uint8_t* in, uint8_t* out, size_t count);
+CipherStatus COLUMN_decrypt_variable(CipherContext* context, ColumnMode mode, const uint8_t* nonce, uint64_t firstRow,
+									 const uint32_t* offsets, const uint8_t* in, uint8_t* out, size_t count);
\ No newline at end of file
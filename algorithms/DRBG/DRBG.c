@@ -0,0 +1,319 @@
+/* DRBG.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * CTR_DRBG deterministic random bit generator over the 128 bits ciphers.
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-90Ar1.pdf
+ *
+ * Each Generate call produces DRBG_BUFFER_SIZE bytes: the counter blocks
+ * of the output and of the following key update are consecutive, so they
+ * are encrypted in a single batch call. Small requests are then served
+ * from the buffer with a copy, and the thread instances need no lock.
+ *
+ */
+
+#include <pthread.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+#include "DRBG.h"
+#include "../MODES/MODES.h"
+
+#define BLOCK_SIZE 16
+#define BUFFER_BLOCKS (DRBG_BUFFER_SIZE / BLOCK_SIZE)
+
+// incremented in the child of each fork, instances seeded before it reseed
+static uint64_t forkGeneration = 0;
+static pthread_once_t forkOnce = PTHREAD_ONCE_INIT;
+
+static _Thread_local DrbgContext threadContext;
+static _Thread_local int threadReady = 0;
+static pthread_key_t threadKey;
+static pthread_once_t threadOnce = PTHREAD_ONCE_INIT;
+
+static void forkChild(void)
+{
+	DRBG_fork_reset();
+}
+
+static void registerFork(void)
+{
+	pthread_atfork(NULL, NULL, forkChild);
+}
+
+static int osEntropy(uint8_t* out, size_t length)
+{
+#if defined(__linux__)
+	ssize_t n;
+
+	while (length > 0)
+	{
+		n = getrandom(out, length, 0);
+		if (n <= 0)
+		{
+			return -1;
+		}
+		out += n;
+		length -= (size_t)n;
+	}
+
+	return 0;
+#elif defined(__unix__) || defined(__APPLE__)
+	FILE* file = fopen("/dev/urandom", "rb");
+	size_t n;
+
+	if (file == NULL)
+	{
+		return -1;
+	}
+	n = fread(out, 1, length, file);
+	fclose(file);
+
+	return n == length ? 0 : -1;
+#else
+	(void)out;
+	(void)length;
+
+	return -1;
+#endif
+}
+
+static size_t seedLength(const DrbgContext* context)
+{
+	return context->keyLen / 8 + BLOCK_SIZE;
+}
+
+/*
+	Encrypts V + 1 .. V + nrBlocks into out, then runs CTR_DRBG_Update
+	with providedData (seed length bytes, NULL for zeros) on the blocks
+	that follow, all in one batch call.
+*/
+static void generateBlocks(DrbgContext* context, uint8_t* out, size_t nrBlocks, const uint8_t* providedData)
+{
+	uint8_t blocks[(BUFFER_BLOCKS + DRBG_MAX_SEED_LENGTH / BLOCK_SIZE) * BLOCK_SIZE];
+	size_t length = seedLength(context);
+	size_t nrUpdateBlocks = (length + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	uint8_t* temp = blocks + nrBlocks * BLOCK_SIZE;
+	size_t i;
+
+	for (i = 0; i < nrBlocks + nrUpdateBlocks; i++)
+	{
+		MODES_counter_increment(context->V, BLOCK_SIZE);
+		memcpy(blocks + i * BLOCK_SIZE, context->V, BLOCK_SIZE);
+	}
+	CIPHER_encrypt_blocks(&context->cipher, blocks, blocks, nrBlocks + nrUpdateBlocks);
+	if (nrBlocks > 0)
+	{
+		memcpy(out, blocks, nrBlocks * BLOCK_SIZE);
+	}
+
+	// Key = leftmost keylen bits of temp, V = rightmost blocklen bits
+	if (providedData != NULL)
+	{
+		for (i = 0; i < length; i++)
+		{
+			temp[i] ^= providedData[i];
+		}
+	}
+	CIPHER_init_encrypt(&context->cipher, context->cipher.cipher->id, temp, context->keyLen);
+	memcpy(context->V, temp + context->keyLen / 8, BLOCK_SIZE);
+
+	CIPHER_wipe(blocks, sizeof(blocks));
+}
+
+// seed material = input xor the zero padded string
+static CipherStatus seed(DrbgContext* context, const uint8_t* input, const uint8_t* string, size_t stringLength)
+{
+	uint8_t material[DRBG_MAX_SEED_LENGTH];
+	size_t length = seedLength(context);
+	size_t i;
+
+	if (stringLength > length)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	for (i = 0; i < length; i++)
+	{
+		material[i] = input[i] ^ (i < stringLength ? string[i] : 0);
+	}
+	generateBlocks(context, NULL, 0, material);
+	context->reseedCounter = 1;
+	context->forkGeneration = __atomic_load_n(&forkGeneration, __ATOMIC_ACQUIRE);
+	CIPHER_wipe(context->buffer, sizeof(context->buffer));
+	context->available = 0;
+
+	CIPHER_wipe(material, sizeof(material));
+
+	return CIPHER_OK;
+}
+
+CipherStatus DRBG_instantiate(DrbgContext* context, CipherId id, uint16_t keyLen, const uint8_t* entropyInput,
+							  const uint8_t* personalization, size_t personalizationLength)
+{
+	uint8_t zeros[CIPHER_MAX_KEY_SIZE] = { 0 };
+	const CipherDescriptor* cipher = CIPHER_get(id);
+	CipherStatus status;
+
+	if (cipher == NULL || cipher->blockSize != BLOCK_SIZE)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	pthread_once(&forkOnce, registerFork);
+
+	// Key = 0, V = 0
+	status = CIPHER_init_encrypt(&context->cipher, id, zeros, keyLen);
+	if (status != CIPHER_OK)
+	{
+		return status;
+	}
+	memset(context->V, 0, BLOCK_SIZE);
+	context->keyLen = keyLen;
+	context->entropy = NULL;
+
+	return seed(context, entropyInput, personalization, personalizationLength);
+}
+
+CipherStatus DRBG_init(DrbgContext* context, CipherId id, uint16_t keyLen, DrbgEntropy entropy,
+					   const uint8_t* personalization, size_t personalizationLength)
+{
+	uint8_t entropyInput[DRBG_MAX_SEED_LENGTH];
+	int result;
+	CipherStatus status;
+
+	if (keyLen > 8 * CIPHER_MAX_KEY_SIZE)
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+
+	result = entropy != NULL ? entropy(entropyInput, keyLen / 8 + BLOCK_SIZE) : osEntropy(entropyInput, keyLen / 8 + BLOCK_SIZE);
+	if (result != 0)
+	{
+		return CIPHER_ERROR_ENTROPY;
+	}
+
+	status = DRBG_instantiate(context, id, keyLen, entropyInput, personalization, personalizationLength);
+	context->entropy = entropy;
+	CIPHER_wipe(entropyInput, sizeof(entropyInput));
+
+	return status;
+}
+
+CipherStatus DRBG_reseed(DrbgContext* context, const uint8_t* additional, size_t additionalLength)
+{
+	uint8_t entropyInput[DRBG_MAX_SEED_LENGTH];
+	size_t length = seedLength(context);
+	int result;
+	CipherStatus status;
+
+	result = context->entropy != NULL ? context->entropy(entropyInput, length) : osEntropy(entropyInput, length);
+	if (result != 0)
+	{
+		return CIPHER_ERROR_ENTROPY;
+	}
+
+	status = seed(context, entropyInput, additional, additionalLength);
+	CIPHER_wipe(entropyInput, sizeof(entropyInput));
+
+	return status;
+}
+
+CipherStatus DRBG_generate(DrbgContext* context, uint8_t* out, size_t length)
+{
+	CipherStatus status;
+	size_t n;
+
+	// duplicated process, the buffer and the state are shared with the parent
+	if (context->forkGeneration != __atomic_load_n(&forkGeneration, __ATOMIC_ACQUIRE))
+	{
+		status = DRBG_reseed(context, NULL, 0);
+		if (status != CIPHER_OK)
+		{
+			return status;
+		}
+	}
+
+	while (length > 0)
+	{
+		if (context->available > 0)
+		{
+			n = length < context->available ? length : context->available;
+			memcpy(out, context->buffer + DRBG_BUFFER_SIZE - context->available, n);
+			CIPHER_wipe(context->buffer + DRBG_BUFFER_SIZE - context->available, n);
+			context->available -= n;
+			out += n;
+			length -= n;
+			continue;
+		}
+
+		if (context->reseedCounter > DRBG_RESEED_INTERVAL)
+		{
+			status = DRBG_reseed(context, NULL, 0);
+			if (status != CIPHER_OK)
+			{
+				return status;
+			}
+		}
+
+		// whole buffers go straight to the output
+		if (length >= DRBG_BUFFER_SIZE)
+		{
+			generateBlocks(context, out, BUFFER_BLOCKS, NULL);
+			out += DRBG_BUFFER_SIZE;
+			length -= DRBG_BUFFER_SIZE;
+		}
+		else
+		{
+			generateBlocks(context, context->buffer, BUFFER_BLOCKS, NULL);
+			context->available = DRBG_BUFFER_SIZE;
+		}
+		context->reseedCounter++;
+	}
+
+	return CIPHER_OK;
+}
+
+void DRBG_uninstantiate(DrbgContext* context)
+{
+	CIPHER_wipe(context, sizeof(DrbgContext));
+}
+
+static void releaseThread(void* context)
+{
+	DRBG_uninstantiate((DrbgContext*)context);
+}
+
+static void createThreadKey(void)
+{
+	pthread_key_create(&threadKey, releaseThread);
+}
+
+CipherStatus DRBG_random_bytes(uint8_t* out, size_t length)
+{
+	CipherStatus status;
+
+	if (!threadReady)
+	{
+		status = DRBG_init(&threadContext, CIPHER_CAMELLIA, 256, NULL, NULL, 0);
+		if (status != CIPHER_OK)
+		{
+			return status;
+		}
+		pthread_once(&threadOnce, createThreadKey);
+		pthread_setspecific(threadKey, &threadContext);
+		threadReady = 1;
+	}
+
+	return DRBG_generate(&threadContext, out, length);
+}
+
+void DRBG_fork_reset(void)
+{
+	__atomic_add_fetch(&forkGeneration, 1, __ATOMIC_ACQ_REL);
+}
\ No newline at end of file
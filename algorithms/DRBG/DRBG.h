@@ -0,0 +1,80 @@
+/* DRBG.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+// bytes generated per SP 800-90A Generate call, then served by DRBG_generate
+#define DRBG_BUFFER_SIZE 4096
+// Generate calls between two reseeds
+#define DRBG_RESEED_INTERVAL 65536
+#define DRBG_MAX_SEED_LENGTH (CIPHER_MAX_KEY_SIZE + 16)
+
+// fills out with length bytes of entropy, returns 0 on success
+typedef int (*DrbgEntropy)(uint8_t* out, size_t length);
+
+typedef struct
+{
+	CipherContext cipher;
+	uint8_t V[16];
+	uint16_t keyLen;
+	uint64_t reseedCounter;
+	// NULL for the entropy source of the operating system
+	DrbgEntropy entropy;
+	uint64_t forkGeneration;
+	// unread bytes, at the end of buffer
+	size_t available;
+	uint8_t buffer[DRBG_BUFFER_SIZE];
+} DrbgContext;
+
+/*
+	CTR_DRBG of SP 800-90A without derivation function, over a 128 bits
+	cipher (ARIA, CAMELLIA, SEED, ...; CIPHER_ERROR_ID otherwise). The seed
+	length is keyLen / 8 + 16 bytes; the personalization string is at most
+	that long (CIPHER_ERROR_LENGTH otherwise). DRBG_instantiate takes the
+	entropy input (of the seed length) from the caller, for known answer
+	tests; DRBG_init reads it from the entropy source (NULL for the
+	operating system).
+*/
+CipherStatus DRBG_instantiate(DrbgContext* context, CipherId id, uint16_t keyLen, const uint8_t* entropyInput,
+							  const uint8_t* personalization, size_t personalizationLength);
+CipherStatus DRBG_init(DrbgContext* context, CipherId id, uint16_t keyLen, DrbgEntropy entropy,
+					   const uint8_t* personalization, size_t personalizationLength);
+
+// new entropy from the source, with optional additional input (at most the seed length)
+CipherStatus DRBG_reseed(DrbgContext* context, const uint8_t* additional, size_t additionalLength);
+
+/*
+	Serves length bytes from the buffer; an empty buffer is refilled by
+	one Generate call (keystream and key update in one batch call). The
+	context reseeds itself every DRBG_RESEED_INTERVAL Generate calls and
+	after a fork. Served bytes are wiped from the buffer.
+*/
+CipherStatus DRBG_generate(DrbgContext* context, uint8_t* out, size_t length);
+
+// wipes the state
+void DRBG_uninstantiate(DrbgContext* context);
+
+/*
+	length bytes from the instance of the calling thread (CAMELLIA with a
+	256 bits key, seeded from the operating system on first use and wiped
+	when the thread exits), without any lock.
+*/
+CipherStatus DRBG_random_bytes(uint8_t* out, size_t length);
+
+/*
+	Makes every instance reseed and drop its buffer before its next output.
+	Runs by itself in the child of fork() (pthread_atfork); call it after
+	process duplications that bypass fork(), as a raw clone() or a restored
+	snapshot of a virtual machine.
+*/
+void DRBG_fork_reset(void);
\ No newline at end of file
@@ -0,0 +1,721 @@
+/* FPE.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Format-preserving encryption FF1 and FF3-1 over the 128 bits block
+ * ciphers of the repository, for the tokenization of card numbers,
+ * national IDs, ...
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-38Gr1-draft.pdf
+ *
+ * Values are processed in groups of GROUP, in lockstep. Every cipher
+ * call of a round of the group (the CBC-MAC blocks and the output blocks
+ * of FF1, the single block of FF3-1) is one batch call, and the numerals
+ * and big integers are stored numeral (limb) major, one value per lane,
+ * so the radix conversions run on the vectors of SIMD.
+ *
+ * Big integers are little-endian 16 bits limbs held in 32 bits lanes, so
+ * the products by the radix fit, and the division by the radix is a
+ * multiplication by a precomputed reciprocal (Granlund and Montgomery),
+ * as vectors have no integer division.
+ *
+ */
+
+#include <string.h>
+
+#include "FPE.h"
+#include "../SIMD/SIMD.h"
+
+#ifdef SIMD_AVAILABLE
+typedef SimdU32 Lanes;
+#define NR_LANES SIMD_LANES_32
+#else
+typedef uint32_t Lanes;
+#define NR_LANES 1
+#endif
+
+// values processed together (a multiple of NR_LANES)
+#define GROUP 32
+#define FF1_ROUNDS 10
+#define FF3_ROUNDS 8
+#define BLOCK_SIZE 16
+// numerals of the longer half
+#define MAX_HALF (FPE_MAX_LENGTH - FPE_MAX_LENGTH / 2)
+// FF1: b <= 2 * MAX_HALF bytes and d <= b + 4, in 16 bits limbs
+#define MAX_LIMBS (MAX_HALF + 2)
+#define MAX_S_BLOCKS ((2 * MAX_LIMBS + BLOCK_SIZE - 1) / BLOCK_SIZE)
+// FF1: Q = T || 0^pad || [i] || [NUM(B)]^b
+#define MAX_Q (FPE_MAX_TWEAK_LENGTH + BLOCK_SIZE + 2 * MAX_HALF)
+
+typedef uint32_t Row[GROUP];
+
+typedef struct
+{
+	// lanes in use, the values of the group rounded up to NR_LANES
+	size_t width;
+	// numerals of the halves, least significant first, numeral j of value k in [j][k]
+	Row halves[3][MAX_HALF];
+	// big integer, limb l of value k in [l][k]
+	Row limbs[MAX_LIMBS];
+	// low numerals of y
+	Row y[MAX_HALF];
+	// cipher blocks of a batch call
+	uint8_t blocks[GROUP][BLOCK_SIZE];
+	uint8_t extra[GROUP][BLOCK_SIZE];
+	// FF1: CBC-MAC of P and of the blocks of Q that only hold the tweak
+	uint8_t prefix[GROUP][BLOCK_SIZE];
+	uint8_t Q[GROUP][MAX_Q];
+	uint8_t S[GROUP][MAX_S_BLOCKS * BLOCK_SIZE];
+} Workspace;
+
+typedef struct
+{
+	size_t length;
+	size_t u;
+	size_t v;
+	// n / radix = (t + ((n - t) >> 1)) >> shift, with t = mulhi(multiplier, n)
+	uint32_t radix;
+	uint32_t multiplier;
+	int shift;
+	// FF1
+	size_t b;
+	size_t d;
+	size_t tweakLength;
+	size_t qLength;
+	size_t constantBlocks;
+	uint8_t R0[BLOCK_SIZE];
+} Parameters;
+
+static Lanes load(const uint32_t* p)
+{
+	Lanes x;
+
+	memcpy(&x, p, sizeof(x));
+
+	return x;
+}
+
+static void store(uint32_t* p, Lanes x)
+{
+	memcpy(p, &x, sizeof(x));
+}
+
+// high half of the 64 bits products of the lanes by the multiplier, from 16 bits halves
+static Lanes mulhi(Lanes n, uint32_t multiplier)
+{
+	uint32_t mh = multiplier >> 16;
+	uint32_t ml = multiplier & 0xffff;
+	Lanes nh = n >> 16;
+	Lanes nl = n & 0xffff;
+	Lanes p1 = nl * mh;
+	Lanes p2 = nh * ml;
+	Lanes middle = ((nl * ml) >> 16) + (p1 & 0xffff) + (p2 & 0xffff);
+
+	return nh * mh + (p1 >> 16) + (p2 >> 16) + (middle >> 16);
+}
+
+// number of bits of radix^k - 1, ceil(k * log2(radix))
+static size_t powerBits(uint32_t radix, size_t k)
+{
+	uint32_t x[FPE_MAX_LENGTH + 1] = { 1 };
+	uint32_t carry;
+	size_t nrLimbs = 1;
+	size_t bits;
+	size_t i;
+	size_t l;
+
+	for (i = 0; i < k; i++)
+	{
+		carry = 0;
+		for (l = 0; l < nrLimbs; l++)
+		{
+			uint32_t t = x[l] * radix + carry;
+
+			x[l] = t & 0xffff;
+			carry = t >> 16;
+		}
+		if (carry != 0)
+		{
+			x[nrLimbs++] = carry;
+		}
+	}
+
+	// minus one
+	for (l = 0; x[l] == 0; l++)
+	{
+		x[l] = 0xffff;
+	}
+	x[l]--;
+
+	for (l = nrLimbs; l > 1 && x[l - 1] == 0; l--)
+	{
+	}
+	for (bits = (l - 1) * 16; x[l - 1] >> (bits - (l - 1) * 16) != 0; bits++)
+	{
+	}
+
+	return bits;
+}
+
+/*
+	limbs = the numerals digits[0 .. length - 1] (least significant first)
+	of every value, by Horner's rule on nrLimbs limbs
+*/
+static void toInteger(size_t width, Row* limbs, const Row* digits, size_t length, size_t nrLimbs, uint32_t radix)
+{
+	Lanes x[MAX_LIMBS];
+	Lanes carry;
+	Lanes t;
+	size_t g;
+	size_t j;
+	size_t l;
+
+	for (g = 0; g < width; g += NR_LANES)
+	{
+		memset(x, 0, sizeof(x));
+
+		for (j = length; j > 0; j--)
+		{
+			carry = load(&digits[j - 1][g]);
+			for (l = 0; l < nrLimbs; l++)
+			{
+				t = x[l] * radix + carry;
+				x[l] = t & 0xffff;
+				carry = t >> 16;
+			}
+		}
+
+		for (l = 0; l < nrLimbs; l++)
+		{
+			store(&limbs[l][g], x[l]);
+		}
+	}
+}
+
+// y = the m low numerals of the big integers, by m divisions by the radix
+static void lowNumerals(size_t width, Row* y, const Row* limbs, size_t nrLimbs, size_t m, const Parameters* p)
+{
+	Lanes x[MAX_LIMBS];
+	Lanes remainder;
+	Lanes n;
+	Lanes t;
+	Lanes q;
+	size_t g;
+	size_t j;
+	size_t l;
+
+	for (g = 0; g < width; g += NR_LANES)
+	{
+		for (l = 0; l < nrLimbs; l++)
+		{
+			x[l] = load(&limbs[l][g]);
+		}
+
+		for (j = 0; j < m; j++)
+		{
+			remainder = x[0] ^ x[0];
+			for (l = nrLimbs; l > 0; l--)
+			{
+				n = remainder << 16 | x[l - 1];
+				t = mulhi(n, p->multiplier);
+				q = (t + ((n - t) >> 1)) >> p->shift;
+				x[l - 1] = q;
+				remainder = n - q * p->radix;
+			}
+			store(&y[j][g], remainder);
+		}
+	}
+}
+
+// out = (a + y) mod radix^m, numeral by numeral
+static void addNumerals(size_t width, Row* out, const Row* a, const Row* y, size_t m, uint32_t radix)
+{
+	Lanes carry;
+	Lanes s;
+	size_t g;
+	size_t j;
+
+	for (g = 0; g < width; g += NR_LANES)
+	{
+		carry = load(&a[0][g]) ^ load(&a[0][g]);
+		for (j = 0; j < m; j++)
+		{
+			s = load(&a[j][g]) + load(&y[j][g]) + carry;
+			// s - radix wraps (top bit set) when s < radix
+			carry = 1 - ((s - radix) >> 31);
+			store(&out[j][g], s - carry * radix);
+		}
+	}
+}
+
+// out = (a - y) mod radix^m, numeral by numeral
+static void subtractNumerals(size_t width, Row* out, const Row* a, const Row* y, size_t m, uint32_t radix)
+{
+	Lanes borrow;
+	Lanes s;
+	size_t g;
+	size_t j;
+
+	for (g = 0; g < width; g += NR_LANES)
+	{
+		borrow = load(&a[0][g]) ^ load(&a[0][g]);
+		for (j = 0; j < m; j++)
+		{
+			s = load(&a[j][g]) - load(&y[j][g]) - borrow;
+			borrow = s >> 31;
+			store(&out[j][g], s + borrow * radix);
+		}
+	}
+}
+
+// numerals of the count values into the halves, unused lanes set to zero
+static void loadHalves(Workspace* w, const Parameters* p, const uint16_t* in, size_t count, int reverse)
+{
+	size_t k;
+	size_t j;
+
+	w->width = (count + NR_LANES - 1) / NR_LANES * NR_LANES;
+	for (k = 0; k < count; k++)
+	{
+		const uint16_t* x = in + k * p->length;
+
+		for (j = 0; j < p->u; j++)
+		{
+			w->halves[0][reverse ? p->u - 1 - j : j][k] = x[j];
+		}
+		for (j = 0; j < p->v; j++)
+		{
+			w->halves[1][reverse ? p->v - 1 - j : j][k] = x[p->u + j];
+		}
+	}
+	for (; k < w->width; k++)
+	{
+		for (j = 0; j < p->u; j++)
+		{
+			w->halves[0][j][k] = 0;
+			w->halves[1][j][k] = 0;
+		}
+	}
+}
+
+static void storeHalves(const Row* a, const Row* b, const Parameters* p, uint16_t* out, size_t count, int reverse)
+{
+	size_t k;
+	size_t j;
+
+	for (k = 0; k < count; k++)
+	{
+		uint16_t* x = out + k * p->length;
+
+		for (j = 0; j < p->u; j++)
+		{
+			x[j] = (uint16_t)a[reverse ? p->u - 1 - j : j][k];
+		}
+		for (j = 0; j < p->v; j++)
+		{
+			x[p->u + j] = (uint16_t)b[reverse ? p->v - 1 - j : j][k];
+		}
+	}
+}
+
+/*
+	FF1 keeps NUM_radix(X) with the first numeral most significant, the
+	halves are reversed on load and store. The CBC-MAC of P and of the
+	blocks of Q before the one holding the round number does not change
+	from round to round, it is computed once into prefix.
+*/
+static void ff1Prefix(FpeContext* context, Workspace* w, const Parameters* p, const uint8_t* tweaks, size_t count)
+{
+	size_t blockIndex;
+	size_t k;
+	size_t i;
+
+	for (k = 0; k < count; k++)
+	{
+		memcpy(w->prefix[k], p->R0, BLOCK_SIZE);
+	}
+
+	for (blockIndex = 0; blockIndex < p->constantBlocks; blockIndex++)
+	{
+		for (k = 0; k < count; k++)
+		{
+			const uint8_t* tweak = tweaks + k * p->tweakLength + blockIndex * BLOCK_SIZE;
+
+			for (i = 0; i < BLOCK_SIZE; i++)
+			{
+				w->blocks[k][i] = w->prefix[k][i] ^ (blockIndex * BLOCK_SIZE + i < p->tweakLength ? tweak[i] : 0);
+			}
+		}
+		CIPHER_encrypt_blocks(&context->cipher, w->blocks[0], w->blocks[0], count);
+		memcpy(w->prefix, w->blocks, count * BLOCK_SIZE);
+	}
+}
+
+// y = the m low numerals of NUM(S) of round i, from the sourceLength numerals of source
+static void ff1Round(FpeContext* context, Workspace* w, const Parameters* p, const uint8_t* tweaks, size_t count,
+					 int round, const Row* source, size_t sourceLength, size_t m)
+{
+	size_t start = p->constantBlocks * BLOCK_SIZE;
+	size_t tailLength = p->qLength - start;
+	size_t nrLimbs = (p->b + 1) / 2;
+	size_t nrSBlocks = (p->d + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	size_t blockIndex;
+	size_t k;
+	size_t e;
+	size_t i;
+
+	// Q from its first block that is not in the prefix
+	toInteger(w->width, w->limbs, source, sourceLength, nrLimbs, p->radix);
+	for (k = 0; k < count; k++)
+	{
+		uint8_t* q = w->Q[k];
+
+		memset(q, 0, tailLength);
+		if (p->tweakLength > start)
+		{
+			memcpy(q, tweaks + k * p->tweakLength + start, p->tweakLength - start);
+		}
+		q[tailLength - p->b - 1] = (uint8_t)round;
+		for (e = 0; e < p->b; e++)
+		{
+			q[tailLength - 1 - e] = (uint8_t)(w->limbs[e / 2][k] >> (e % 2 * 8));
+		}
+	}
+
+	// R = PRF(P || Q)
+	memcpy(w->blocks, w->prefix, count * BLOCK_SIZE);
+	for (blockIndex = 0; blockIndex < tailLength / BLOCK_SIZE; blockIndex++)
+	{
+		for (k = 0; k < count; k++)
+		{
+			for (i = 0; i < BLOCK_SIZE; i++)
+			{
+				w->blocks[k][i] ^= w->Q[k][blockIndex * BLOCK_SIZE + i];
+			}
+		}
+		CIPHER_encrypt_blocks(&context->cipher, w->blocks[0], w->blocks[0], count);
+	}
+
+	// S = R || CIPH(R xor [1]) || CIPH(R xor [2]) ...
+	for (k = 0; k < count; k++)
+	{
+		memcpy(w->S[k], w->blocks[k], BLOCK_SIZE);
+	}
+	for (blockIndex = 1; blockIndex < nrSBlocks; blockIndex++)
+	{
+		memcpy(w->extra, w->blocks, count * BLOCK_SIZE);
+		for (k = 0; k < count; k++)
+		{
+			w->extra[k][BLOCK_SIZE - 1] ^= (uint8_t)blockIndex;
+		}
+		CIPHER_encrypt_blocks(&context->cipher, w->extra[0], w->extra[0], count);
+		for (k = 0; k < count; k++)
+		{
+			memcpy(w->S[k] + blockIndex * BLOCK_SIZE, w->extra[k], BLOCK_SIZE);
+		}
+	}
+
+	// y = NUM(S[0 .. d - 1]), d is even
+	for (k = 0; k < w->width; k++)
+	{
+		for (e = 0; e < p->d / 2; e++)
+		{
+			w->limbs[e][k] = k < count ? (uint32_t)w->S[k][p->d - 1 - 2 * e] | (uint32_t)w->S[k][p->d - 2 - 2 * e] << 8 : 0;
+		}
+	}
+	lowNumerals(w->width, w->y, w->limbs, p->d / 2, m, p);
+}
+
+static void ff1Group(FpeContext* context, Workspace* w, const Parameters* p, const uint8_t* tweaks,
+					 const uint16_t* in, uint16_t* out, size_t count, int decrypt)
+{
+	Row* a = w->halves[0];
+	Row* b = w->halves[1];
+	Row* c = w->halves[2];
+	Row* t;
+	size_t m;
+	int i;
+
+	loadHalves(w, p, in, count, 1);
+	ff1Prefix(context, w, p, tweaks, count);
+
+	for (i = 0; i < FF1_ROUNDS; i++)
+	{
+		int round = decrypt ? FF1_ROUNDS - 1 - i : i;
+
+		m = round % 2 == 0 ? p->u : p->v;
+		if (!decrypt)
+		{
+			// C = A + y, A = B, B = C
+			ff1Round(context, w, p, tweaks, count, round, b, p->length - m, m);
+			addNumerals(w->width, c, a, w->y, m, p->radix);
+			t = a;
+			a = b;
+			b = c;
+			c = t;
+		}
+		else
+		{
+			// C = B - y, B = A, A = C
+			ff1Round(context, w, p, tweaks, count, round, a, p->length - m, m);
+			subtractNumerals(w->width, c, b, w->y, m, p->radix);
+			t = b;
+			b = a;
+			a = c;
+			c = t;
+		}
+	}
+
+	storeHalves(a, b, p, out, count, 1);
+}
+
+/*
+	FF3-1 reverses the numeral strings and the bytes of its blocks, so its
+	halves are least significant first as given, and the cipher block is
+	NUM(B) little-endian followed by the reversed W xor [i].
+*/
+static void ff3Group(FpeContext* context, Workspace* w, const Parameters* p, const uint8_t* tweaks,
+					 const uint16_t* in, uint16_t* out, size_t count, int decrypt)
+{
+	Row* a = w->halves[0];
+	Row* b = w->halves[1];
+	Row* c = w->halves[2];
+	Row* t;
+	size_t m;
+	size_t k;
+	size_t e;
+	int i;
+
+	loadHalves(w, p, in, count, 0);
+
+	for (i = 0; i < FF3_ROUNDS; i++)
+	{
+		int round = decrypt ? FF3_ROUNDS - 1 - i : i;
+
+		m = round % 2 == 0 ? p->u : p->v;
+		toInteger(w->width, w->limbs, decrypt ? a : b, p->length - m, 6, p->radix);
+
+		for (k = 0; k < count; k++)
+		{
+			const uint8_t* tweak = tweaks + k * 7;
+			uint8_t* block = w->blocks[k];
+
+			for (e = 0; e < 12; e++)
+			{
+				block[e] = (uint8_t)(w->limbs[e / 2][k] >> (e % 2 * 8));
+			}
+
+			// W = T_R = T[32..55] || T[28..31] || 0^4 in even rounds, T_L = T[0..27] || 0^4 otherwise
+			if (round % 2 == 0)
+			{
+				block[12] = (uint8_t)((tweak[3] << 4) ^ round);
+				block[13] = tweak[6];
+				block[14] = tweak[5];
+				block[15] = tweak[4];
+			}
+			else
+			{
+				block[12] = (uint8_t)((tweak[3] & 0xf0) ^ round);
+				block[13] = tweak[2];
+				block[14] = tweak[1];
+				block[15] = tweak[0];
+			}
+		}
+		CIPHER_encrypt_blocks(&context->cipher, w->blocks[0], w->blocks[0], count);
+
+		// y = NUM(REVB(block))
+		for (k = 0; k < w->width; k++)
+		{
+			for (e = 0; e < BLOCK_SIZE / 2; e++)
+			{
+				w->limbs[e][k] = k < count ? (uint32_t)w->blocks[k][2 * e] | (uint32_t)w->blocks[k][2 * e + 1] << 8 : 0;
+			}
+		}
+		lowNumerals(w->width, w->y, w->limbs, BLOCK_SIZE / 2, m, p);
+
+		if (!decrypt)
+		{
+			addNumerals(w->width, c, a, w->y, m, p->radix);
+			t = a;
+			a = b;
+			b = c;
+			c = t;
+		}
+		else
+		{
+			subtractNumerals(w->width, c, b, w->y, m, p->radix);
+			t = b;
+			b = a;
+			a = c;
+			c = t;
+		}
+	}
+
+	storeHalves(a, b, p, out, count, 0);
+}
+
+static CipherStatus setup(FpeContext* context, Parameters* p, size_t tweakLength, const uint16_t* in, size_t length, size_t count)
+{
+	uint64_t domain = 1;
+	size_t i;
+
+	// radix^length >= 1000000
+	for (i = 0; i < length && domain < 1000000; i++)
+	{
+		domain *= context->radix;
+	}
+	if (length < 2 || length > FPE_MAX_LENGTH || domain < 1000000)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	for (i = 0; i < length * count; i++)
+	{
+		if (in[i] >= context->radix)
+		{
+			return CIPHER_ERROR_LENGTH;
+		}
+	}
+
+	p->length = length;
+	p->radix = context->radix;
+	p->tweakLength = tweakLength;
+
+	// Granlund-Montgomery reciprocal of the radix
+	for (p->shift = 0; ((uint32_t)1 << p->shift) < context->radix; p->shift++)
+	{
+	}
+	p->multiplier = (uint32_t)(((uint64_t)1 << 32) * (((uint64_t)1 << p->shift) - context->radix) / context->radix + 1);
+	p->shift--;
+
+	if (context->method == FPE_FF3_1)
+	{
+		p->u = (length + 1) / 2;
+		p->v = length - p->u;
+
+		// radix^u <= 2^96, length <= 2 * floor(log_radix(2^96))
+		return tweakLength == 7 && powerBits(context->radix, p->u) <= 96 ? CIPHER_OK : CIPHER_ERROR_LENGTH;
+	}
+
+	if (tweakLength > FPE_MAX_TWEAK_LENGTH)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	p->u = length / 2;
+	p->v = length - p->u;
+	p->b = (powerBits(context->radix, p->v) + 7) / 8;
+	p->d = 4 * ((p->b + 3) / 4) + 4;
+	p->qLength = tweakLength + (BLOCK_SIZE - (tweakLength + p->b + 1) % BLOCK_SIZE) % BLOCK_SIZE + 1 + p->b;
+	p->constantBlocks = (p->qLength - p->b - 1) / BLOCK_SIZE;
+
+	// P = [1, 2, 1] || [radix]^3 || [10] || [u mod 256] || [n]^4 || [t]^4
+	p->R0[0] = 1;
+	p->R0[1] = 2;
+	p->R0[2] = 1;
+	p->R0[3] = (uint8_t)(context->radix >> 16);
+	p->R0[4] = (uint8_t)(context->radix >> 8);
+	p->R0[5] = (uint8_t)context->radix;
+	p->R0[6] = 10;
+	p->R0[7] = (uint8_t)p->u;
+	for (i = 0; i < 4; i++)
+	{
+		p->R0[8 + i] = (uint8_t)(length >> (24 - 8 * i));
+		p->R0[12 + i] = (uint8_t)(tweakLength >> (24 - 8 * i));
+	}
+	CIPHER_encrypt(&context->cipher, p->R0, p->R0);
+
+	return CIPHER_OK;
+}
+
+static CipherStatus crypt(FpeContext* context, const uint8_t* tweaks, size_t tweakLength,
+						  const uint16_t* in, uint16_t* out, size_t length, size_t count, int decrypt)
+{
+	Workspace w;
+	Parameters p;
+	CipherStatus status;
+	size_t offset;
+	size_t n;
+
+	status = setup(context, &p, tweakLength, in, length, count);
+	if (status != CIPHER_OK)
+	{
+		return status;
+	}
+
+	for (offset = 0; offset < count; offset += n)
+	{
+		n = count - offset < GROUP ? count - offset : GROUP;
+		if (context->method == FPE_FF3_1)
+		{
+			ff3Group(context, &w, &p, tweaks + offset * tweakLength, in + offset * length, out + offset * length, n, decrypt);
+		}
+		else
+		{
+			ff1Group(context, &w, &p, tweaks + offset * tweakLength, in + offset * length, out + offset * length, n, decrypt);
+		}
+	}
+
+	return CIPHER_OK;
+}
+
+CipherStatus FPE_init(FpeContext* context, FpeMethod method, CipherId id, const uint8_t* key, uint16_t keyLen, uint32_t radix)
+{
+	uint8_t reversed[CIPHER_MAX_KEY_SIZE];
+	const CipherDescriptor* cipher = CIPHER_get(id);
+	size_t i;
+
+	if (cipher == NULL || cipher->blockSize != BLOCK_SIZE || (method != FPE_FF1 && method != FPE_FF3_1))
+	{
+		return CIPHER_ERROR_ID;
+	}
+	if (radix < 2 || radix > 65536)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+	if (!CIPHER_supports_key_length(cipher, keyLen))
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+
+	context->method = method;
+	context->radix = radix;
+
+	if (method == FPE_FF3_1)
+	{
+		// FF3-1 is keyed with REVB(K)
+		for (i = 0; i < keyLen / 8u; i++)
+		{
+			reversed[i] = key[keyLen / 8 - 1 - i];
+		}
+		key = reversed;
+	}
+
+	return CIPHER_init_encrypt(&context->cipher, id, key, keyLen);
+}
+
+CipherStatus FPE_encrypt(FpeContext* context, const uint8_t* tweak, size_t tweakLength,
+						 const uint16_t* in, uint16_t* out, size_t length)
+{
+	return crypt(context, tweak, tweakLength, in, out, length, 1, 0);
+}
+
+CipherStatus FPE_decrypt(FpeContext* context, const uint8_t* tweak, size_t tweakLength,
+						 const uint16_t* in, uint16_t* out, size_t length)
+{
+	return crypt(context, tweak, tweakLength, in, out, length, 1, 1);
+}
+
+CipherStatus FPE_encrypt_many(FpeContext* context, const uint8_t* tweaks, size_t tweakLength,
+							  const uint16_t* in, uint16_t* out, size_t length, size_t count)
+{
+	return crypt(context, tweaks, tweakLength, in, out, length, count, 0);
+}
+
+CipherStatus FPE_decrypt_many(FpeContext* context, const uint8_t* tweaks, size_t tweakLength,
+							  const uint16_t* in, uint16_t* out, size_t length, size_t count)
+{
+	return crypt(context, tweaks, tweakLength, in, out, length, count, 1);
+}
\ No newline at end of file
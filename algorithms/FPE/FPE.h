@@ -0,0 +1,60 @@
+/* FPE.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+// numerals per value, and tweak bytes of FF1 (FF3-1 tweaks are 7 bytes)
+#define FPE_MAX_LENGTH 64
+#define FPE_MAX_TWEAK_LENGTH 64
+
+typedef enum
+{
+	FPE_FF1 = 0,
+	FPE_FF3_1
+} FpeMethod;
+
+typedef struct
+{
+	FpeMethod method;
+	uint32_t radix;
+	// encryption direction only, keyed with the byte-reversed key for FF3-1
+	CipherContext cipher;
+} FpeContext;
+
+/*
+	128 bits ciphers only (CIPHER_ERROR_ID otherwise), radix from 2 to
+	65536 (CIPHER_ERROR_LENGTH otherwise).
+*/
+CipherStatus FPE_init(FpeContext* context, FpeMethod method, CipherId id, const uint8_t* key, uint16_t keyLen, uint32_t radix);
+
+/*
+	Numerals are values below the radix, first numeral first. length must
+	satisfy radix^length >= 1000000 and be at most FPE_MAX_LENGTH (and
+	2 * floor(log_radix(2^96)) for FF3-1), CIPHER_ERROR_LENGTH otherwise, as
+	for a numeral out of range or a wrong tweak length.
+*/
+CipherStatus FPE_encrypt(FpeContext* context, const uint8_t* tweak, size_t tweakLength,
+						 const uint16_t* in, uint16_t* out, size_t length);
+CipherStatus FPE_decrypt(FpeContext* context, const uint8_t* tweak, size_t tweakLength,
+						 const uint16_t* in, uint16_t* out, size_t length);
+
+/*
+	count values of length numerals each, one after the other, with count
+	tweaks of tweakLength bytes (tweaks may be NULL when tweakLength is 0).
+	The values are processed together: the cipher calls of their Feistel
+	rounds share batch calls and the radix conversions run on vectors.
+*/
+CipherStatus FPE_encrypt_many(FpeContext* context, const uint8_t* tweaks, size_t tweakLength,
+							  const uint16_t* in, uint16_t* out, size_t length, size_t count);
+CipherStatus FPE_decrypt_many(FpeContext* context, const uint8_t* tweaks, size_t tweakLength,
+							  const uint16_t* in, uint16_t* out, size_t length, size_t count);
\ No newline at end of file
@@ -0,0 +1,453 @@
+/* GCM.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Implementation of the Galois/Counter Mode (GCM) authenticated
+ * encryption over any 128 bits block cipher of the repository.
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38d.pdf
+ *
+ * and uses other codebases as references:
+ *		- https://github.com/Mbed-TLS/mbedtls/blob/development/library/gcm.c
+ *
+ */
+
+#include <string.h>
+
+#include "GCM.h"
+#include "../PROBES/PROBES.h"
+#include "../STATS/STATS.h"
+
+// number of counter blocks encrypted per batch call
+#define CTR_BATCH 32
+// GHASH streams multiplied together by GCM_ghash_many (multiplyHMany has 4 ways)
+#define GHASH_WAYS 4
+
+// reduction of the 4 bits shifted out of Z in the multiplication by H
+static const uint64_t last4[16] =
+{
+	0x0000, 0x1c20, 0x3840, 0x2460,
+	0x7080, 0x6ca0, 0x48c0, 0x54e0,
+	0xe100, 0xfd20, 0xd940, 0xc560,
+	0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static uint64_t LOAD_64(const uint8_t* p)
+{
+	uint64_t x = 0;
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		x = x << 8 | p[i];
+	}
+
+	return x;
+}
+
+static void STORE_64(uint8_t* p, uint64_t x)
+{
+	int i;
+
+	for (i = 7; i >= 0; i--)
+	{
+		p[i] = (uint8_t)x;
+		x >>= 8;
+	}
+}
+
+// X = X * H in GF(2^128), 4 bits of X at a time
+static void multiplyH(const GcmContext* context, uint8_t* X)
+{
+	uint8_t lo;
+	uint8_t hi;
+	uint8_t rem;
+	uint64_t zh;
+	uint64_t zl;
+	int i;
+
+	lo = X[15] & 0xf;
+	zh = context->HH[lo];
+	zl = context->HL[lo];
+
+	for (i = 15; i >= 0; i--)
+	{
+		lo = X[i] & 0xf;
+		hi = (X[i] >> 4) & 0xf;
+
+		if (i != 15)
+		{
+			rem = (uint8_t)zl & 0xf;
+			zl = (zh << 60) | (zl >> 4);
+			zh = (zh >> 4) ^ (last4[rem] << 48);
+			zh ^= context->HH[lo];
+			zl ^= context->HL[lo];
+		}
+
+		rem = (uint8_t)zl & 0xf;
+		zl = (zh << 60) | (zl >> 4);
+		zh = (zh >> 4) ^ (last4[rem] << 48);
+		zh ^= context->HH[hi];
+		zl ^= context->HL[hi];
+	}
+
+	STORE_64(X, zh);
+	STORE_64(X + 8, zl);
+}
+
+// Z = Z * x^4 + H * nibble, one step of multiplyH
+static inline void shiftNibble(const GcmContext* context, uint64_t* zh, uint64_t* zl, uint8_t nibble)
+{
+	uint8_t rem = (uint8_t)*zl & 0xf;
+
+	*zl = (*zh << 60) | (*zl >> 4);
+	*zh = (*zh >> 4) ^ (last4[rem] << 48);
+	*zh ^= context->HH[nibble];
+	*zl ^= context->HL[nibble];
+}
+
+/*
+	multiplyH of GHASH_WAYS (4) independent values, step by step, so
+	their table lookups and shifts overlap; the ways are separate
+	variables, to stay in registers
+*/
+static void multiplyHMany(const GcmContext* context, uint8_t** X)
+{
+	uint64_t zh0 = context->HH[X[0][15] & 0xf], zl0 = context->HL[X[0][15] & 0xf];
+	uint64_t zh1 = context->HH[X[1][15] & 0xf], zl1 = context->HL[X[1][15] & 0xf];
+	uint64_t zh2 = context->HH[X[2][15] & 0xf], zl2 = context->HL[X[2][15] & 0xf];
+	uint64_t zh3 = context->HH[X[3][15] & 0xf], zl3 = context->HL[X[3][15] & 0xf];
+	int i;
+
+	for (i = 15; i >= 0; i--)
+	{
+		if (i != 15)
+		{
+			shiftNibble(context, &zh0, &zl0, X[0][i] & 0xf);
+			shiftNibble(context, &zh1, &zl1, X[1][i] & 0xf);
+			shiftNibble(context, &zh2, &zl2, X[2][i] & 0xf);
+			shiftNibble(context, &zh3, &zl3, X[3][i] & 0xf);
+		}
+
+		shiftNibble(context, &zh0, &zl0, X[0][i] >> 4);
+		shiftNibble(context, &zh1, &zl1, X[1][i] >> 4);
+		shiftNibble(context, &zh2, &zl2, X[2][i] >> 4);
+		shiftNibble(context, &zh3, &zl3, X[3][i] >> 4);
+	}
+
+	STORE_64(X[0], zh0);
+	STORE_64(X[0] + 8, zl0);
+	STORE_64(X[1], zh1);
+	STORE_64(X[1] + 8, zl1);
+	STORE_64(X[2], zh2);
+	STORE_64(X[2] + 8, zl2);
+	STORE_64(X[3], zh3);
+	STORE_64(X[3] + 8, zl3);
+}
+
+// increments the rightmost 32 bits of the counter block
+static void inc32(uint8_t* counter)
+{
+	int i;
+
+	for (i = 15; i >= 12; i--)
+	{
+		if (++counter[i] != 0)
+		{
+			break;
+		}
+	}
+}
+
+static void gctr(GcmContext* context, uint8_t* counter, const uint8_t* in, uint8_t* out, size_t length)
+{
+	uint8_t keystream[CTR_BATCH * GCM_BLOCK_SIZE];
+	size_t nrBlocks;
+	size_t chunk;
+	size_t i;
+
+	while (length > 0)
+	{
+		nrBlocks = (length + GCM_BLOCK_SIZE - 1) / GCM_BLOCK_SIZE;
+		if (nrBlocks > CTR_BATCH)
+		{
+			nrBlocks = CTR_BATCH;
+		}
+
+		for (i = 0; i < nrBlocks; i++)
+		{
+			memcpy(keystream + i * GCM_BLOCK_SIZE, counter, GCM_BLOCK_SIZE);
+			inc32(counter);
+		}
+		CIPHER_encrypt_blocks(context->cipher, keystream, keystream, nrBlocks);
+
+		chunk = nrBlocks * GCM_BLOCK_SIZE < length ? nrBlocks * GCM_BLOCK_SIZE : length;
+		for (i = 0; i < chunk; i++)
+		{
+			out[i] = in[i] ^ keystream[i];
+		}
+
+		in += chunk;
+		out += chunk;
+		length -= chunk;
+	}
+}
+
+// J0 = IV || 0^31 || 1 for 96 bits nonces, GHASH of the padded nonce otherwise
+void GCM_pre_counter(const GcmContext* context, const uint8_t* nonce, size_t nonceLength, uint8_t* J0)
+{
+	uint8_t lengths[GCM_BLOCK_SIZE] = { 0 };
+
+	if (nonceLength == 12)
+	{
+		memcpy(J0, nonce, 12);
+		J0[12] = 0;
+		J0[13] = 0;
+		J0[14] = 0;
+		J0[15] = 1;
+		return;
+	}
+
+	memset(J0, 0, GCM_BLOCK_SIZE);
+	GCM_ghash(context, J0, nonce, nonceLength);
+	STORE_64(lengths + 8, (uint64_t)nonceLength * 8);
+	GCM_ghash(context, J0, lengths, GCM_BLOCK_SIZE);
+}
+
+static void computeTag(GcmContext* context, const uint8_t* J0,
+					   const uint8_t* aad, size_t aadLength,
+					   const uint8_t* ciphertext, size_t length,
+					   uint8_t* tag)
+{
+	uint8_t S[GCM_BLOCK_SIZE] = { 0 };
+	uint8_t lengths[GCM_BLOCK_SIZE];
+	uint8_t mask[GCM_BLOCK_SIZE];
+	int i;
+
+	GCM_ghash(context, S, aad, aadLength);
+	GCM_ghash(context, S, ciphertext, length);
+	STORE_64(lengths, (uint64_t)aadLength * 8);
+	STORE_64(lengths + 8, (uint64_t)length * 8);
+	GCM_ghash(context, S, lengths, GCM_BLOCK_SIZE);
+
+	CIPHER_encrypt(context->cipher, J0, mask);
+	for (i = 0; i < GCM_BLOCK_SIZE; i++)
+	{
+		tag[i] = S[i] ^ mask[i];
+	}
+}
+
+CipherStatus GCM_init(GcmContext* context, CipherContext* cipher)
+{
+	uint8_t H[GCM_BLOCK_SIZE] = { 0 };
+	uint64_t vh;
+	uint64_t vl;
+	int i;
+	int j;
+
+	if (cipher->cipher->blockSize != GCM_BLOCK_SIZE)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	context->cipher = cipher;
+
+	// hash subkey H = E(K, 0^128)
+	CIPHER_encrypt(cipher, H, H);
+	vh = LOAD_64(H);
+	vl = LOAD_64(H + 8);
+
+	// HL/HH[i] hold H times the 4 bits polynomial i (bit reflected)
+	context->HL[8] = vl;
+	context->HH[8] = vh;
+	context->HL[0] = 0;
+	context->HH[0] = 0;
+
+	for (i = 4; i > 0; i >>= 1)
+	{
+		uint64_t T = (vl & 1) * 0xe1000000;
+		vl = (vh << 63) | (vl >> 1);
+		vh = (vh >> 1) ^ (T << 32);
+		context->HL[i] = vl;
+		context->HH[i] = vh;
+	}
+
+	for (i = 2; i <= 8; i *= 2)
+	{
+		vh = context->HH[i];
+		vl = context->HL[i];
+		for (j = 1; j < i; j++)
+		{
+			context->HH[i + j] = vh ^ context->HH[j];
+			context->HL[i + j] = vl ^ context->HL[j];
+		}
+	}
+
+	return CIPHER_OK;
+}
+
+void GCM_ghash(const GcmContext* context, uint8_t* X, const uint8_t* data, size_t length)
+{
+	size_t chunk;
+	size_t i;
+
+	while (length > 0)
+	{
+		// a partial last block is implicitly padded with zeros
+		chunk = length < GCM_BLOCK_SIZE ? length : GCM_BLOCK_SIZE;
+		for (i = 0; i < chunk; i++)
+		{
+			X[i] ^= data[i];
+		}
+		multiplyH(context, X);
+
+		data += chunk;
+		length -= chunk;
+	}
+}
+
+/*
+	Every stream gets a slot of GHASH_WAYS; a slot whose stream is done
+	takes the next one, so up to GHASH_WAYS blocks are multiplied at once
+	whatever the lengths.
+*/
+void GCM_ghash_many(const GcmContext* context, uint8_t** X, const uint8_t** data, const size_t* lengths, size_t count)
+{
+	uint8_t* slotX[GHASH_WAYS];
+	uint8_t scratch[GCM_BLOCK_SIZE] = { 0 };
+	const uint8_t* slotData[GHASH_WAYS];
+	size_t slotLength[GHASH_WAYS];
+	size_t next = 0;
+	size_t chunk;
+	size_t i;
+	int nrSlots = 0;
+	int s;
+
+	for (;;)
+	{
+		// fill the free slots with the next non-empty streams
+		while (nrSlots < GHASH_WAYS && next < count)
+		{
+			if (lengths[next] > 0)
+			{
+				slotX[nrSlots] = X[next];
+				slotData[nrSlots] = data[next];
+				slotLength[nrSlots] = lengths[next];
+				nrSlots++;
+			}
+			next++;
+		}
+
+		if (nrSlots == 0)
+		{
+			break;
+		}
+
+		for (s = 0; s < nrSlots; s++)
+		{
+			// a partial last block is implicitly padded with zeros
+			chunk = slotLength[s] < GCM_BLOCK_SIZE ? slotLength[s] : GCM_BLOCK_SIZE;
+			for (i = 0; i < chunk; i++)
+			{
+				slotX[s][i] ^= slotData[s][i];
+			}
+			slotData[s] += chunk;
+			slotLength[s] -= chunk;
+		}
+		// free slots multiply a scratch block, so every call has all the ways
+		for (s = nrSlots; s < GHASH_WAYS; s++)
+		{
+			slotX[s] = scratch;
+		}
+		multiplyHMany(context, slotX);
+
+		// drop the finished streams
+		for (s = 0; s < nrSlots; )
+		{
+			if (slotLength[s] == 0)
+			{
+				nrSlots--;
+				slotX[s] = slotX[nrSlots];
+				slotData[s] = slotData[nrSlots];
+				slotLength[s] = slotLength[nrSlots];
+			}
+			else
+			{
+				s++;
+			}
+		}
+	}
+}
+
+CipherStatus GCM_seal(GcmContext* context, const uint8_t* nonce, size_t nonceLength,
+					  const uint8_t* aad, size_t aadLength,
+					  const uint8_t* in, uint8_t* out, size_t length,
+					  uint8_t* tag, size_t tagLength)
+{
+	uint8_t J0[GCM_BLOCK_SIZE];
+	uint8_t counter[GCM_BLOCK_SIZE];
+	uint8_t fullTag[GCM_BLOCK_SIZE];
+
+	if (nonceLength == 0 || tagLength < 4 || tagLength > GCM_TAG_SIZE)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	STATS_MODE(STATS_MODE_GCM, length);
+	PROBE_MODE_ENTRY(STATS_MODE_GCM, context->cipher->cipher->id, length);
+	GCM_pre_counter(context, nonce, nonceLength, J0);
+	memcpy(counter, J0, GCM_BLOCK_SIZE);
+	inc32(counter);
+
+	gctr(context, counter, in, out, length);
+	computeTag(context, J0, aad, aadLength, out, length, fullTag);
+	memcpy(tag, fullTag, tagLength);
+	PROBE_MODE_EXIT(STATS_MODE_GCM, context->cipher->cipher->id, length);
+
+	return CIPHER_OK;
+}
+
+CipherStatus GCM_open(GcmContext* context, const uint8_t* nonce, size_t nonceLength,
+					  const uint8_t* aad, size_t aadLength,
+					  const uint8_t* in, uint8_t* out, size_t length,
+					  const uint8_t* tag, size_t tagLength)
+{
+	uint8_t J0[GCM_BLOCK_SIZE];
+	uint8_t counter[GCM_BLOCK_SIZE];
+	uint8_t expectedTag[GCM_BLOCK_SIZE];
+	uint8_t difference = 0;
+	size_t i;
+
+	if (nonceLength == 0 || tagLength < 4 || tagLength > GCM_TAG_SIZE)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	STATS_MODE(STATS_MODE_GCM, length);
+	PROBE_MODE_ENTRY(STATS_MODE_GCM, context->cipher->cipher->id, length);
+
+	// the tag covers the ciphertext, so it is checked before decrypting
+	GCM_pre_counter(context, nonce, nonceLength, J0);
+	computeTag(context, J0, aad, aadLength, in, length, expectedTag);
+
+	// constant time comparison
+	for (i = 0; i < tagLength; i++)
+	{
+		difference |= expectedTag[i] ^ tag[i];
+	}
+
+	if (difference != 0)
+	{
+		PROBE_MODE_EXIT(STATS_MODE_GCM, context->cipher->cipher->id, length);
+		return CIPHER_ERROR_TAG;
+	}
+
+	memcpy(counter, J0, GCM_BLOCK_SIZE);
+	inc32(counter);
+	gctr(context, counter, in, out, length);
+	PROBE_MODE_EXIT(STATS_MODE_GCM, context->cipher->cipher->id, length);
+
+	return CIPHER_OK;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+/* GCM.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+#define GCM_BLOCK_SIZE 16
+#define GCM_TAG_SIZE 16
+
+typedef struct
+{
+	// 128 bits block cipher, only its encryption direction is used
+	CipherContext* cipher;
+	// multiples of the hash subkey H for the 4-bit GHASH tables
+	uint64_t HL[16];
+	uint64_t HH[16];
+} GcmContext;
+
+CipherStatus GCM_init(GcmContext* context, CipherContext* cipher);
+
+void GCM_ghash(const GcmContext* context, uint8_t* X, const uint8_t* data, size_t length);
+// GCM_ghash of count independent streams (X[i], data[i], lengths[i]), their multiplications interleaved
+void GCM_ghash_many(const GcmContext* context, uint8_t** X, const uint8_t** data, const size_t* lengths, size_t count);
+
+// initial counter block J0 of the nonce
+void GCM_pre_counter(const GcmContext* context, const uint8_t* nonce, size_t nonceLength, uint8_t* J0);
+
+// tagLength from 4 to 16 bytes, in and out may be the same buffer
+CipherStatus GCM_seal(GcmContext* context, const uint8_t* nonce, size_t nonceLength,
+					  const uint8_t* aad, size_t aadLength,
+					  const uint8_t* in, uint8_t* out, size_t length,
+					  uint8_t* tag, size_t tagLength);
+
+// out is only meaningful when CIPHER_OK is returned
+CipherStatus GCM_open(GcmContext* context, const uint8_t* nonce, size_t nonceLength,
+					  const uint8_t* aad, size_t aadLength,
+					  const uint8_t* in, uint8_t* out, size_t length,
+					  const uint8_t* tag, size_t tagLength);
\ No newline at end of file
@@ -15,12 +15,10 @@
  */
 
 #include "GOST.h"
+#include "../PROFILE/PROFILE.h"
 
-uint32_t CM1;
-uint32_t CM2;
-uint32_t N1;
-uint32_t N2;
-uint32_t R;
+// blocks run in lockstep by GOST_encrypt_many
+#define GOST_MANY 8
 
 // S-box used by the Central Bank of Russian Federation
 const uint8_t s_box[8][16] = {
@@ -34,9 +32,15 @@ const uint8_t s_box[8][16] = {
 									{ 1, 15, 13, 0, 5, 7, 10, 4, 9, 2, 3, 14, 6, 11, 8, 12 }
 };
 
-void GOST_round(uint32_t xi)
+/*
+	The cipher state (N1, N2) lives in the caller's stack frame instead of
+	globals, so GOST can be used from several threads at the same time.
+*/
+void GOST_round(uint32_t* N1, uint32_t* N2, uint32_t xi)
 {
-	CM1 = (N1 + xi) % 4294967296; // 2^32
+	uint32_t CM1 = *N1 + xi; // addition modulo 2^32
+	uint32_t CM2;
+	uint32_t R;
 
 	// read entire s-box column according to the CM1 bits
 	uint32_t SN = 0;
@@ -68,29 +72,100 @@ void GOST_round(uint32_t xi)
 	R = (R >> 21) | mask;
 
 	// modulo 2 addition
-	CM2 = R ^ N2;
-	N2 = N1;
-	N1 = CM2;
+	CM2 = R ^ *N2;
+	*N2 = *N1;
+	*N1 = CM2;
+}
+
+#ifdef CIPHER_PROFILE
+#define GOST_round(N1, N2, xi) PROFILE_CALL_VOID(PROFILE_GOST_ROUND, GOST_round(N1, N2, xi))
+#endif
+
+void GOST_sbox_init(GostSbox* sbox, const uint8_t rows[8][16])
+{
+	uint32_t x;
+	uint32_t R;
+	int b;
+
+	for (b = 0; b < 4; b++)
+	{
+		for (x = 0; x < 256; x++)
+		{
+			// nibble n of the input goes through row n
+			R = (uint32_t)(rows[2 * b][x & 0xf] | rows[2 * b + 1][x >> 4] << 4) << (8 * b);
+			sbox->T[b][x] = R << 11 | R >> 21;
+		}
+	}
+}
+
+void GOST_round_sbox(uint32_t* N1, uint32_t* N2, uint32_t xi, const GostSbox* sbox)
+{
+	uint32_t CM1 = *N1 + xi;
+	uint32_t R = sbox->T[0][CM1 & 0xff] ^ sbox->T[1][CM1 >> 8 & 0xff] ^ sbox->T[2][CM1 >> 16 & 0xff] ^ sbox->T[3][CM1 >> 24];
+	uint32_t CM2 = R ^ *N2;
+
+	*N2 = *N1;
+	*N1 = CM2;
+}
+
+/*
+	The blocks run in lockstep, GOST_MANY at a time: round r of every block
+	before round r + 1, so the table lookups of independent blocks overlap.
+*/
+void GOST_encrypt_many(const GostSbox* sbox, const uint32_t* keys, const uint64_t* blocks, uint64_t* out, size_t count)
+{
+	uint32_t N1[GOST_MANY];
+	uint32_t N2[GOST_MANY];
+	size_t n;
+	size_t i;
+	int k;
+	int r;
+
+	for (; count > 0; count -= n, keys += 8 * n, blocks += n, out += n)
+	{
+		n = count < GOST_MANY ? count : GOST_MANY;
+
+		for (i = 0; i < n; i++)
+		{
+			N1[i] = (uint32_t)blocks[i];
+			N2[i] = blocks[i] >> 32;
+		}
+
+		// keys 0 .. 7 three times, then 7 .. 0
+		for (r = 0; r < 32; r++)
+		{
+			k = r < 24 ? r % 8 : 31 - r;
+			for (i = 0; i < n; i++)
+			{
+				GOST_round_sbox(&N1[i], &N2[i], keys[8 * i + k], sbox);
+			}
+		}
+
+		for (i = 0; i < n; i++)
+		{
+			out[i] = (uint64_t)N1[i] << 32 | N2[i];
+		}
+	}
 }
 
 uint64_t GOST_encrypt(uint64_t block, uint32_t* key)
 {
-	N1 = (uint32_t)block;
-	N2 = block >> 32;
+	uint32_t N1 = (uint32_t)block;
+	uint32_t N2 = block >> 32;
 
 	// first 24 rounds
 	for (int k = 0; k < 3; k++)
 	{
 		for (int i = 0; i <= 7; i++)
 		{
-			GOST_round(key[i]);
+			GOST_round(&N1, &N2, key[i]);
 		}
 	}
 
 	// last 8 rounds
 	for (int i = 7; i >= 0; i--)
 	{
-		GOST_round(key[i]);
+		GOST_round(&N1, &N2, key[i]);
 	}
 
 	uint64_t tc = N1;
@@ -100,13 +175,13 @@ uint64_t GOST_encrypt(uint64_t block, uint32_t* key)
 
 uint64_t GOST_decrypt(uint64_t encryptedBlock, uint32_t* key)
 {
-	N1 = (uint32_t)encryptedBlock;
-	N2 = encryptedBlock >> 32;
+	uint32_t N1 = (uint32_t)encryptedBlock;
+	uint32_t N2 = encryptedBlock >> 32;
 
 	// last 8 rounds
 	for (int i = 0; i <= 7; i++)
 	{
-		GOST_round(key[i]);
+		GOST_round(&N1, &N2, key[i]);
 	}
 
 	// first 24 rounds
@@ -114,7 +189,7 @@ uint64_t GOST_decrypt(uint64_t encryptedBlock, uint32_t* key)
 	{
 		for (int i = 7; i >= 0; i--)
 		{
-			GOST_round(key[i]);
+			GOST_round(&N1, &N2, key[i]);
 		}
 	}
 
@@ -123,6 +198,18 @@ uint64_t GOST_decrypt(uint64_t encryptedBlock, uint32_t* key)
 	return tc;
 }
 
+// GOST_round reads the 8 rows of s_box, returns the size of the table or 0 past the last one
+size_t GOST_lookup_table(int index, const void** address)
+{
+	if (index != 0)
+	{
+		return 0;
+	}
+
+	*address = s_box;
+	return sizeof(s_box);
+}
+
 void GOST_main(void)
 {
 	uint32_t key[8];
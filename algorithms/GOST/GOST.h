@@ -10,7 +10,25 @@
 #include <stdio.h>
 #include <stdint.h>
 
+/*
+	S-box set expanded for a round with four lookups: T[b][x] is byte b of
+	the round input, with value x, through its two rows, shifted to its
+	place and rotated by 11.
+*/
+typedef struct
+{
+	uint32_t T[4][256];
+} GostSbox;
+
+void GOST_round(uint32_t* N1, uint32_t* N2, uint32_t xi);
+// rows K1 .. K8 of the standard: row n substitutes bits 4n .. 4n + 3 (s_box lists them the other way)
+void GOST_sbox_init(GostSbox* sbox, const uint8_t rows[8][16]);
+// GOST_round with the S-box set of sbox
+void GOST_round_sbox(uint32_t* N1, uint32_t* N2, uint32_t xi, const GostSbox* sbox);
+// count blocks, block i encrypted under the 8 words of keys + 8 * i, as GOST_encrypt
+void GOST_encrypt_many(const GostSbox* sbox, const uint32_t* keys, const uint64_t* blocks, uint64_t* out, size_t count);
 uint64_t GOST_encrypt(uint64_t block, uint32_t* key);
 uint64_t GOST_decrypt(uint64_t encryptedBlock, uint32_t* key);
+size_t GOST_lookup_table(int index, const void** address);
 
 void GOST_main(void);
\ No newline at end of file
@@ -0,0 +1,292 @@
+/* GOST94.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * GOST R 34.11-94 hash function over the GOST block cipher.
+ *
+ * This code follows a specification:
+ *		- RFC 5831 (GOST R 34.11-94)
+ *		- RFC 4357, section 11.2 (CryptoPro parameter set)
+ *
+ * The 256 bits values are kept as four 64 bits little-endian words, word
+ * 0 the least significant, so the transforms of the key generation run on
+ * whole words: A is a rotation of the words with one xor, P a byte
+ * transpose that builds each 32 bits key word from byte k of the four
+ * words, and psi a 16 bits shift of the four words. The four encryptions
+ * of a step are independent, so they go through one GOST_encrypt_many
+ * call, in lockstep, with the S-box set expanded once per parameter set.
+ *
+ */
+
+#include <string.h>
+#include <pthread.h>
+
+#include "GOST94.h"
+
+// S-box sets, K1 (low 4 bits) to K8
+static const uint8_t sboxRows[GOST94_PARAMS_COUNT][8][16] =
+{
+	{
+		{ 4, 10, 9, 2, 13, 8, 0, 14, 6, 11, 1, 12, 7, 15, 5, 3 },
+		{ 14, 11, 4, 12, 6, 13, 15, 10, 2, 3, 8, 1, 0, 7, 5, 9 },
+		{ 5, 8, 1, 13, 10, 3, 4, 2, 14, 15, 12, 7, 6, 0, 9, 11 },
+		{ 7, 13, 10, 1, 0, 8, 9, 15, 14, 4, 6, 12, 11, 2, 5, 3 },
+		{ 6, 12, 7, 1, 5, 15, 13, 8, 4, 10, 9, 14, 0, 3, 11, 2 },
+		{ 4, 11, 10, 0, 7, 2, 1, 13, 3, 6, 8, 5, 9, 12, 15, 14 },
+		{ 13, 11, 4, 1, 3, 15, 5, 9, 0, 10, 14, 7, 6, 8, 2, 12 },
+		{ 1, 15, 13, 0, 5, 7, 10, 4, 9, 2, 3, 14, 6, 11, 8, 12 }
+	},
+	{
+		{ 10, 4, 5, 6, 8, 1, 3, 7, 13, 12, 14, 0, 9, 2, 11, 15 },
+		{ 5, 15, 4, 0, 2, 13, 11, 9, 1, 7, 6, 3, 12, 14, 10, 8 },
+		{ 7, 15, 12, 14, 9, 4, 1, 0, 3, 11, 5, 2, 6, 10, 8, 13 },
+		{ 4, 10, 7, 12, 0, 15, 2, 8, 14, 1, 6, 5, 13, 11, 9, 3 },
+		{ 7, 6, 4, 11, 9, 12, 2, 10, 1, 8, 0, 14, 15, 13, 3, 5 },
+		{ 7, 6, 2, 4, 13, 9, 15, 0, 10, 1, 5, 11, 8, 14, 12, 3 },
+		{ 13, 14, 4, 1, 7, 0, 5, 10, 3, 12, 8, 15, 6, 2, 9, 11 },
+		{ 1, 3, 10, 9, 5, 11, 4, 15, 8, 6, 7, 14, 13, 0, 2, 12 }
+	}
+};
+
+// C3 of the key generation (C2 and C4 are zero)
+static const uint64_t C3[4] = { 0xff00ff00ff00ff00, 0x00ff00ff00ff00ff, 0xff0000ff00ffff00, 0xff00ffff000000ff };
+
+static const char* names[GOST94_PARAMS_COUNT] = { "TEST", "CRYPTOPRO" };
+
+static GostSbox sboxes[GOST94_PARAMS_COUNT];
+static pthread_once_t sboxesOnce = PTHREAD_ONCE_INIT;
+
+static void expandSboxes(void)
+{
+	int p;
+
+	for (p = 0; p < GOST94_PARAMS_COUNT; p++)
+	{
+		GOST_sbox_init(&sboxes[p], sboxRows[p]);
+	}
+}
+
+static uint64_t load64(const uint8_t* p)
+{
+	uint64_t x = 0;
+	int i;
+
+	for (i = 7; i >= 0; i--)
+	{
+		x = x << 8 | p[i];
+	}
+
+	return x;
+}
+
+static void store64(uint8_t* p, uint64_t x)
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+	{
+		p[i] = (uint8_t)(x >> (8 * i));
+	}
+}
+
+// A(y4 || y3 || y2 || y1) = (y1 ^ y2) || y4 || y3 || y2
+static void transformA(uint64_t* y)
+{
+	uint64_t y1 = y[0];
+
+	y[0] = y[1];
+	y[1] = y[2];
+	y[2] = y[3];
+	y[3] = y1 ^ y[0];
+}
+
+// P: byte i of key word k is byte k of word i
+static void transformP(const uint64_t* y, uint32_t* key)
+{
+	int k;
+
+	for (k = 0; k < 8; k++)
+	{
+		key[k] = (uint32_t)(y[0] >> (8 * k) & 0xff)
+			| (uint32_t)(y[1] >> (8 * k) & 0xff) << 8
+			| (uint32_t)(y[2] >> (8 * k) & 0xff) << 16
+			| (uint32_t)(y[3] >> (8 * k) & 0xff) << 24;
+	}
+}
+
+// psi applied n times: shift right by 16 bits, y1 ^ y2 ^ y3 ^ y4 ^ y13 ^ y16 on top
+static void transformPsi(uint64_t* y, int n)
+{
+	uint64_t t;
+
+	for (; n > 0; n--)
+	{
+		t = (y[0] ^ y[0] >> 16 ^ y[0] >> 32 ^ y[0] >> 48 ^ y[3] ^ y[3] >> 48) & 0xffff;
+		y[0] = y[0] >> 16 | y[1] << 48;
+		y[1] = y[1] >> 16 | y[2] << 48;
+		y[2] = y[2] >> 16 | y[3] << 48;
+		y[3] = y[3] >> 16 | t << 48;
+	}
+}
+
+static void step(const GostSbox* sbox, uint64_t* hash, const uint64_t* m)
+{
+	uint64_t u[4];
+	uint64_t v[4];
+	uint64_t w[4];
+	uint64_t s[4];
+	uint32_t keys[32];
+	int j;
+	int i;
+
+	memcpy(u, hash, sizeof(u));
+	memcpy(v, m, sizeof(v));
+
+	for (j = 0; j < 4; j++)
+	{
+		if (j > 0)
+		{
+			transformA(u);
+			transformA(v);
+			transformA(v);
+		}
+		if (j == 2)
+		{
+			for (i = 0; i < 4; i++)
+			{
+				u[i] ^= C3[i];
+			}
+		}
+
+		for (i = 0; i < 4; i++)
+		{
+			w[i] = u[i] ^ v[i];
+		}
+		transformP(w, keys + 8 * j);
+	}
+
+	// s_j = E_Kj(h_j), the four in one call
+	GOST_encrypt_many(sbox, keys, hash, s, 4);
+
+	// psi^61(H ^ psi(M ^ psi^12(S)))
+	transformPsi(s, 12);
+	for (i = 0; i < 4; i++)
+	{
+		s[i] ^= m[i];
+	}
+	transformPsi(s, 1);
+	for (i = 0; i < 4; i++)
+	{
+		s[i] ^= hash[i];
+	}
+	transformPsi(s, 61);
+
+	memcpy(hash, s, sizeof(s));
+}
+
+static void addSum(uint64_t* sum, const uint64_t* m)
+{
+	uint64_t carry = 0;
+	uint64_t x;
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		x = sum[i] + carry;
+		carry = x < carry;
+		sum[i] = x + m[i];
+		carry += sum[i] < x;
+	}
+}
+
+static void processBlock(Gost94Context* context, const uint8_t* block)
+{
+	uint64_t m[4];
+	int i;
+
+	for (i = 0; i < 4; i++)
+	{
+		m[i] = load64(block + 8 * i);
+	}
+
+	step(context->sbox, context->hash, m);
+	addSum(context->sum, m);
+}
+
+const char* GOST94_name(Gost94Params params)
+{
+	return (unsigned)params < GOST94_PARAMS_COUNT ? names[params] : NULL;
+}
+
+CipherStatus GOST94_init(Gost94Context* context, Gost94Params params)
+{
+	if ((unsigned)params >= GOST94_PARAMS_COUNT)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	pthread_once(&sboxesOnce, expandSboxes);
+
+	memset(context, 0, sizeof(Gost94Context));
+	context->sbox = &sboxes[params];
+
+	return CIPHER_OK;
+}
+
+void GOST94_update(Gost94Context* context, const uint8_t* data, size_t length)
+{
+	size_t n;
+
+	context->length += length;
+
+	if (context->bufferLength > 0)
+	{
+		n = GOST94_BLOCK_SIZE - context->bufferLength;
+		n = length < n ? length : n;
+		memcpy(context->buffer + context->bufferLength, data, n);
+		context->bufferLength += n;
+		data += n;
+		length -= n;
+
+		if (context->bufferLength < GOST94_BLOCK_SIZE)
+		{
+			return;
+		}
+		processBlock(context, context->buffer);
+		context->bufferLength = 0;
+	}
+
+	for (; length >= GOST94_BLOCK_SIZE; data += GOST94_BLOCK_SIZE, length -= GOST94_BLOCK_SIZE)
+	{
+		processBlock(context, data);
+	}
+
+	memcpy(context->buffer, data, length);
+	context->bufferLength = length;
+}
+
+void GOST94_final(Gost94Context* context, uint8_t* digest)
+{
+	uint64_t length[4] = { 0 };
+	int i;
+
+	// the last partial block is padded with zeros, an empty one is skipped
+	if (context->bufferLength > 0)
+	{
+		memset(context->buffer + context->bufferLength, 0, GOST94_BLOCK_SIZE - context->bufferLength);
+		processBlock(context, context->buffer);
+	}
+
+	length[0] = context->length << 3;
+	length[1] = context->length >> 61;
+	step(context->sbox, context->hash, length);
+	step(context->sbox, context->hash, context->sum);
+
+	for (i = 0; i < 4; i++)
+	{
+		store64(digest + 8 * i, context->hash[i]);
+	}
+
+	memset(context, 0, sizeof(Gost94Context));
+}
\ No newline at end of file
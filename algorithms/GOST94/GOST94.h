@@ -0,0 +1,45 @@
+/* GOST94.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+#include "../GOST/GOST.h"
+
+#define GOST94_BLOCK_SIZE 32
+#define GOST94_DIGEST_SIZE 32
+
+typedef enum
+{
+	// test parameter set of the standard (the rows of s_box in GOST, reversed)
+	GOST94_TEST_PARAMS = 0,
+	// id-GostR3411-94-CryptoProParamSet
+	GOST94_CRYPTOPRO_PARAMS,
+	GOST94_PARAMS_COUNT
+} Gost94Params;
+
+typedef struct
+{
+	const GostSbox* sbox;
+	uint64_t hash[4];
+	// sum of the message blocks modulo 2^256
+	uint64_t sum[4];
+	uint64_t length;
+	uint8_t buffer[GOST94_BLOCK_SIZE];
+	size_t bufferLength;
+} Gost94Context;
+
+const char* GOST94_name(Gost94Params params);
+
+// CIPHER_ERROR_ID for an unknown parameter set
+CipherStatus GOST94_init(Gost94Context* context, Gost94Params params);
+void GOST94_update(Gost94Context* context, const uint8_t* data, size_t length);
+void GOST94_final(Gost94Context* context, uint8_t* digest);
\ No newline at end of file
@@ -198,6 +198,168 @@ void HIGHT_decrypt(HightContext* context, uint8_t* block, uint8_t* out)
 	out[7] = x[7];
 }
 
+#ifdef SIMD_AVAILABLE
+static SimdU8 f0Lanes(SimdU8 x)
+{
+	return SIMD_rol8(x, 1) ^ SIMD_rol8(x, 2) ^ SIMD_rol8(x, 7);
+}
+
+static SimdU8 f1Lanes(SimdU8 x)
+{
+	return SIMD_rol8(x, 3) ^ SIMD_rol8(x, 4) ^ SIMD_rol8(x, 6);
+}
+
+void HIGHT_encrypt_lanes(const HightContext* context, SimdU8* x)
+{
+	const uint8_t* subkeys = context->subkeys;
+	SimdU8 y[8];
+	SimdU8 temp6;
+	SimdU8 temp7;
+	int r;
+
+	// Initial Transformation
+	y[0] = x[0] + context->whiteningKeys[0];
+	y[1] = x[1];
+	y[2] = x[2] ^ context->whiteningKeys[1];
+	y[3] = x[3];
+	y[4] = x[4] + context->whiteningKeys[2];
+	y[5] = x[5];
+	y[6] = x[6] ^ context->whiteningKeys[3];
+	y[7] = x[7];
+
+	// Rounds
+	for (r = 0; r < NR_ROUNDS; r++)
+	{
+		temp6 = y[6];
+		temp7 = y[7];
+
+		y[7] = y[6];
+		y[6] = y[5] + (f1Lanes(y[4]) ^ subkeys[2]);
+		y[5] = y[4];
+		y[4] = y[3] ^ (f0Lanes(y[2]) + subkeys[1]);
+		y[3] = y[2];
+		y[2] = y[1] + (f1Lanes(y[0]) ^ subkeys[0]);
+		y[1] = y[0];
+		y[0] = temp7 ^ (f0Lanes(temp6) + subkeys[3]);
+		subkeys += 4;
+	}
+
+	// Final Transformation
+	x[0] = y[1] + context->whiteningKeys[4];
+	x[1] = y[2];
+	x[2] = y[3] ^ context->whiteningKeys[5];
+	x[3] = y[4];
+	x[4] = y[5] + context->whiteningKeys[6];
+	x[5] = y[6];
+	x[6] = y[7] ^ context->whiteningKeys[7];
+	x[7] = y[0];
+}
+
+void HIGHT_decrypt_lanes(const HightContext* context, SimdU8* x)
+{
+	const uint8_t* subkeys = context->subkeys + 127;
+	SimdU8 y[8];
+	SimdU8 temp;
+	int r;
+
+	// Final Inverse Transformation
+	y[7] = x[6] ^ context->whiteningKeys[7];
+	y[6] = x[5];
+	y[5] = x[4] - context->whiteningKeys[6];
+	y[4] = x[3];
+	y[3] = x[2] ^ context->whiteningKeys[5];
+	y[2] = x[1];
+	y[1] = x[0] - context->whiteningKeys[4];
+	y[0] = x[7];
+
+	// Rounds
+	for (r = 0; r < NR_ROUNDS; r++)
+	{
+		temp = y[0];
+
+		y[0] = y[1];
+		y[1] = y[2] - (f1Lanes(y[0]) ^ subkeys[-3]);
+		y[2] = y[3];
+		y[3] = y[4] ^ (f0Lanes(y[2]) + subkeys[-2]);
+		y[4] = y[5];
+		y[5] = y[6] - (f1Lanes(y[4]) ^ subkeys[-1]);
+		y[6] = y[7];
+		y[7] = temp ^ (f0Lanes(y[6]) + subkeys[0]);
+		subkeys -= 4;
+	}
+
+	// Initial Inverse Transformation
+	x[0] = y[0] - context->whiteningKeys[0];
+	x[1] = y[1];
+	x[2] = y[2] ^ context->whiteningKeys[1];
+	x[3] = y[3];
+	x[4] = y[4] - context->whiteningKeys[2];
+	x[5] = y[5];
+	x[6] = y[6] ^ context->whiteningKeys[3];
+	x[7] = y[7];
+}
+/*
+	count key schedules, SIMD_BYTES / 16 keys per vector with each key in
+	16 lanes: the 16 subkeys of round i of HIGHT_init are a byte shuffle of
+	the key plus 16 bytes of DELTA, copied to the context as they are.
+*/
+void HIGHT_init_many(HightContext** contexts, const uint8_t* keys, size_t count)
+{
+	const size_t keysPerVector = SIMD_BYTES / 16;
+	SimdU8 indices[8];
+	SimdU8 delta[8];
+	SimdU8 k;
+	SimdU8 subkeys;
+	size_t n;
+	size_t l;
+	int i;
+	int j;
+
+	for (i = 0; i < 8; i++)
+	{
+		for (j = 0; j < SIMD_BYTES; j++)
+		{
+			indices[i][j] = (uint8_t)((j & ~15) + ((j - i + 8) & 7) + (j & 8));
+			delta[i][j] = DELTA[16 * i + (j & 15)];
+		}
+	}
+
+	for (; count > 0; count -= n, contexts += n, keys += n * 16)
+	{
+		n = count < keysPerVector ? count : keysPerVector;
+		memset(&k, 0, sizeof(k));
+		memcpy(&k, keys, n * 16);
+
+		for (l = 0; l < n; l++)
+		{
+			memcpy(contexts[l]->whiteningKeys, keys + 16 * l + 12, 4);
+			memcpy(contexts[l]->whiteningKeys + 4, keys + 16 * l, 4);
+		}
+
+		for (i = 0; i < 8; i++)
+		{
+			subkeys = SIMD_shuffle8(k, indices[i]) + delta[i];
+			for (l = 0; l < n; l++)
+			{
+				memcpy(contexts[l]->subkeys + 16 * i, (uint8_t*)&subkeys + 16 * l, 16);
+			}
+		}
+	}
+}
+#else
+void HIGHT_init_many(HightContext** contexts, const uint8_t* keys, size_t count)
+{
+	uint8_t key[16];
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		memcpy(key, keys + 16 * i, sizeof(key));
+		HIGHT_init(contexts[i], key);
+	}
+}
+#endif
+
 void HIGHT_main(void)
 {
 	HightContext context;
@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include "../SIMD/SIMD.h"
+
 typedef struct
 {
 	uint8_t whiteningKeys[8];
@@ -19,5 +21,13 @@ typedef struct
 void HIGHT_init(HightContext* context, uint8_t* key);
 void HIGHT_encrypt(HightContext* context, uint8_t* block, uint8_t* out);
 void HIGHT_decrypt(HightContext* context, uint8_t* block, uint8_t* out);
+// count keys of 16 bytes one after the other, same as HIGHT_init on each
+void HIGHT_init_many(HightContext** contexts, const uint8_t* keys, size_t count);
+
+#ifdef SIMD_AVAILABLE
+// SIMD_LANES_8 blocks at once, byte j of every block in x[j]
+void HIGHT_encrypt_lanes(const HightContext* context, SimdU8* x);
+void HIGHT_decrypt_lanes(const HightContext* context, SimdU8* x);
+#endif
 
 void HIGHT_main(void);
\ No newline at end of file
@@ -16,6 +16,7 @@
  */
 
 #include "IDEA.h"
+#include "../PROFILE/PROFILE.h"
 
 #define NR_ROUNDS 8
 #define ENCRYPTION_KEY_LEN 6 * NR_ROUNDS + 4 // 52 subkeys
@@ -38,6 +39,10 @@ static uint16_t mul(uint16_t a, uint16_t b)
 	return (uint16_t)p;
 }
 
+#ifdef CIPHER_PROFILE
+#define mul(a, b) PROFILE_CALL(PROFILE_IDEA_MUL, mul(a, b))
+#endif
+
 /*
 * Euclidean multiplicative mod 65537 inverse algorithm
 */
@@ -99,17 +104,30 @@ static void generateEncryptionKeys(uint16_t* key, uint16_t Z[52])
 	}
 }
 
-static void generateDecryptionKeys(uint16_t* key, uint16_t Z[52])
+// inv() of the multiplicative subkeys, every third one
+static void invertKeys(const uint16_t* key, uint16_t inverses[52])
+{
+	int i;
+
+	for (i = 0; i < ENCRYPTION_KEY_LEN; i += 3)
+	{
+		inverses[i] = inv(key[i]);
+	}
+}
+
+// inverses[i] is inv(key[i]) for the multiplicative subkeys (see invertKeys)
+static void generateDecryptionKeys(uint16_t* key, const uint16_t* inverses, uint16_t Z[52])
 {
 	int i;
 	uint16_t t1, t2, t3;
 	uint16_t temp[ENCRYPTION_KEY_LEN];
 	uint16_t* p = temp + ENCRYPTION_KEY_LEN;
+	const uint16_t* first = key;
 
-	t1 = inv(*key++);
+	t1 = inverses[key++ - first];
 	t2 = -*key++;
 	t3 = -*key++;
-	*--p = inv(*key++);
+	*--p = inverses[key++ - first];
 	*--p = t3;
 	*--p = t2;
 	*--p = t1;
@@ -120,10 +138,10 @@ static void generateDecryptionKeys(uint16_t* key, uint16_t Z[52])
 		*--p = *key++;
 		*--p = t1;
 
-		t1 = inv(*key++);
+		t1 = inverses[key++ - first];
 		t2 = -*key++;
 		t3 = -*key++;
-		*--p = inv(*key++);
+		*--p = inverses[key++ - first];
 		*--p = t2;
 		*--p = t3;
 		*--p = t1;
@@ -132,10 +150,10 @@ static void generateDecryptionKeys(uint16_t* key, uint16_t Z[52])
 	*--p = *key++;
 	*--p = t1;
 
-	t1 = inv(*key++);
+	t1 = inverses[key++ - first];
 	t2 = -*key++;
 	t3 = -*key++;
-	*--p = inv(*key++);
+	*--p = inverses[key++ - first];
 	*--p = t3;
 	*--p = t2;
 	*--p = t1;
@@ -183,10 +201,167 @@ static void idea(uint16_t* block, uint16_t* Z, uint16_t* out)
 	out[3] = mul(*Z++, x3);
 }
 
+#ifdef SIMD_AVAILABLE
+/*
+	mul() without branches, on 16 bits values in 32 bits lanes so the
+	full product fits. A zero operand (2^16) makes the product zero, and
+	then the result is 1 - a - b modulo 2^16.
+*/
+static SimdU32 mulVectors(SimdU32 a, SimdU32 b)
+{
+	SimdU32 p = a * b;
+	SimdU32 lo = p & 0xffff;
+	SimdU32 hi = p >> 16;
+	SimdU32 r = lo - hi + ((SimdU32)(lo < hi) & 1);
+
+	return SIMD_select32((SimdU32)(p == 0), 1 - a - b, r) & 0xffff;
+}
+
+static SimdU32 mulLanes(SimdU32 a, uint32_t b)
+{
+	return mulVectors(a, a * 0 + b);
+}
+
+#if SIMD_LANES_32 >= 8
+/*
+	inv() without branches: the nonzero values modulo 65537 (0 standing
+	for 2^16, as in mul()) are a group of order 65536, so the inverse of
+	x is x^65535, 15 squarings and products. The count vectors of x are
+	raised in lockstep, their products are independent.
+*/
+static void invLanes(SimdU32* x, int count)
+{
+	SimdU32 r[18];
+	int i;
+	int j;
+
+	for (j = 0; j < count; j++)
+	{
+		r[j] = x[j];
+	}
+
+	for (i = 0; i < 15; i++)
+	{
+		for (j = 0; j < count; j++)
+		{
+			r[j] = mulVectors(mulVectors(r[j], r[j]), x[j]);
+		}
+	}
+
+	for (j = 0; j < count; j++)
+	{
+		x[j] = r[j];
+	}
+}
+#endif
+
+static void ideaLanes(SimdU32* x, const uint16_t* Z)
+{
+	SimdU32 x0 = x[0];
+	SimdU32 x1 = x[1];
+	SimdU32 x2 = x[2];
+	SimdU32 x3 = x[3];
+	SimdU32 a;
+	SimdU32 b;
+	int i;
+
+	for (i = 1; i <= NR_ROUNDS; i++)
+	{
+		x0 = mulLanes(x0, *Z++);
+		x1 = (x1 + *Z++) & 0xffff;
+		x2 = (x2 + *Z++) & 0xffff;
+		x3 = mulLanes(x3, *Z++);
+
+		b = mulLanes(x0 ^ x2, *Z++);
+		a = mulLanes((b + (x1 ^ x3)) & 0xffff, *Z++);
+		b = (b + a) & 0xffff;
+
+		x0 = a ^ x0;
+		x3 = b ^ x3;
+		b ^= x1;
+		x1 = a ^ x2;
+		x2 = b;
+	}
+
+	x[0] = mulLanes(x0, *Z++);
+	x[1] = (*Z++ + x2) & 0xffff;
+	x[2] = (*Z++ + x1) & 0xffff;
+	x[3] = mulLanes(x3, *Z++);
+}
+#endif
+
 void IDEA_init(IdeaContext* context, uint16_t* key)
+{
+	uint16_t inverses[ENCRYPTION_KEY_LEN];
+
+	generateEncryptionKeys(key, context->encryptionKeys);
+	invertKeys(context->encryptionKeys, inverses);
+	generateDecryptionKeys(context->encryptionKeys, inverses, context->decryptionKeys);
+}
+
+/*
+	count key schedules. From 8 lanes, the 18 inversions of each
+	decryption schedule, the bulk of the cost, are done SIMD_LANES_32 keys
+	at a time with invLanes instead of the divisions of inv() (narrower
+	vectors are slower than inv()).
+*/
+void IDEA_init_many(IdeaContext** contexts, const uint16_t* keys, size_t count)
+{
+#if defined(SIMD_AVAILABLE) && SIMD_LANES_32 >= 8
+	uint16_t inverses[SIMD_LANES_32][ENCRYPTION_KEY_LEN];
+	SimdU32 x[18];
+	size_t n;
+	size_t l;
+	int i;
+
+	for (; count > 0; count -= n, contexts += n, keys += n * 8)
+	{
+		n = count < SIMD_LANES_32 ? count : SIMD_LANES_32;
+
+		for (l = 0; l < n; l++)
+		{
+			generateEncryptionKeys((uint16_t*)keys + l * 8, contexts[l]->encryptionKeys);
+		}
+
+		for (i = 0; i < ENCRYPTION_KEY_LEN; i += 3)
+		{
+			for (l = 0; l < SIMD_LANES_32; l++)
+			{
+				x[i / 3][l] = l < n ? contexts[l]->encryptionKeys[i] : 1;
+			}
+		}
+
+		invLanes(x, 18);
+		for (i = 0; i < ENCRYPTION_KEY_LEN; i += 3)
+		{
+			for (l = 0; l < n; l++)
+			{
+				inverses[l][i] = (uint16_t)x[i / 3][l];
+			}
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			generateDecryptionKeys(contexts[l]->encryptionKeys, inverses[l], contexts[l]->decryptionKeys);
+		}
+	}
+#else
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		IDEA_init(contexts[i], (uint16_t*)keys + i * 8);
+	}
+#endif
+}
+
+/*
+	Expands only the encryption subkeys, skipping the inv() calls of the
+	decryption schedule. IDEA_decrypt must not be used with this context.
+*/
+void IDEA_init_encrypt(IdeaContext* context, uint16_t* key)
 {
 	generateEncryptionKeys(key, context->encryptionKeys);
-	generateDecryptionKeys(context->encryptionKeys, context->decryptionKeys);
 }
 
 void IDEA_encrypt(IdeaContext* context, uint16_t* block, uint16_t* out)
@@ -199,6 +374,18 @@ void IDEA_decrypt(IdeaContext* context, uint16_t* encryptedBlock, uint16_t* out)
 	idea(encryptedBlock, context->decryptionKeys, out);
 }
 
+#ifdef SIMD_AVAILABLE
+void IDEA_encrypt_lanes(const IdeaContext* context, SimdU32* x)
+{
+	ideaLanes(x, context->encryptionKeys);
+}
+
+void IDEA_decrypt_lanes(const IdeaContext* context, SimdU32* x)
+{
+	ideaLanes(x, context->decryptionKeys);
+}
+#endif
+
 void IDEA_main(void)
 {
 	IdeaContext context;
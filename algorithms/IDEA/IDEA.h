@@ -11,6 +11,8 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "../SIMD/SIMD.h"
+
 typedef struct
 {
 	uint16_t encryptionKeys[52];
@@ -18,7 +20,16 @@ typedef struct
 } IdeaContext;
 
 void IDEA_init(IdeaContext* context, uint16_t* key);
+void IDEA_init_encrypt(IdeaContext* context, uint16_t* key);
+// count keys of 8 words one after the other, same as IDEA_init on each
+void IDEA_init_many(IdeaContext** contexts, const uint16_t* keys, size_t count);
 void IDEA_encrypt(IdeaContext* context, uint16_t* block, uint16_t* out);
 void IDEA_decrypt(IdeaContext* context, uint16_t* encryptedBlock, uint16_t* out);
 
+#ifdef SIMD_AVAILABLE
+// SIMD_LANES_32 blocks at once, 16 bits word j of every block in the 32 bits lanes of x[j]
+void IDEA_encrypt_lanes(const IdeaContext* context, SimdU32* x);
+void IDEA_decrypt_lanes(const IdeaContext* context, SimdU32* x);
+#endif
+
 void IDEA_main(void);
\ No newline at end of file
@@ -0,0 +1,248 @@
+/* IOVEC.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Scatter-gather encryption of chains of segments (network buffers, log
+ * fragments) with the modes of MODES, without linearizing them. Both
+ * chains are walked together:
+ *		- where the current input and output segments both have at least
+ *		  one block left, their common interior goes straight through the
+ *		  span functions of MODES (bulk path included, by the length of
+ *		  the whole chain), in place in the caller's buffers
+ *		- a block that straddles a segment boundary (of either chain), or
+ *		  the partial last block of CTR, is gathered into a one block
+ *		  staging buffer, processed there and scattered back
+ *
+ * CBC decryption stays here: MODES_cbc_decrypt goes block by block, while
+ * a span of it is parallel and runs as batch calls.
+ *
+ */
+
+#include <string.h>
+
+#include "IOVEC.h"
+#include "../PROBES/PROBES.h"
+#include "../STATS/STATS.h"
+
+// blocks per batch call of in place CBC decryption
+#define CBC_BATCH 64
+
+// contiguous processing of whole blocks (any length for CTR), iv as in IOVEC_encrypt, bulk as in MODES
+typedef void (*SpanFunction)(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length, int bulk);
+
+// position in a chain
+typedef struct
+{
+	const IoVector* vectors;
+	size_t count;
+	size_t index;
+	size_t offset;
+} Cursor;
+
+static const StatsMode statsModes[MODE_COUNT] = { STATS_MODE_ECB, STATS_MODE_CBC, STATS_MODE_CTR };
+
+static void ecbEncrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length, int bulk)
+{
+	(void)iv;
+	MODES_ecb_span(context, in, out, length, 0, bulk);
+}
+
+static void ecbDecrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length, int bulk)
+{
+	(void)iv;
+	MODES_ecb_span(context, in, out, length, 1, bulk);
+}
+
+static void cbcEncrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length, int bulk)
+{
+	(void)bulk;
+	MODES_cbc_encrypt_span(context, iv, in, out, length);
+}
+
+// CBC decryption is parallel: a batch call, then the XOR with the previous ciphertext blocks
+static void cbcDecrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length, int bulk)
+{
+	size_t blockSize = context->cipher->blockSize;
+	uint8_t saved[CBC_BATCH * CIPHER_MAX_BLOCK_SIZE];
+	const uint8_t* ciphertext;
+	size_t chunk;
+	size_t i;
+
+	(void)bulk;
+	while (length > 0)
+	{
+		chunk = length < CBC_BATCH * blockSize ? length : CBC_BATCH * blockSize;
+
+		// in place, the ciphertext is kept for the chaining
+		ciphertext = in;
+		if (in == out)
+		{
+			memcpy(saved, in, chunk);
+			ciphertext = saved;
+		}
+
+		CIPHER_decrypt_blocks(context, ciphertext, out, chunk / blockSize);
+		for (i = 0; i < blockSize; i++)
+		{
+			out[i] ^= iv[i];
+		}
+		for (i = blockSize; i < chunk; i++)
+		{
+			out[i] ^= ciphertext[i - blockSize];
+		}
+		memcpy(iv, ciphertext + chunk - blockSize, blockSize);
+
+		in += chunk;
+		out += chunk;
+		length -= chunk;
+	}
+}
+
+static void ctrCrypt(CipherContext* context, uint8_t* counter, const uint8_t* in, uint8_t* out, size_t length, int bulk)
+{
+	MODES_ctr_span(context, counter, in, out, length, bulk);
+}
+
+static const SpanFunction spans[MODE_COUNT][2] =
+{
+	{ ecbEncrypt, ecbDecrypt },
+	{ cbcEncrypt, cbcDecrypt },
+	{ ctrCrypt, ctrCrypt }
+};
+
+static size_t totalLength(const IoVector* vectors, size_t count)
+{
+	size_t length = 0;
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		length += vectors[i].length;
+	}
+
+	return length;
+}
+
+// bytes left in the current segment, moving past the exhausted ones
+static size_t contiguous(Cursor* cursor)
+{
+	while (cursor->index < cursor->count && cursor->offset == cursor->vectors[cursor->index].length)
+	{
+		cursor->index++;
+		cursor->offset = 0;
+	}
+
+	return cursor->index < cursor->count ? cursor->vectors[cursor->index].length - cursor->offset : 0;
+}
+
+static uint8_t* position(const Cursor* cursor)
+{
+	return cursor->vectors[cursor->index].data + cursor->offset;
+}
+
+// copies the next length bytes of the chain into buffer
+static void gather(Cursor* cursor, uint8_t* buffer, size_t length)
+{
+	size_t n;
+
+	while (length > 0)
+	{
+		n = contiguous(cursor);
+		n = n < length ? n : length;
+		memcpy(buffer, position(cursor), n);
+		cursor->offset += n;
+		buffer += n;
+		length -= n;
+	}
+}
+
+// copies buffer into the next length bytes of the chain
+static void scatter(Cursor* cursor, const uint8_t* buffer, size_t length)
+{
+	size_t n;
+
+	while (length > 0)
+	{
+		n = contiguous(cursor);
+		n = n < length ? n : length;
+		memcpy(position(cursor), buffer, n);
+		cursor->offset += n;
+		buffer += n;
+		length -= n;
+	}
+}
+
+static CipherStatus process(CipherContext* context, ModeId mode, int decrypt, uint8_t* iv,
+							const IoVector* in, size_t inCount,
+							const IoVector* out, size_t outCount)
+{
+	size_t blockSize = context->cipher->blockSize;
+	uint8_t staging[CIPHER_MAX_BLOCK_SIZE];
+	Cursor source = { in, inCount, 0, 0 };
+	Cursor destination = { out, outCount, 0, 0 };
+	size_t length = totalLength(in, inCount);
+	size_t total = length;
+	// as MODES for a contiguous request of the same length
+	int bulk = total >= MODES_bulk_threshold();
+	SpanFunction span;
+	size_t n;
+
+	if ((unsigned)mode >= MODE_COUNT)
+	{
+		return CIPHER_ERROR_ID;
+	}
+	if (length != totalLength(out, outCount) || (mode != MODE_CTR && length % blockSize != 0))
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	span = spans[mode][decrypt];
+
+	STATS_MODE(statsModes[mode], total);
+	PROBE_MODE_ENTRY(statsModes[mode], context->cipher->id, total);
+	while (length > 0)
+	{
+		n = contiguous(&source);
+		if (contiguous(&destination) < n)
+		{
+			n = contiguous(&destination);
+		}
+
+		if (n >= blockSize)
+		{
+			// interior of both segments
+			n -= n % blockSize;
+			span(context, iv, position(&source), position(&destination), n, bulk);
+			source.offset += n;
+			destination.offset += n;
+		}
+		else
+		{
+			// a block across segments, or the partial last block of CTR
+			n = length < blockSize ? length : blockSize;
+			gather(&source, staging, n);
+			span(context, iv, staging, staging, n, 0);
+			scatter(&destination, staging, n);
+		}
+
+		length -= n;
+	}
+	PROBE_MODE_EXIT(statsModes[mode], context->cipher->id, total);
+
+	return CIPHER_OK;
+}
+
+CipherStatus IOVEC_encrypt(CipherContext* context, ModeId mode, uint8_t* iv,
+						   const IoVector* in, size_t inCount,
+						   const IoVector* out, size_t outCount)
+{
+	return process(context, mode, 0, iv, in, inCount, out, outCount);
+}
+
+CipherStatus IOVEC_decrypt(CipherContext* context, ModeId mode, uint8_t* iv,
+						   const IoVector* in, size_t inCount,
+						   const IoVector* out, size_t outCount)
+{
+	return process(context, mode, 1, iv, in, inCount, out, outCount);
+}
\ No newline at end of file
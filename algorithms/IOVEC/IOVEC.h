@@ -0,0 +1,37 @@
+/* IOVEC.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+#include "../MODES/MODES.h"
+
+// one segment of a scatter-gather chain, as struct iovec
+typedef struct
+{
+	uint8_t* data;
+	size_t length;
+} IoVector;
+
+/*
+	Encrypts/decrypts the bytes of the in chain into the out chain, without
+	copying them into a contiguous buffer; the two chains may be segmented
+	differently but must hold the same number of bytes, and may be the same
+	chain. iv is unused by ECB, is the iv of CBC and the counter of CTR, and
+	is updated as by the MODES functions, so calls can be chained. ECB and
+	CBC require a multiple of the block size, CIPHER_ERROR_LENGTH otherwise.
+*/
+CipherStatus IOVEC_encrypt(CipherContext* context, ModeId mode, uint8_t* iv,
+						   const IoVector* in, size_t inCount,
+						   const IoVector* out, size_t outCount);
+CipherStatus IOVEC_decrypt(CipherContext* context, ModeId mode, uint8_t* iv,
+						   const IoVector* in, size_t inCount,
+						   const IoVector* out, size_t outCount);
\ No newline at end of file
@@ -0,0 +1,225 @@
+/* KDF.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Key derivation function in counter mode with CMAC (SP 800-108).
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-108r1-upd1.pdf
+ *
+ * A CMAC is a CBC chain: its blocks depend on each other, so one chain
+ * cannot use the batch kernels. KDF_derive_many runs the chains of up to
+ * KDF_GROUP PRF calls (every block of every requested key) side by side:
+ * step j encrypts block j of all the chains that are still running in a
+ * single batch call. The fixed input is never laid out in memory, its
+ * blocks are built on the fly from the label and the context.
+ *
+ */
+
+#include <string.h>
+
+#include "KDF.h"
+#include "../CMAC/CMAC.h"
+
+// PRF calls (CMAC chains) run together
+#define KDF_GROUP 64
+#define KDF_MAX_KEY_SIZE 64
+
+typedef struct
+{
+	const KdfRequest* request;
+	uint32_t counter;
+	size_t length;
+	size_t nrBlocks;
+} Chain;
+
+static size_t inputLength(const KdfRequest* request)
+{
+	return 4 + request->labelLength + 1 + request->contextLength + 4;
+}
+
+// bytes offset .. offset + length - 1 of [counter]_32 || label || 0x00 || context || [keyLen]_32
+static void inputBytes(const Chain* chain, uint16_t keyLen, size_t offset, uint8_t* out, size_t length)
+{
+	const KdfRequest* request = chain->request;
+	size_t labelEnd = 4 + request->labelLength;
+	size_t contextEnd = labelEnd + 1 + request->contextLength;
+	size_t position;
+	size_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		position = offset + i;
+		if (position < 4)
+		{
+			out[i] = (uint8_t)(chain->counter >> (24 - 8 * position));
+		}
+		else if (position < labelEnd)
+		{
+			out[i] = request->label[position - 4];
+		}
+		else if (position == labelEnd)
+		{
+			out[i] = 0;
+		}
+		else if (position < contextEnd)
+		{
+			out[i] = request->context[position - labelEnd - 1];
+		}
+		else
+		{
+			out[i] = (uint8_t)((uint32_t)keyLen >> (24 - 8 * (position - contextEnd)));
+		}
+	}
+}
+
+// runs the count chains, MAC of chain c into macs + c * blockSize
+static void runChains(const CmacContext* cmac, const Chain* chains, size_t count, uint16_t keyLen, uint8_t* macs)
+{
+	size_t blockSize = cmac->cipher->cipher->blockSize;
+	uint8_t batch[KDF_GROUP * CIPHER_MAX_BLOCK_SIZE];
+	uint8_t block[CIPHER_MAX_BLOCK_SIZE];
+	size_t owners[KDF_GROUP];
+	size_t maxBlocks = 0;
+	size_t nrActive;
+	size_t step;
+	size_t c;
+	size_t a;
+	size_t i;
+
+	memset(macs, 0, count * blockSize);
+	for (c = 0; c < count; c++)
+	{
+		maxBlocks = chains[c].nrBlocks > maxBlocks ? chains[c].nrBlocks : maxBlocks;
+	}
+
+	for (step = 0; step < maxBlocks; step++)
+	{
+		nrActive = 0;
+		for (c = 0; c < count; c++)
+		{
+			const Chain* chain = chains + c;
+			uint8_t* input = batch + nrActive * blockSize;
+
+			if (step >= chain->nrBlocks)
+			{
+				continue;
+			}
+
+			if (step + 1 < chain->nrBlocks)
+			{
+				inputBytes(chain, keyLen, step * blockSize, input, blockSize);
+			}
+			else
+			{
+				inputBytes(chain, keyLen, step * blockSize, block, chain->length - step * blockSize);
+				CMAC_last_block(cmac, block, chain->length - step * blockSize, input);
+			}
+
+			for (i = 0; i < blockSize; i++)
+			{
+				input[i] ^= macs[c * blockSize + i];
+			}
+			owners[nrActive++] = c;
+		}
+
+		CIPHER_encrypt_blocks(cmac->cipher, batch, batch, nrActive);
+		for (a = 0; a < nrActive; a++)
+		{
+			memcpy(macs + owners[a] * blockSize, batch + a * blockSize, blockSize);
+		}
+	}
+
+	// the last step left the derived key blocks in batch
+	CIPHER_wipe(batch, sizeof(batch));
+	CIPHER_wipe(block, sizeof(block));
+}
+
+CipherStatus KDF_derive_many(CipherContext* master, KdfRequest* requests, size_t count, uint16_t keyLen,
+							 CipherContext* contexts, CipherId id)
+{
+	CmacContext cmac;
+	Chain chains[KDF_GROUP];
+	uint8_t macs[KDF_GROUP * CIPHER_MAX_BLOCK_SIZE];
+	uint8_t keys[KDF_GROUP * KDF_MAX_KEY_SIZE];
+	size_t keyBytes = keyLen / 8;
+	size_t blockSize = master->cipher->blockSize;
+	size_t blocksPerKey = (keyBytes + blockSize - 1) / blockSize;
+	size_t keysPerGroup = KDF_GROUP / blocksPerKey;
+	size_t first;
+	size_t n;
+	size_t k;
+	size_t b;
+	CipherStatus status;
+
+	if (keyLen == 0 || keyLen % 8 != 0 || keyBytes > KDF_MAX_KEY_SIZE)
+	{
+		return CIPHER_ERROR_KEY_LENGTH;
+	}
+	status = CMAC_init(&cmac, master);
+	if (status != CIPHER_OK)
+	{
+		return status;
+	}
+
+	for (first = 0; first < count; first += n)
+	{
+		n = count - first < keysPerGroup ? count - first : keysPerGroup;
+
+		// one chain per PRF block of every key of the group
+		for (k = 0; k < n; k++)
+		{
+			for (b = 0; b < blocksPerKey; b++)
+			{
+				Chain* chain = chains + k * blocksPerKey + b;
+
+				chain->request = requests + first + k;
+				chain->counter = (uint32_t)(b + 1);
+				chain->length = inputLength(chain->request);
+				chain->nrBlocks = (chain->length + blockSize - 1) / blockSize;
+			}
+		}
+		runChains(&cmac, chains, n * blocksPerKey, keyLen, macs);
+
+		// K(1) || K(2) || ... truncated to the key length
+		for (k = 0; k < n; k++)
+		{
+			memcpy(keys + k * keyBytes, macs + k * blocksPerKey * blockSize, keyBytes);
+			if (requests[first + k].key != NULL)
+			{
+				memcpy(requests[first + k].key, keys + k * keyBytes, keyBytes);
+			}
+		}
+
+		if (contexts != NULL)
+		{
+			status = CIPHER_init_many(contexts + first, id, keys, keyLen, n);
+			if (status != CIPHER_OK)
+			{
+				break;
+			}
+		}
+	}
+
+	CIPHER_wipe(keys, sizeof(keys));
+	CIPHER_wipe(macs, sizeof(macs));
+	// K1 and K2 come from the master key
+	CIPHER_wipe(&cmac, sizeof(cmac));
+
+	return status;
+}
+
+CipherStatus KDF_derive(CipherContext* master, const uint8_t* label, size_t labelLength,
+						const uint8_t* context, size_t contextLength, uint8_t* key, uint16_t keyLen)
+{
+	KdfRequest request;
+
+	request.label = label;
+	request.labelLength = labelLength;
+	request.context = context;
+	request.contextLength = contextLength;
+	request.key = key;
+
+	return KDF_derive_many(master, &request, 1, keyLen, NULL, CIPHER_COUNT);
+}
\ No newline at end of file
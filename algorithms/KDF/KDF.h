@@ -0,0 +1,44 @@
+/* KDF.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+// one derived key of KDF_derive_many
+typedef struct
+{
+	const uint8_t* label;
+	size_t labelLength;
+	const uint8_t* context;
+	size_t contextLength;
+	// keyLen / 8 bytes, may be NULL when only the expanded context is wanted
+	uint8_t* key;
+} KdfRequest;
+
+/*
+	SP 800-108 KDF in counter mode with CMAC as PRF: block i of the key is
+	CMAC(master, [i]_32 || label || 0x00 || context || [keyLen]_32), from
+	i = 1. master is a context of the master key (encryption direction at
+	least) of a 64 or 128 bits cipher, CIPHER_ERROR_ID otherwise; keyLen is
+	in bits, a non-zero multiple of 8 (CIPHER_ERROR_KEY_LENGTH otherwise).
+*/
+CipherStatus KDF_derive(CipherContext* master, const uint8_t* label, size_t labelLength,
+						const uint8_t* context, size_t contextLength, uint8_t* key, uint16_t keyLen);
+
+/*
+	count keys of keyLen bits at once, the CMAC chains of all of them
+	advancing together through batch calls. When contexts is not NULL,
+	key i is also expanded into contexts[i] for the cipher id (with
+	CIPHER_init_many), ready to use.
+*/
+CipherStatus KDF_derive_many(CipherContext* master, KdfRequest* requests, size_t count, uint16_t keyLen,
+							 CipherContext* contexts, CipherId id);
\ No newline at end of file
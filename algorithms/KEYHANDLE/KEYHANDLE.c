@@ -0,0 +1,274 @@
+/* KEYHANDLE.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Key handles with hot rotation: the expanded context of a key is
+ * replaced while other threads keep encrypting with it, RCU style.
+ *
+ * Readers load the current version with one atomic load per operation.
+ * Their protection is an epoch-based read section: on entry a thread
+ * publishes the global epoch in its record (a store and a fence, once per
+ * batch of operations), on exit it publishes zero. A rotation exchanges
+ * the version pointer, then advances the global epoch and tags the old
+ * version with the epoch it replaced. Any reader that entered after that
+ * sees the new pointer, so the old version is only reachable from
+ * sections with an epoch up to its tag; once every active record is past
+ * it (or idle) the version is wiped and freed.
+ *
+ * Reader records are a list of cache line aligned blocks that only grows
+ * (lock-free push), handed to a new thread when their owner exits, as the
+ * counters of STATS. Writers serialize on the mutex of the handle, which
+ * readers never touch.
+ *
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "KEYHANDLE.h"
+
+typedef struct Reader
+{
+	// epoch of the read section of the owner, 0 outside of one
+	_Alignas(64) uint64_t epoch;
+	struct Reader* next;
+	int inUse;
+} Reader;
+
+// starts at 1, 0 marks an idle reader
+static uint64_t globalEpoch = 1;
+static Reader* readers = NULL;
+static _Thread_local Reader* current = NULL;
+static _Thread_local unsigned nesting = 0;
+static pthread_key_t releaseKey;
+static pthread_once_t releaseOnce = PTHREAD_ONCE_INIT;
+
+// thread exit, the record goes to the next thread
+static void releaseReader(void* record)
+{
+	__atomic_store_n(&((Reader*)record)->epoch, 0, __ATOMIC_RELEASE);
+	__atomic_store_n(&((Reader*)record)->inUse, 0, __ATOMIC_RELEASE);
+}
+
+static void createReleaseKey(void)
+{
+	pthread_key_create(&releaseKey, releaseReader);
+}
+
+static Reader* acquireReader(void)
+{
+	Reader* record;
+	int expected;
+
+	pthread_once(&releaseOnce, createReleaseKey);
+
+	for (record = __atomic_load_n(&readers, __ATOMIC_ACQUIRE); record != NULL; record = record->next)
+	{
+		expected = 0;
+		if (__atomic_compare_exchange_n(&record->inUse, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		{
+			break;
+		}
+	}
+
+	if (record == NULL)
+	{
+		record = aligned_alloc(64, sizeof(Reader));
+		if (record == NULL)
+		{
+			return NULL;
+		}
+		memset(record, 0, sizeof(Reader));
+		record->inUse = 1;
+
+		record->next = __atomic_load_n(&readers, __ATOMIC_RELAXED);
+		while (!__atomic_compare_exchange_n(&readers, &record->next, record, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		{
+		}
+	}
+
+	pthread_setspecific(releaseKey, record);
+	current = record;
+
+	return record;
+}
+
+// smallest epoch of the active read sections, UINT64_MAX when there is none
+static uint64_t oldestReader(void)
+{
+	uint64_t oldest = UINT64_MAX;
+	uint64_t epoch;
+	Reader* record;
+
+	for (record = __atomic_load_n(&readers, __ATOMIC_ACQUIRE); record != NULL; record = record->next)
+	{
+		epoch = __atomic_load_n(&record->epoch, __ATOMIC_SEQ_CST);
+		if (epoch != 0 && epoch < oldest)
+		{
+			oldest = epoch;
+		}
+	}
+
+	return oldest;
+}
+
+static void freeVersion(KeyVersion* version)
+{
+	CIPHER_wipe(version, sizeof(KeyVersion));
+	free(version);
+}
+
+static KeyVersion* newVersion(CipherId id, const uint8_t* key, uint16_t keyLen, CipherStatus* status)
+{
+	KeyVersion* version = aligned_alloc(64, (sizeof(KeyVersion) + 63) / 64 * 64);
+
+	if (version == NULL)
+	{
+		*status = CIPHER_ERROR_MEMORY;
+		return NULL;
+	}
+
+	memset(version, 0, sizeof(KeyVersion));
+	*status = CIPHER_init(&version->context, id, key, keyLen);
+	if (*status != CIPHER_OK)
+	{
+		freeVersion(version);
+		return NULL;
+	}
+
+	return version;
+}
+
+// with the lock of the handle held
+static size_t reclaim(KeyHandle* handle)
+{
+	KeyVersion** link = &handle->retired;
+	KeyVersion* version;
+	uint64_t oldest;
+
+	if (handle->retired == NULL)
+	{
+		return 0;
+	}
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	oldest = oldestReader();
+
+	while ((version = *link) != NULL)
+	{
+		if (version->retiredEpoch < oldest)
+		{
+			*link = version->next;
+			freeVersion(version);
+			handle->nrRetired--;
+		}
+		else
+		{
+			link = &version->next;
+		}
+	}
+
+	return handle->nrRetired;
+}
+
+CipherStatus KEYHANDLE_init(KeyHandle* handle, CipherId id, const uint8_t* key, uint16_t keyLen)
+{
+	CipherStatus status;
+	KeyVersion* version = newVersion(id, key, keyLen, &status);
+
+	if (version == NULL)
+	{
+		return status;
+	}
+
+	handle->current = version;
+	handle->id = id;
+	pthread_mutex_init(&handle->lock, NULL);
+	handle->retired = NULL;
+	handle->nrRetired = 0;
+
+	return CIPHER_OK;
+}
+
+int KEYHANDLE_read_begin(void)
+{
+	Reader* record = current != NULL ? current : acquireReader();
+
+	if (record == NULL)
+	{
+		return -1;
+	}
+
+	if (nesting++ == 0)
+	{
+		__atomic_store_n(&record->epoch, __atomic_load_n(&globalEpoch, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+		// the epoch must be visible before the loads of the versions
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	}
+
+	return 0;
+}
+
+void KEYHANDLE_read_end(void)
+{
+	if (nesting > 0 && --nesting == 0)
+	{
+		__atomic_store_n(&current->epoch, 0, __ATOMIC_RELEASE);
+	}
+}
+
+CipherStatus KEYHANDLE_rotate(KeyHandle* handle, const uint8_t* key, uint16_t keyLen)
+{
+	CipherStatus status;
+	KeyVersion* version = newVersion(handle->id, key, keyLen, &status);
+	KeyVersion* old;
+
+	if (version == NULL)
+	{
+		return status;
+	}
+
+	pthread_mutex_lock(&handle->lock);
+
+	old = __atomic_exchange_n(&handle->current, version, __ATOMIC_SEQ_CST);
+	old->retiredEpoch = __atomic_fetch_add(&globalEpoch, 1, __ATOMIC_SEQ_CST);
+	old->next = handle->retired;
+	handle->retired = old;
+	handle->nrRetired++;
+
+	reclaim(handle);
+
+	pthread_mutex_unlock(&handle->lock);
+
+	return CIPHER_OK;
+}
+
+size_t KEYHANDLE_reclaim(KeyHandle* handle)
+{
+	size_t left;
+
+	pthread_mutex_lock(&handle->lock);
+	left = reclaim(handle);
+	pthread_mutex_unlock(&handle->lock);
+
+	return left;
+}
+
+void KEYHANDLE_synchronize(KeyHandle* handle)
+{
+	while (KEYHANDLE_reclaim(handle) > 0)
+	{
+		sched_yield();
+	}
+}
+
+void KEYHANDLE_destroy(KeyHandle* handle)
+{
+	KEYHANDLE_synchronize(handle);
+
+	freeVersion(handle->current);
+	handle->current = NULL;
+	pthread_mutex_destroy(&handle->lock);
+}
\ No newline at end of file
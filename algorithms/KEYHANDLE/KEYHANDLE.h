@@ -0,0 +1,70 @@
+/* KEYHANDLE.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "../CIPHER/CIPHER.h"
+
+typedef struct KeyVersion
+{
+	CipherContext context;
+	// global epoch when it was replaced, freed once every reader is past it
+	uint64_t retiredEpoch;
+	struct KeyVersion* next;
+} KeyVersion;
+
+typedef struct
+{
+	// read with one atomic load, replaced by KEYHANDLE_rotate
+	KeyVersion* current;
+	CipherId id;
+	// writers only: rotations and the retired versions
+	pthread_mutex_t lock;
+	KeyVersion* retired;
+	size_t nrRetired;
+} KeyHandle;
+
+CipherStatus KEYHANDLE_init(KeyHandle* handle, CipherId id, const uint8_t* key, uint16_t keyLen);
+
+/*
+	Read sections: the contexts returned by KEYHANDLE_get stay valid until
+	the matching KEYHANDLE_read_end, whatever the rotations meanwhile.
+	Sections nest and cost a store and a fence on entry, so a worker enters
+	one around a batch of operations, not around each one. Returns -1 when
+	the thread cannot be registered (out of memory), 0 otherwise.
+*/
+int KEYHANDLE_read_begin(void);
+void KEYHANDLE_read_end(void);
+
+// the current context, inside a read section: one atomic load, no lock and no reference count
+static inline CipherContext* KEYHANDLE_get(KeyHandle* handle)
+{
+	return &__atomic_load_n(&handle->current, __ATOMIC_ACQUIRE)->context;
+}
+
+/*
+	Expands the new key into a fresh context and publishes it with one
+	atomic exchange; readers see either context, never a mix. The old one
+	is retired and wiped and freed once no read section can hold it (the
+	retired versions are reclaimed by every rotation). On error the handle
+	keeps its current key.
+*/
+CipherStatus KEYHANDLE_rotate(KeyHandle* handle, const uint8_t* key, uint16_t keyLen);
+
+// wipes and frees the retired versions no reader can hold, returns the number left
+size_t KEYHANDLE_reclaim(KeyHandle* handle);
+
+// waits until every retired version is freed; not from inside a read section
+void KEYHANDLE_synchronize(KeyHandle* handle);
+
+// synchronizes and wipes the current context; no reader may use the handle any more
+void KEYHANDLE_destroy(KeyHandle* handle);
\ No newline at end of file
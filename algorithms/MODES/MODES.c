@@ -0,0 +1,342 @@
+/* MODES.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Block cipher modes of operation over the generic CIPHER front-end,
+ * so they work with every cipher and block size of the repository.
+ *
+ * This code follows a specification:
+ *		- https://nvlpubs.nist.gov/nistpubs/Legacy/SP/nistspecialpublication800-38a.pdf
+ *
+ * ECB and CTR calls larger than the last level cache take a bulk path:
+ * the input is prefetched ahead of the batch kernel and each chunk is
+ * produced in an L1 buffer, then written out with non-temporal stores,
+ * so the output does not evict the cipher tables and the caller's data.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define MODES_X86
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "MODES.h"
+#include "../PROBES/PROBES.h"
+#include "../STATS/STATS.h"
+
+// number of blocks of keystream generated per batch call in CTR
+#define CTR_BATCH 64
+// bytes per chunk of the bulk path, and how far ahead the input is prefetched
+#define BULK_CHUNK 1024
+#define PREFETCH_DISTANCE (4 * BULK_CHUNK)
+// bulk threshold when the last level cache size is unknown
+#define DEFAULT_BULK_THRESHOLD (8 << 20)
+
+// 0 until first use (the cache size), read by every thread: relaxed atomic loads and stores
+static size_t bulkThreshold;
+
+static const char* modeNames[MODE_COUNT] = { "ECB", "CBC", "CTR" };
+
+const char* MODES_name(ModeId mode)
+{
+	return (unsigned)mode < MODE_COUNT ? modeNames[mode] : NULL;
+}
+
+void MODES_counter_increment(uint8_t* counter, size_t blockSize)
+{
+	size_t i = blockSize;
+
+	while (i > 0 && ++counter[--i] == 0)
+	{
+	}
+}
+
+size_t MODES_bulk_threshold(void)
+{
+	size_t threshold = __atomic_load_n(&bulkThreshold, __ATOMIC_RELAXED);
+
+	if (threshold == 0)
+	{
+		threshold = DEFAULT_BULK_THRESHOLD;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+		if (sysconf(_SC_LEVEL3_CACHE_SIZE) > 0)
+		{
+			threshold = (size_t)sysconf(_SC_LEVEL3_CACHE_SIZE);
+		}
+#endif
+		// racing threads store the same value
+		__atomic_store_n(&bulkThreshold, threshold, __ATOMIC_RELAXED);
+	}
+
+	return threshold;
+}
+
+void MODES_set_bulk_threshold(size_t length)
+{
+	__atomic_store_n(&bulkThreshold, length, __ATOMIC_RELAXED);
+}
+
+// prefetches the lines of [p, p + length) for a single use (no temporal locality)
+static void prefetch(const uint8_t* p, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i += 64)
+	{
+		__builtin_prefetch(p + i, 0, 0);
+	}
+}
+
+// copies with non-temporal stores where the target has them, memcpy otherwise
+static void streamCopy(uint8_t* out, const uint8_t* in, size_t length)
+{
+#ifdef MODES_X86
+	size_t head = (16 - ((uintptr_t)out & 15)) & 15;
+	size_t i;
+
+	if (head > length)
+	{
+		head = length;
+	}
+	memcpy(out, in, head);
+
+	for (i = head; i + 16 <= length; i += 16)
+	{
+		_mm_stream_si128((__m128i*)(out + i), _mm_loadu_si128((const __m128i*)(in + i)));
+	}
+	memcpy(out + i, in + i, length - i);
+#else
+	memcpy(out, in, length);
+#endif
+}
+
+// makes the non-temporal stores visible before returning to the caller
+static void streamFence(void)
+{
+#ifdef MODES_X86
+	_mm_sfence();
+#endif
+}
+
+static void ecbBulk(CipherContext* context, const uint8_t* in, uint8_t* out, size_t length, int decrypt)
+{
+	uint8_t buffer[BULK_CHUNK];
+	size_t blockSize = context->cipher->blockSize;
+	size_t chunk = BULK_CHUNK / blockSize * blockSize;
+	size_t offset;
+
+	for (offset = 0; offset < length; offset += chunk)
+	{
+		if (chunk > length - offset)
+		{
+			chunk = length - offset;
+		}
+
+		if (offset + PREFETCH_DISTANCE < length)
+		{
+			prefetch(in + offset + PREFETCH_DISTANCE, length - offset - PREFETCH_DISTANCE < chunk ? length - offset - PREFETCH_DISTANCE : chunk);
+		}
+
+		if (decrypt)
+		{
+			CIPHER_decrypt_blocks(context, in + offset, buffer, chunk / blockSize);
+		}
+		else
+		{
+			CIPHER_encrypt_blocks(context, in + offset, buffer, chunk / blockSize);
+		}
+		streamCopy(out + offset, buffer, chunk);
+	}
+	streamFence();
+}
+
+void MODES_ecb_span(CipherContext* context, const uint8_t* in, uint8_t* out, size_t length, int decrypt, int bulk)
+{
+	if (bulk)
+	{
+		ecbBulk(context, in, out, length, decrypt);
+	}
+	else if (decrypt)
+	{
+		CIPHER_decrypt_blocks(context, in, out, length / context->cipher->blockSize);
+	}
+	else
+	{
+		CIPHER_encrypt_blocks(context, in, out, length / context->cipher->blockSize);
+	}
+}
+
+CipherStatus MODES_ecb_encrypt(CipherContext* context, const uint8_t* in, uint8_t* out, size_t length)
+{
+	size_t blockSize = context->cipher->blockSize;
+
+	if (length % blockSize != 0)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	STATS_MODE(STATS_MODE_ECB, length);
+	PROBE_MODE_ENTRY(STATS_MODE_ECB, context->cipher->id, length);
+	MODES_ecb_span(context, in, out, length, 0, length >= MODES_bulk_threshold());
+	PROBE_MODE_EXIT(STATS_MODE_ECB, context->cipher->id, length);
+
+	return CIPHER_OK;
+}
+
+CipherStatus MODES_ecb_decrypt(CipherContext* context, const uint8_t* in, uint8_t* out, size_t length)
+{
+	size_t blockSize = context->cipher->blockSize;
+
+	if (length % blockSize != 0)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	STATS_MODE(STATS_MODE_ECB, length);
+	PROBE_MODE_ENTRY(STATS_MODE_ECB, context->cipher->id, length);
+	MODES_ecb_span(context, in, out, length, 1, length >= MODES_bulk_threshold());
+	PROBE_MODE_EXIT(STATS_MODE_ECB, context->cipher->id, length);
+
+	return CIPHER_OK;
+}
+
+void MODES_cbc_encrypt_span(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length)
+{
+	size_t blockSize = context->cipher->blockSize;
+	size_t offset;
+	size_t i;
+
+	for (offset = 0; offset < length; offset += blockSize)
+	{
+		for (i = 0; i < blockSize; i++)
+		{
+			iv[i] ^= in[offset + i];
+		}
+		CIPHER_encrypt(context, iv, iv);
+		memcpy(out + offset, iv, blockSize);
+	}
+}
+
+CipherStatus MODES_cbc_encrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length)
+{
+	if (length % context->cipher->blockSize != 0)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	STATS_MODE(STATS_MODE_CBC, length);
+	PROBE_MODE_ENTRY(STATS_MODE_CBC, context->cipher->id, length);
+	MODES_cbc_encrypt_span(context, iv, in, out, length);
+	PROBE_MODE_EXIT(STATS_MODE_CBC, context->cipher->id, length);
+
+	return CIPHER_OK;
+}
+
+CipherStatus MODES_cbc_decrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length)
+{
+	size_t blockSize = context->cipher->blockSize;
+	uint8_t previous[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t current[CIPHER_MAX_BLOCK_SIZE];
+	size_t offset;
+	size_t i;
+
+	if (length % blockSize != 0)
+	{
+		return CIPHER_ERROR_LENGTH;
+	}
+
+	STATS_MODE(STATS_MODE_CBC, length);
+	PROBE_MODE_ENTRY(STATS_MODE_CBC, context->cipher->id, length);
+	memcpy(previous, iv, blockSize);
+	for (offset = 0; offset < length; offset += blockSize)
+	{
+		// keep a copy, in and out may be the same buffer
+		memcpy(current, in + offset, blockSize);
+		CIPHER_decrypt(context, current, out + offset);
+		for (i = 0; i < blockSize; i++)
+		{
+			out[offset + i] ^= previous[i];
+		}
+		memcpy(previous, current, blockSize);
+	}
+	memcpy(iv, previous, blockSize);
+	PROBE_MODE_EXIT(STATS_MODE_CBC, context->cipher->id, length);
+
+	return CIPHER_OK;
+}
+
+void MODES_ctr_span(CipherContext* context, uint8_t* counter, const uint8_t* in, uint8_t* out, size_t length, int bulk)
+{
+	size_t blockSize = context->cipher->blockSize;
+	uint8_t keystream[CTR_BATCH * CIPHER_MAX_BLOCK_SIZE];
+	size_t nrBlocks;
+	size_t chunk;
+	size_t i;
+
+	while (length > 0)
+	{
+		nrBlocks = (length + blockSize - 1) / blockSize;
+		if (nrBlocks > CTR_BATCH)
+		{
+			nrBlocks = CTR_BATCH;
+		}
+
+		// lay out the counter blocks and encrypt them in a single batch
+		for (i = 0; i < nrBlocks; i++)
+		{
+			memcpy(keystream + i * blockSize, counter, blockSize);
+			MODES_counter_increment(counter, blockSize);
+		}
+		CIPHER_encrypt_blocks(context, keystream, keystream, nrBlocks);
+
+		chunk = nrBlocks * blockSize;
+		if (chunk > length)
+		{
+			chunk = length;
+		}
+
+		if (bulk)
+		{
+			// the keystream buffer (in L1) takes the result, then streams out
+			if (length > PREFETCH_DISTANCE + chunk)
+			{
+				prefetch(in + PREFETCH_DISTANCE, chunk);
+			}
+			for (i = 0; i < chunk; i++)
+			{
+				keystream[i] ^= in[i];
+			}
+			streamCopy(out, keystream, chunk);
+		}
+		else
+		{
+			for (i = 0; i < chunk; i++)
+			{
+				out[i] = in[i] ^ keystream[i];
+			}
+		}
+
+		in += chunk;
+		out += chunk;
+		length -= chunk;
+	}
+	if (bulk)
+	{
+		streamFence();
+	}
+}
+
+void MODES_ctr_crypt(CipherContext* context, uint8_t* counter, const uint8_t* in, uint8_t* out, size_t length)
+{
+	STATS_MODE(STATS_MODE_CTR, length);
+	PROBE_MODE_ENTRY(STATS_MODE_CTR, context->cipher->id, length);
+	MODES_ctr_span(context, counter, in, out, length, length >= MODES_bulk_threshold());
+	PROBE_MODE_EXIT(STATS_MODE_CTR, context->cipher->id, length);
+}
\ No newline at end of file
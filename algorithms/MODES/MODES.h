@@ -0,0 +1,60 @@
+/* MODES.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+typedef enum
+{
+	MODE_ECB = 0,
+	MODE_CBC,
+	MODE_CTR,
+	MODE_COUNT
+} ModeId;
+
+const char* MODES_name(ModeId mode);
+
+/*
+	ECB and CTR calls of at least this many bytes take the bulk path: input
+	prefetched ahead, output written with non-temporal stores so it does
+	not evict the caches. Defaults to the last level cache size (8 MiB when
+	unknown); 0 restores the default and SIZE_MAX disables the bulk path.
+*/
+size_t MODES_bulk_threshold(void);
+void MODES_set_bulk_threshold(size_t length);
+
+// ECB and CBC require length to be a multiple of the block size
+CipherStatus MODES_ecb_encrypt(CipherContext* context, const uint8_t* in, uint8_t* out, size_t length);
+CipherStatus MODES_ecb_decrypt(CipherContext* context, const uint8_t* in, uint8_t* out, size_t length);
+
+// iv is updated with the last ciphertext block, so calls can be chained
+CipherStatus MODES_cbc_encrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length);
+CipherStatus MODES_cbc_decrypt(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length);
+
+/*
+	counter is a big-endian integer of one block, incremented once per block.
+	Any length is accepted; after a partial last block the counter already
+	points to the next block, so only the final call of a stream may be partial.
+*/
+void MODES_ctr_crypt(CipherContext* context, uint8_t* counter, const uint8_t* in, uint8_t* out, size_t length);
+
+/*
+	The modes over one contiguous span, without the STATS/PROBES accounting
+	and the length checks of the calls above, for front-ends that account a
+	whole request themselves (IOVEC, over the segments of a chain). bulk
+	selects the bulk path, length >= MODES_bulk_threshold() of the request.
+*/
+void MODES_ecb_span(CipherContext* context, const uint8_t* in, uint8_t* out, size_t length, int decrypt, int bulk);
+void MODES_cbc_encrypt_span(CipherContext* context, uint8_t* iv, const uint8_t* in, uint8_t* out, size_t length);
+void MODES_ctr_span(CipherContext* context, uint8_t* counter, const uint8_t* in, uint8_t* out, size_t length, int bulk);
+
+void MODES_counter_increment(uint8_t* counter, size_t blockSize);
\ No newline at end of file
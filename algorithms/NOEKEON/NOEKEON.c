@@ -144,6 +144,90 @@ void NOEKEON_decrypt(uint32_t* encryptedBlock, uint32_t* key, uint32_t* decrypte
 	decryptedBlock[0] ^= RC[0];
 }
 
+#ifdef SIMD_AVAILABLE
+static void gammaLanes(SimdU32* a)
+{
+	SimdU32 tmp;
+
+	a[1] ^= ~a[3] & ~a[2];
+	a[0] ^= a[2] & a[1];
+
+	tmp = a[3];
+	a[3] = a[0];
+	a[0] = tmp;
+
+	a[2] ^= a[0] ^ a[1] ^ a[3];
+	a[1] ^= ~a[3] & ~a[2];
+	a[0] ^= a[2] & a[1];
+}
+
+static void thetaLanes(const uint32_t* k, SimdU32* a)
+{
+	SimdU32 temp = a[0] ^ a[2];
+	temp ^= SIMD_ror32(temp, 8) ^ SIMD_rol32(temp, 8);
+
+	a[1] ^= temp;
+	a[3] ^= temp;
+
+	a[0] ^= k[0];
+	a[1] ^= k[1];
+	a[2] ^= k[2];
+	a[3] ^= k[3];
+
+	temp = a[1] ^ a[3];
+	temp ^= SIMD_ror32(temp, 8) ^ SIMD_rol32(temp, 8);
+
+	a[0] ^= temp;
+	a[2] ^= temp;
+}
+
+static void roundLanes(const uint32_t* key, SimdU32* a, uint32_t c1, uint32_t c2)
+{
+	a[0] ^= c1;
+	thetaLanes(key, a);
+	a[0] ^= c2;
+
+	a[1] = SIMD_rol32(a[1], 1);
+	a[2] = SIMD_rol32(a[2], 5);
+	a[3] = SIMD_rol32(a[3], 2);
+	gammaLanes(a);
+	a[1] = SIMD_ror32(a[1], 1);
+	a[2] = SIMD_ror32(a[2], 5);
+	a[3] = SIMD_ror32(a[3], 2);
+}
+
+void NOEKEON_encrypt_lanes(const uint32_t* key, SimdU32* a)
+{
+	int i;
+
+	for (i = 0; i < NR_ROUNDS; i++)
+	{
+		roundLanes(key, a, RC[i], 0);
+	}
+
+	a[0] ^= RC[NR_ROUNDS];
+	thetaLanes(key, a);
+}
+
+void NOEKEON_decrypt_lanes(const uint32_t* key, SimdU32* a)
+{
+	uint32_t workingKey[4];
+	int i;
+
+	// the working key is computed once per batch instead of once per block
+	MOV_128(workingKey, (uint32_t*)key);
+	theta(NULL_VECTOR, workingKey);
+
+	for (i = NR_ROUNDS; i > 0; i--)
+	{
+		roundLanes(workingKey, a, 0, RC[i]);
+	}
+
+	thetaLanes(workingKey, a);
+	a[0] ^= RC[0];
+}
+#endif
+
 void NOEKEON_main(void)
 {
 	int i;
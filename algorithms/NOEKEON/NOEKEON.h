@@ -10,7 +10,15 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include "../SIMD/SIMD.h"
+
 void NOEKEON_encrypt(uint32_t* block, uint32_t* key, uint32_t* encryptdBlock);
 void NOEKEON_decrypt(uint32_t* encryptedBlock, uint32_t* key, uint32_t* decryptedBlock);
 
+#ifdef SIMD_AVAILABLE
+// SIMD_LANES_32 blocks at once, word j of every block in a[j]
+void NOEKEON_encrypt_lanes(const uint32_t* key, SimdU32* a);
+void NOEKEON_decrypt_lanes(const uint32_t* key, SimdU32* a);
+#endif
+
 void NOEKEON_main(void);
\ No newline at end of file
@@ -17,6 +17,7 @@
  */
 
 #include "PRESENT.h"
+#include "../PROFILE/PROFILE.h"
 
 #define NR_ROUNDS 31
 
@@ -112,6 +113,107 @@ void PRESENT_init(PresentContext* context, uint16_t* key, uint16_t keyLen)
 	}
 }
 
+#if defined(SIMD_AVAILABLE) && SIMD_LANES_64 >= 4
+/*
+	count key schedules, SIMD_LANES_64 at a time: lane l runs the schedule
+	of key l, as PRESENT_init, with the s-box looked up lane by lane, and
+	its round keys are then copied to contexts[l].
+*/
+void PRESENT_init_many(PresentContext** contexts, const uint16_t* keys, uint16_t keyLen, size_t count)
+{
+	int nrWords = keyLen / 16;
+	SimdU64 roundKeys[NR_ROUNDS + 1];
+	SimdU64 keyHigh;
+	SimdU64 keyLow;
+	SimdU64 temp;
+	const uint16_t* key;
+	size_t n;
+	size_t l;
+	int i;
+
+	for (; count > 0; count -= n, contexts += n, keys += n * nrWords)
+	{
+		n = count < SIMD_LANES_64 ? count : SIMD_LANES_64;
+
+		for (l = 0; l < SIMD_LANES_64; l++)
+		{
+			key = keys + (l < n ? l : 0) * nrWords;
+			if (keyLen == 80)
+			{
+				keyHigh[l] = key[0];
+				keyLow[l] = (uint64_t)key[1] << 48 | (uint64_t)key[2] << 32 | (uint64_t)key[3] << 16 | key[4];
+			}
+			else
+			{
+				keyHigh[l] = (uint64_t)key[0] << 48 | (uint64_t)key[1] << 32 | (uint64_t)key[2] << 16 | key[3];
+				keyLow[l] = (uint64_t)key[4] << 48 | (uint64_t)key[5] << 32 | (uint64_t)key[6] << 16 | key[7];
+			}
+		}
+
+		if (keyLen == 80)
+		{
+			roundKeys[0] = keyHigh << 48 | keyLow >> 16;
+
+			for (i = 1; i <= NR_ROUNDS; i++)
+			{
+				temp = keyHigh;
+				keyHigh = keyLow >> 3 & 0xffff;
+				keyLow = keyLow << 61 | temp << 45 | keyLow >> 19;
+
+				for (l = 0; l < SIMD_LANES_64; l++)
+				{
+					keyHigh[l] = (keyHigh[l] & 0x0fff) | (uint64_t)sbox[(keyHigh[l] >> 12) & 0xf] << 12;
+				}
+
+				keyLow ^= (uint64_t)i << 15;
+				roundKeys[i] = keyHigh << 48 | keyLow >> 16;
+			}
+		}
+		else
+		{
+			roundKeys[0] = keyHigh;
+
+			for (i = 1; i <= NR_ROUNDS; i++)
+			{
+				temp = keyHigh;
+				keyHigh = temp << 61 | keyLow >> 3;
+				keyLow = keyLow << 61 | temp >> 3;
+
+				// or-ed in, as PRESENT_init does
+				for (l = 0; l < SIMD_LANES_64; l++)
+				{
+					keyHigh[l] |= (uint64_t)sbox[(keyHigh[l] >> 60) & 0xf] << 60;
+					keyHigh[l] |= (uint64_t)sbox[(keyHigh[l] >> 56) & 0xf] << 56;
+				}
+
+				keyHigh ^= (uint64_t)(i >> 2);
+				keyLow ^= (uint64_t)i << 62;
+				roundKeys[i] = keyHigh;
+			}
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			for (i = 0; i <= NR_ROUNDS; i++)
+			{
+				contexts[l]->roundKeys[i] = roundKeys[i][l];
+			}
+		}
+	}
+}
+#else
+// narrower vectors do not beat PRESENT_init
+void PRESENT_init_many(PresentContext** contexts, const uint16_t* keys, uint16_t keyLen, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		PRESENT_init(contexts[i], (uint16_t*)keys + i * (keyLen / 16), keyLen);
+	}
+}
+#endif
+
 /*
 	Encryption order:
 
@@ -162,6 +264,7 @@ void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 
 		// permutation layer
 		// change order of all bits according to the permutation table
+		PROFILE_BEGIN(permutationStart);
 		temp = 0;
 		for (i = 0; i < 64; i++)
 		{
@@ -169,6 +272,7 @@ void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 			temp |= ((state >> distance & 0x1) << (63 - p[i]));
 		}
 		state = temp;
+		PROFILE_END(PROFILE_PRESENT_PERMUTATION, permutationStart);
 	}
 
 	// add last round key
@@ -214,6 +318,7 @@ void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 		// permutation layer
 		// change order of all bits according to the permutation table
 		// but in reverse order
+		PROFILE_BEGIN(permutationStart);
 		temp = 0;
 		for (i = 0; i < 64; i++)
 		{
@@ -221,6 +326,7 @@ void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 			temp = (temp << 1) | ((state >> distance) & 0x1);
 		}
 		state = temp;
+		PROFILE_END(PROFILE_PRESENT_PERMUTATION, permutationStart);
 
 		// sbox substitution layer
 		// divide state into 16 parts of 4 bits and substitute these parts
@@ -252,6 +358,21 @@ void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out)
 	out[3] = (uint16_t)state;
 }
 
+// s-box, inverse s-box and permutation table, returns the size or 0 past the last one
+size_t PRESENT_lookup_table(int index, const void** address)
+{
+	static const void* tables[3] = { sbox, isbox, p };
+	static const size_t sizes[3] = { sizeof(sbox), sizeof(isbox), sizeof(p) };
+
+	if (index < 0 || index >= 3)
+	{
+		return 0;
+	}
+
+	*address = tables[index];
+	return sizes[index];
+}
+
 void PRESENT_main(void)
 {
 	PresentContext context;
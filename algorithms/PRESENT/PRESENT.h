@@ -10,13 +10,18 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include "../SIMD/SIMD.h"
+
 typedef struct
 {
 	uint64_t roundKeys[32];
 } PresentContext;
 
 void PRESENT_init(PresentContext* context, uint16_t* key, uint16_t keyLen);
+// count keys of keyLen / 16 words one after the other, same as PRESENT_init on each
+void PRESENT_init_many(PresentContext** contexts, const uint16_t* keys, uint16_t keyLen, size_t count);
 void PRESENT_encrypt(PresentContext* context, uint16_t* block, uint16_t* out);
 void PRESENT_decrypt(PresentContext* context, uint16_t* block, uint16_t* out);
+size_t PRESENT_lookup_table(int index, const void** address);
 
 void PRESENT_main(void);
\ No newline at end of file
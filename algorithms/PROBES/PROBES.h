@@ -0,0 +1,50 @@
+/* PROBES.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * USDT static tracepoints of the "cipher" provider. With <sys/sdt.h>
+ * (systemtap-sdt-dev) each probe is a single NOP plus an ELF note, and
+ * becomes a breakpoint only while a tracer is attached, e.g.:
+ *
+ *		bpftrace -e 'usdt:./bench:cipher:batch_entry { @[arg0, arg2] = count(); }'
+ *
+ * Probes and arguments (ids are CipherId, StatsMode and kernel numbers):
+ *		- key_setup_entry/exit (cipher, key length in bits, encrypt only)
+ *		- batch_entry/exit     (cipher, kernel, blocks, bytes, decrypt)
+ *		- mode_entry/exit      (mode, cipher, length)
+ *		- chunk_entry/exit     (cipher, length, worker)
+ *
+ * Without <sys/sdt.h>, or with -DCIPHER_NO_PROBES, they compile to nothing
+ * (the arguments only appear in an unevaluated sizeof).
+ *
+ */
+
+#pragma once
+
+#if !defined(CIPHER_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define CIPHER_PROBES
+#endif
+#endif
+
+#ifdef CIPHER_PROBES
+#define PROBE_KEY_SETUP_ENTRY(id, keyLen, encryptOnly) DTRACE_PROBE3(cipher, key_setup_entry, id, keyLen, encryptOnly)
+#define PROBE_KEY_SETUP_EXIT(id, keyLen, encryptOnly) DTRACE_PROBE3(cipher, key_setup_exit, id, keyLen, encryptOnly)
+#define PROBE_BATCH_ENTRY(id, kernel, nrBlocks, bytes, decrypt) DTRACE_PROBE5(cipher, batch_entry, id, kernel, nrBlocks, bytes, decrypt)
+#define PROBE_BATCH_EXIT(id, kernel, nrBlocks, bytes, decrypt) DTRACE_PROBE5(cipher, batch_exit, id, kernel, nrBlocks, bytes, decrypt)
+#define PROBE_MODE_ENTRY(mode, id, length) DTRACE_PROBE3(cipher, mode_entry, mode, id, length)
+#define PROBE_MODE_EXIT(mode, id, length) DTRACE_PROBE3(cipher, mode_exit, mode, id, length)
+#define PROBE_CHUNK_ENTRY(id, length, worker) DTRACE_PROBE3(cipher, chunk_entry, id, length, worker)
+#define PROBE_CHUNK_EXIT(id, length, worker) DTRACE_PROBE3(cipher, chunk_exit, id, length, worker)
+#else
+#define PROBE_KEY_SETUP_ENTRY(id, keyLen, encryptOnly) ((void)sizeof(id), (void)sizeof(keyLen), (void)sizeof(encryptOnly))
+#define PROBE_KEY_SETUP_EXIT(id, keyLen, encryptOnly) ((void)sizeof(id), (void)sizeof(keyLen), (void)sizeof(encryptOnly))
+#define PROBE_BATCH_ENTRY(id, kernel, nrBlocks, bytes, decrypt) ((void)sizeof(id), (void)sizeof(kernel), (void)sizeof(nrBlocks), (void)sizeof(bytes), (void)sizeof(decrypt))
+#define PROBE_BATCH_EXIT(id, kernel, nrBlocks, bytes, decrypt) ((void)sizeof(id), (void)sizeof(kernel), (void)sizeof(nrBlocks), (void)sizeof(bytes), (void)sizeof(decrypt))
+#define PROBE_MODE_ENTRY(mode, id, length) ((void)sizeof(mode), (void)sizeof(id), (void)sizeof(length))
+#define PROBE_MODE_EXIT(mode, id, length) ((void)sizeof(mode), (void)sizeof(id), (void)sizeof(length))
+#define PROBE_CHUNK_ENTRY(id, length, worker) ((void)sizeof(id), (void)sizeof(length), (void)sizeof(worker))
+#define PROBE_CHUNK_EXIT(id, length, worker) ((void)sizeof(id), (void)sizeof(length), (void)sizeof(worker))
+#endif
\ No newline at end of file
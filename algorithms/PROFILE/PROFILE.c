@@ -0,0 +1,148 @@
+/* PROFILE.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Per-function cycle attribution of the profiling build. The internal
+ * steps of the ciphers (S-box layers, diffusion layers, multiplications)
+ * accumulate their TSC cycles and calls here, and the report gives the
+ * share of each one in the cost of a workload, net of the cost of the
+ * serialized TSC reads themselves. Only the CipherId enum is used, so
+ * the module links without the CIPHER front-end.
+ *
+ */
+
+#include <string.h>
+
+#include "PROFILE.h"
+
+#define CALIBRATION_ROUNDS 10001
+
+typedef struct
+{
+	const char* name;
+	CipherId cipher;
+	const char* cipherName;
+} ProfileSectionInfo;
+
+static const ProfileSectionInfo sections[PROFILE_COUNT] =
+{
+	{ "A (diffusion)", CIPHER_ARIA, "ARIA" },
+	{ "F", CIPHER_CAMELLIA, "CAMELLIA" },
+	{ "FL", CIPHER_CAMELLIA, "CAMELLIA" },
+	{ "FLINV", CIPHER_CAMELLIA, "CAMELLIA" },
+	{ "GOST_round", CIPHER_GOST, "GOST" },
+	{ "mul", CIPHER_IDEA, "IDEA" },
+	{ "permutation loop", CIPHER_PRESENT, "PRESENT" },
+	{ "G", CIPHER_SEED, "SEED" }
+};
+
+ProfileCounter PROFILE_counters[PROFILE_COUNT];
+
+int PROFILE_enabled(void)
+{
+#ifdef CIPHER_PROFILE
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+uint64_t PROFILE_timestamp(void)
+{
+#ifdef CIPHER_PROFILE
+	return PROFILE_begin();
+#else
+	return 0;
+#endif
+}
+
+const char* PROFILE_name(ProfileSection section)
+{
+	return (unsigned)section < PROFILE_COUNT ? sections[section].name : NULL;
+}
+
+CipherId PROFILE_cipher(ProfileSection section)
+{
+	return (unsigned)section < PROFILE_COUNT ? sections[section].cipher : CIPHER_COUNT;
+}
+
+void PROFILE_reset(void)
+{
+	memset(PROFILE_counters, 0, sizeof(PROFILE_counters));
+}
+
+uint64_t PROFILE_overhead(void)
+{
+#ifdef CIPHER_PROFILE
+	uint64_t best = UINT64_MAX;
+	uint64_t start;
+	uint64_t elapsed;
+	int i;
+
+	// minimum rather than mean, interrupts only ever add cycles
+	for (i = 0; i < CALIBRATION_ROUNDS; i++)
+	{
+		start = PROFILE_begin();
+		elapsed = PROFILE_end() - start;
+		if (elapsed < best)
+		{
+			best = elapsed;
+		}
+	}
+
+	return best;
+#else
+	return 0;
+#endif
+}
+
+void PROFILE_report(FILE* file, CipherId cipher, uint64_t totalCycles)
+{
+	uint64_t overhead = PROFILE_overhead();
+	uint64_t instrumentation = 0;
+	double net[PROFILE_COUNT];
+	double profiled = 0;
+	double total;
+	const char* name = NULL;
+	int i;
+
+	for (i = 0; i < PROFILE_COUNT; i++)
+	{
+		net[i] = 0;
+		if (sections[i].cipher == cipher && PROFILE_counters[i].calls != 0)
+		{
+			net[i] = (double)PROFILE_counters[i].cycles - (double)overhead * PROFILE_counters[i].calls;
+			if (net[i] < 0)
+			{
+				net[i] = 0;
+			}
+			instrumentation += overhead * PROFILE_counters[i].calls;
+		}
+	}
+
+	// the workload without the cost of its own measurement
+	total = (double)totalCycles - (double)instrumentation;
+
+	for (i = 0; i < PROFILE_COUNT; i++)
+	{
+		if (sections[i].cipher != cipher)
+		{
+			continue;
+		}
+
+		fprintf(file, "%-9s %-17s %12llu %12.0f %10.1f %7.1f%%\n", sections[i].cipherName, sections[i].name,
+			(unsigned long long)PROFILE_counters[i].calls, net[i],
+			PROFILE_counters[i].calls != 0 ? net[i] / PROFILE_counters[i].calls : 0,
+			total > 0 ? net[i] / total * 100 : 0);
+		profiled += net[i];
+		name = sections[i].cipherName;
+	}
+
+	// whatever is not wrapped: key additions, other layers, loads and stores
+	if (name != NULL && total > 0)
+	{
+		fprintf(file, "%-9s %-17s %12s %12.0f %10s %7.1f%%\n", name, "other", "",
+			total - profiled, "", (total - profiled) / total * 100);
+	}
+}
\ No newline at end of file
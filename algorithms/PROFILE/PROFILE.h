@@ -0,0 +1,116 @@
+/* PROFILE.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+typedef enum
+{
+	PROFILE_ARIA_A = 0,
+	PROFILE_CAMELLIA_F,
+	PROFILE_CAMELLIA_FL,
+	PROFILE_CAMELLIA_FLINV,
+	PROFILE_GOST_ROUND,
+	PROFILE_IDEA_MUL,
+	PROFILE_PRESENT_PERMUTATION,
+	PROFILE_SEED_G,
+	PROFILE_COUNT
+} ProfileSection;
+
+typedef struct
+{
+	uint64_t cycles;
+	uint64_t calls;
+} ProfileCounter;
+
+extern ProfileCounter PROFILE_counters[PROFILE_COUNT];
+
+/*
+	Profiling build only (-DCIPHER_PROFILE, make PROFILE=1): the ciphers
+	redefine their internal functions right after defining them, e.g.
+
+		#define G(x) PROFILE_CALL(PROFILE_SEED_G, G(x))
+
+	so every later call is timed (a macro is not expanded inside itself).
+	The counters are plain globals, profile a single thread at a time.
+*/
+#ifdef CIPHER_PROFILE
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+// serialized TSC reads, nothing before begin or after end leaks in the interval
+static inline uint64_t PROFILE_begin(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	uint64_t t;
+
+	_mm_lfence();
+	t = __rdtsc();
+	_mm_lfence();
+
+	return t;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static inline uint64_t PROFILE_end(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	unsigned int aux;
+	uint64_t t = __rdtscp(&aux);
+
+	_mm_lfence();
+
+	return t;
+#else
+	return PROFILE_begin();
+#endif
+}
+
+static inline void PROFILE_add(ProfileSection section, uint64_t start)
+{
+	PROFILE_counters[section].cycles += PROFILE_end() - start;
+	PROFILE_counters[section].calls++;
+}
+
+#define PROFILE_CALL(section, call) \
+	({ uint64_t profileStart = PROFILE_begin(); __typeof__(call) profileResult = (call); PROFILE_add(section, profileStart); profileResult; })
+#define PROFILE_CALL_VOID(section, call) \
+	do { uint64_t profileStart = PROFILE_begin(); call; PROFILE_add(section, profileStart); } while (0)
+#define PROFILE_BEGIN(name) uint64_t name = PROFILE_begin()
+#define PROFILE_END(section, name) PROFILE_add(section, name)
+#else
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END(section, name) ((void)0)
+#endif
+
+// 0 unless built with CIPHER_PROFILE
+int PROFILE_enabled(void);
+uint64_t PROFILE_timestamp(void);
+
+const char* PROFILE_name(ProfileSection section);
+CipherId PROFILE_cipher(ProfileSection section);
+
+void PROFILE_reset(void);
+
+// cycles of an empty begin/end pair, subtracted from every timed call
+uint64_t PROFILE_overhead(void);
+
+// each section of the cipher with its share of totalCycles, measured by the caller
+void PROFILE_report(FILE* file, CipherId cipher, uint64_t totalCycles);
\ No newline at end of file
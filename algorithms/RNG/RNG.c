@@ -0,0 +1,242 @@
+/* RNG.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Counter-based random number generator over SPECK and SIMON (as Random123,
+ * Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"). Any word
+ * of any stream is a function of (seed, stream, position) only, so
+ * skip-ahead is free, threads generate disjoint positions or streams
+ * without sharing state, and results are reproducible.
+ *
+ * Counters are generated straight into the vector lanes of the batch
+ * kernels, without the block layout of the CIPHER layer, and the outputs
+ * are converted to the requested type from an L1 sized buffer.
+ *
+ */
+
+#include <string.h>
+
+#include "RNG.h"
+
+// words generated per conversion chunk
+#define RNG_CHUNK 256
+
+static void encryptBlock(const RngContext* context, uint64_t stream, uint64_t counter, uint64_t* out)
+{
+	uint64_t block[2];
+
+	block[0] = stream;
+	block[1] = counter;
+	if (context->id == CIPHER_SPECK)
+	{
+		SPECK_encrypt((SpeckContext*)&context->cipher.speck, block, out);
+	}
+	else
+	{
+		SIMON_encrypt((SimonContext*)&context->cipher.simon, block, out);
+	}
+}
+
+CipherStatus RNG_init(RngContext* context, CipherId id, uint64_t seed, uint64_t stream, uint8_t rounds)
+{
+	uint64_t key[2];
+
+	key[0] = seed;
+	key[1] = 0;
+
+	if (id == CIPHER_SPECK)
+	{
+		SPECK_init(&context->cipher.speck, key, 128);
+		if (rounds > context->cipher.speck.nrSubkeys)
+		{
+			return CIPHER_ERROR_LENGTH;
+		}
+		if (rounds != 0)
+		{
+			context->cipher.speck.nrSubkeys = rounds;
+		}
+	}
+	else if (id == CIPHER_SIMON)
+	{
+		// the lanes kernel runs SIMON rounds by pairs
+		SIMON_init(&context->cipher.simon, key, 128);
+		if (rounds > context->cipher.simon.nrSubkeys || rounds % 2 != 0)
+		{
+			return CIPHER_ERROR_LENGTH;
+		}
+		if (rounds != 0)
+		{
+			context->cipher.simon.nrSubkeys = rounds;
+		}
+	}
+	else
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	context->id = id;
+	context->stream = stream;
+	context->position = 0;
+
+	return CIPHER_OK;
+}
+
+void RNG_set_stream(RngContext* context, uint64_t stream)
+{
+	context->stream = stream;
+	context->position = 0;
+}
+
+void RNG_seek(RngContext* context, uint64_t position)
+{
+	context->position = position;
+}
+
+void RNG_generate(const RngContext* context, uint64_t stream, uint64_t position, uint64_t* out, size_t count)
+{
+	uint64_t counter = position / 2;
+	uint64_t block[2];
+#ifdef SIMD_AVAILABLE
+	SimdU64 index;
+	SimdU64 x;
+	SimdU64 y;
+	size_t i;
+#endif
+
+	// starts with the second word of a block
+	if (position % 2 != 0 && count > 0)
+	{
+		encryptBlock(context, stream, counter++, block);
+		*out++ = block[1];
+		count--;
+	}
+
+#ifdef SIMD_AVAILABLE
+	for (i = 0; i < SIMD_LANES_64; i++)
+	{
+		index[i] = i;
+	}
+
+	while (count >= 2 * SIMD_LANES_64)
+	{
+		x = index * 0 + stream;
+		y = index + counter;
+		if (context->id == CIPHER_SPECK)
+		{
+			SPECK_encrypt_lanes(&context->cipher.speck, &x, &y);
+		}
+		else
+		{
+			SIMON_encrypt_lanes(&context->cipher.simon, &x, &y);
+		}
+
+		for (i = 0; i < SIMD_LANES_64; i++)
+		{
+			out[2 * i] = x[i];
+			out[2 * i + 1] = y[i];
+		}
+		out += 2 * SIMD_LANES_64;
+		count -= 2 * SIMD_LANES_64;
+		counter += SIMD_LANES_64;
+	}
+#endif
+
+	while (count > 0)
+	{
+		encryptBlock(context, stream, counter++, block);
+		*out++ = block[0];
+		count--;
+		if (count > 0)
+		{
+			*out++ = block[1];
+			count--;
+		}
+	}
+}
+
+uint64_t RNG_next(RngContext* context)
+{
+	uint64_t block[2];
+
+	encryptBlock(context, context->stream, context->position / 2, block);
+
+	return block[context->position++ % 2];
+}
+
+void RNG_fill_u64(RngContext* context, uint64_t* out, size_t count)
+{
+	RNG_generate(context, context->stream, context->position, out, count);
+	context->position += count;
+}
+
+void RNG_fill_u32(RngContext* context, uint32_t* out, size_t count)
+{
+	uint64_t words[RNG_CHUNK];
+	size_t n;
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+	size_t i;
+#endif
+
+	while (count > 0)
+	{
+		n = count < 2 * RNG_CHUNK ? count : 2 * RNG_CHUNK;
+		RNG_fill_u64(context, words, (n + 1) / 2);
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		memcpy(out, words, n * sizeof(uint32_t));
+#else
+		for (i = 0; i < n; i++)
+		{
+			out[i] = (uint32_t)(words[i / 2] >> (i % 2 * 32));
+		}
+#endif
+
+		out += n;
+		count -= n;
+	}
+}
+
+void RNG_fill_double(RngContext* context, double* out, size_t count)
+{
+	uint64_t words[RNG_CHUNK];
+	size_t n;
+	size_t i;
+
+	while (count > 0)
+	{
+		n = count < RNG_CHUNK ? count : RNG_CHUNK;
+		RNG_fill_u64(context, words, n);
+
+		// top 53 bits, times 2^-53 (signed conversions are the cheap ones)
+		for (i = 0; i < n; i++)
+		{
+			out[i] = (double)(int64_t)(words[i] >> 11) * (1.0 / 9007199254740992.0);
+		}
+
+		out += n;
+		count -= n;
+	}
+}
+
+void RNG_fill_float(RngContext* context, float* out, size_t count)
+{
+	uint32_t values[2 * RNG_CHUNK];
+	size_t n;
+	size_t i;
+
+	while (count > 0)
+	{
+		n = count < 2 * RNG_CHUNK ? count : 2 * RNG_CHUNK;
+		RNG_fill_u32(context, values, n);
+
+		// top 24 bits, times 2^-24
+		for (i = 0; i < n; i++)
+		{
+			out[i] = (float)(int32_t)(values[i] >> 8) * (1.0f / 16777216.0f);
+		}
+
+		out += n;
+		count -= n;
+	}
+}
\ No newline at end of file
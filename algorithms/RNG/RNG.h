@@ -0,0 +1,62 @@
+/* RNG.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+#include "../SIMON/SIMON.h"
+#include "../SPECK/SPECK.h"
+
+/*
+	Counter-based generator: block i of stream s is the encryption of the
+	words (s, i) under the 128 bits key (seed, 0), and the stream is the
+	sequence of 64 bits words x0, y0, x1, y1, ... of these blocks.
+*/
+typedef struct
+{
+	CipherId id;
+	union
+	{
+		SpeckContext speck;
+		SimonContext simon;
+	} cipher;
+	uint64_t stream;
+	// next word of the stream
+	uint64_t position;
+} RngContext;
+
+/*
+	CIPHER_SPECK or CIPHER_SIMON (CIPHER_ERROR_ID otherwise). rounds is 0
+	for the full cipher, or a reduced number of rounds (up to 32 for SPECK,
+	an even number up to 68 for SIMON; CIPHER_ERROR_LENGTH otherwise).
+*/
+CipherStatus RNG_init(RngContext* context, CipherId id, uint64_t seed, uint64_t stream, uint8_t rounds);
+
+// switches to the start of another substream of the same seed
+void RNG_set_stream(RngContext* context, uint64_t stream);
+// skip-ahead, in O(1): the next word is word position of the stream
+void RNG_seek(RngContext* context, uint64_t position);
+
+uint64_t RNG_next(RngContext* context);
+
+/*
+	Bulk fills from the current position, which advances by the words
+	used: one per uint64_t and double (53 bits), one per two uint32_t and
+	floats (24 bits, low half first; an odd count leaves the last high half
+	unused). Floating point values are uniform in [0, 1).
+*/
+void RNG_fill_u64(RngContext* context, uint64_t* out, size_t count);
+void RNG_fill_u32(RngContext* context, uint32_t* out, size_t count);
+void RNG_fill_double(RngContext* context, double* out, size_t count);
+void RNG_fill_float(RngContext* context, float* out, size_t count);
+
+// count words of any stream of the seed from any position, without state: any thread may call it
+void RNG_generate(const RngContext* context, uint64_t stream, uint64_t position, uint64_t* out, size_t count);
\ No newline at end of file
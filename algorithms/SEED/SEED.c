@@ -17,8 +17,11 @@
  */
 
 #include "SEED.h"
+#include "../PROFILE/PROFILE.h"
 
 #define NR_ROUNDS 16
+// keys interleaved by SEED_init_many
+#define INIT_GROUP 8
 
 static const uint32_t KC[16] =
 {
@@ -187,6 +190,10 @@ static uint32_t G(uint32_t x)
 	return ss0[x & 0xFF] ^ ss1[(x >> 8) & 0xFF] ^ ss2[(x >> 16) & 0xFF] ^ ss3[(x >> 24) & 0xFF];
 }
 
+#ifdef CIPHER_PROFILE
+#define G(x) PROFILE_CALL(PROFILE_SEED_G, G(x))
+#endif
+
 // Diffusion layer
 static void F(uint32_t R0, uint32_t R1,
 			  uint32_t Ki0, uint32_t Ki1,
@@ -230,6 +237,42 @@ void SEED_init(SeedContext* context, uint32_t* key)
 	}
 }
 
+/*
+	count key schedules, INIT_GROUP keys interleaved: each step computes
+	the two subkeys of a round for every key of the group, so their G()
+	lookups are independent. The subkeys come from the words of the key as
+	given, as in SEED_init (whose rotations of key[] add up to 64 bits and
+	leave it unchanged).
+*/
+void SEED_init_many(SeedContext** contexts, const uint32_t* keys, size_t count)
+{
+	uint32_t sum[INIT_GROUP];
+	uint32_t difference[INIT_GROUP];
+	size_t n;
+	size_t l;
+	int i;
+
+	for (; count > 0; count -= n, contexts += n, keys += n * 4)
+	{
+		n = count < INIT_GROUP ? count : INIT_GROUP;
+
+		for (l = 0; l < n; l++)
+		{
+			sum[l] = keys[4 * l] + keys[4 * l + 2];
+			difference[l] = keys[4 * l + 1] - keys[4 * l + 3];
+		}
+
+		for (i = 0; i < 16; i++)
+		{
+			for (l = 0; l < n; l++)
+			{
+				contexts[l]->subkeys[i * 2] = G(sum[l] - KC[i]);
+				contexts[l]->subkeys[i * 2 + 1] = G(difference[l] + KC[i]);
+			}
+		}
+	}
+}
+
 void SEED_encrypt(SeedContext* context, uint32_t* block, uint32_t* out)
 {
 	int i;
@@ -324,6 +367,21 @@ void SEED_decrypt(SeedContext* context, uint32_t* block, uint32_t* out)
 	out[3] = r1;
 }
 
+// G() reads ss0..ss3, returns the size of the table or 0 past the last one
+size_t SEED_lookup_table(int index, const void** address)
+{
+	static const void* tables[4] = { ss0, ss1, ss2, ss3 };
+	static const size_t sizes[4] = { sizeof(ss0), sizeof(ss1), sizeof(ss2), sizeof(ss3) };
+
+	if (index < 0 || index >= 4)
+	{
+		return 0;
+	}
+
+	*address = tables[index];
+	return sizes[index];
+}
+
 void SEED_main(void)
 {
 	SeedContext context;
@@ -16,7 +16,10 @@ typedef struct
 } SeedContext;
 
 void SEED_init(SeedContext* context, uint32_t* key);
+// count keys of 4 words one after the other, same as SEED_init on each
+void SEED_init_many(SeedContext** contexts, const uint32_t* keys, size_t count);
 void SEED_encrypt(SeedContext* context, uint32_t* block, uint32_t* out);
 void SEED_decrypt(SeedContext* context, uint32_t* block, uint32_t* out);
+size_t SEED_lookup_table(int index, const void** address);
 
 void SEED_main(void);
\ No newline at end of file
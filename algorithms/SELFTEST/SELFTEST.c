@@ -0,0 +1,236 @@
+/* SELFTEST.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Silent power-on self-test of the ciphers: the known answers of the
+ * *_main functions, checked through the CIPHER descriptors (so every
+ * kernel is covered) without printing anything.
+ *
+ */
+
+#include <string.h>
+
+#include "SELFTEST.h"
+
+// blocks of the batch checked per kernel: lanes + 1, at most this
+#define MAX_BATCH 64
+// blocks of the key-agile check: 9 keys of one block, then 3 keys of 3 blocks
+#define KEYED_BLOCKS 9
+
+// 0 untested, 1 passed, -1 failed
+static int8_t results[CIPHER_COUNT];
+
+static const SelftestVector vectors[] =
+{
+	{ CIPHER_ARIA, 128, "000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff", "d718fbd6ab644c739da95f3be6451778" },
+	{ CIPHER_ARIA, 192, "000102030405060708090a0b0c0d0e0f1011121314151617", "00112233445566778899aabbccddeeff", "26449c1805dbe7aa25a468ce263a9e79" },
+	{ CIPHER_ARIA, 256, "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", "00112233445566778899aabbccddeeff", "f92bd7c79fb72e2f2b8f80c1972d24fc" },
+	{ CIPHER_CAMELLIA, 128, "0123456789abcdeffedcba9876543210", "0123456789abcdeffedcba9876543210", "67673138549669730857065648eabe43" },
+	{ CIPHER_CAMELLIA, 192, "0123456789abcdeffedcba98765432100011223344556677", "0123456789abcdeffedcba9876543210", "b4993401b3e996f84ee5cee7d79b09b9" },
+	{ CIPHER_CAMELLIA, 256, "0123456789abcdeffedcba987654321000112233445566778899aabbccddeeff", "0123456789abcdeffedcba9876543210", "9acc237dff16d76c20ef7c919e3a7509" },
+	{ CIPHER_GOST, 256, "0000000001000000020000000300000004000000050000000600000007000000", "59f69c7f1b000000", "4bca243a07c1b92a" },
+	{ CIPHER_HIGHT, 128, "00112233445566778899aabbccddeeff", "0000000000000000", "ca4cb60291ff8131" },
+	{ CIPHER_IDEA, 128, "00010002000300040005000600070008", "0000000100020003", "11fbed2b01986de5" },
+	{ CIPHER_NOEKEON, 128, "000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff", "bc0f896c2f202862871805418ce171bf" },
+	{ CIPHER_PRESENT, 80, "00000000000000000000", "0000000000000000", "5579c1387b228445" },
+	{ CIPHER_PRESENT, 128, "00000000000000000000000000000000", "0000000000000000", "04bdd5f4eaefcc19" },
+	{ CIPHER_SEED, 128, "00000000000000000000000000000000", "000102030405060708090a0b0c0d0e0f", "5ebac6e0054e166819aff1cc6d346cdb" },
+	{ CIPHER_SIMON, 128, "0f0e0d0c0b0a09080706050403020100", "63736564207372656c6c657661727420", "49681b1e1e54fe3f65aa832af84e0bbc" },
+	{ CIPHER_SIMON, 192, "17161514131211100f0e0d0c0b0a09080706050403020100", "206572656874206e6568772065626972", "c4ac61effcdc0d4f6c9c8d6e2597b85b" },
+	{ CIPHER_SIMON, 256, "1f1e1d1c1b1a191817161514131211100f0e0d0c0b0a09080706050403020100", "74206e69206d6f6f6d69732061207369", "8d2b5579afc8a3a03bf72a87efe7b868" },
+	{ CIPHER_SPECK, 128, "0f0e0d0c0b0a09080706050403020100", "6c617669757165207469206564616d20", "a65d9851797832657860fedf5c570d18" },
+	{ CIPHER_SPECK, 192, "17161514131211100f0e0d0c0b0a09080706050403020100", "726148206665696843206f7420746e65", "1be4cf3a13135566f9bc185de03c1886" },
+	{ CIPHER_SPECK, 256, "1f1e1d1c1b1a191817161514131211100f0e0d0c0b0a09080706050403020100", "65736f6874206e49202e72656e6f6f70", "4109010405c0f53e4eeeb48d9c188f43" }
+};
+
+static uint8_t hexDigit(char c)
+{
+	return (uint8_t)(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+}
+
+static void fromHex(const char* hex, uint8_t* out)
+{
+	for (; hex[0] != 0; hex += 2)
+	{
+		*out++ = (uint8_t)(hexDigit(hex[0]) << 4 | hexDigit(hex[1]));
+	}
+}
+
+// every block of the batch equal to block
+static int allEqual(const uint8_t* batch, size_t nrBlocks, const uint8_t* block, size_t blockSize)
+{
+	size_t i;
+
+	for (i = 0; i < nrBlocks; i++)
+	{
+		if (memcmp(batch + i * blockSize, block, blockSize) != 0)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int checkVector(const CipherDescriptor* cipher, const SelftestVector* vector)
+{
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	uint8_t plaintext[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t ciphertext[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t out[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t batch[MAX_BATCH * CIPHER_MAX_BLOCK_SIZE];
+	uint8_t keys[KEYED_BLOCKS * CIPHER_MAX_KEY_SIZE];
+	CipherContext context;
+	size_t blockSize = cipher->blockSize;
+	size_t nrBlocks;
+	size_t i;
+	int k;
+
+	fromHex(vector->plaintext, plaintext);
+	fromHex(vector->ciphertext, ciphertext);
+
+	// encryption-only schedule (the key is decoded again, SEED_init modifies it)
+	fromHex(vector->key, key);
+	cipher->initEncrypt(&context.u, key, vector->keyLen);
+	cipher->encrypt(&context.u, plaintext, out);
+	if (memcmp(out, ciphertext, blockSize) != 0)
+	{
+		return 0;
+	}
+
+	fromHex(vector->key, key);
+	cipher->init(&context.u, key, vector->keyLen);
+	cipher->encrypt(&context.u, plaintext, out);
+	if (memcmp(out, ciphertext, blockSize) != 0)
+	{
+		return 0;
+	}
+	cipher->decrypt(&context.u, ciphertext, out);
+	if (memcmp(out, plaintext, blockSize) != 0)
+	{
+		return 0;
+	}
+
+	for (k = 0; k < cipher->nrKernels; k++)
+	{
+		const CipherKernel* kernel = &cipher->kernels[k];
+
+		nrBlocks = kernel->lanes + 1 < MAX_BATCH ? kernel->lanes + 1 : MAX_BATCH;
+		for (i = 0; i < nrBlocks; i++)
+		{
+			memcpy(batch + i * blockSize, plaintext, blockSize);
+		}
+
+		kernel->encryptBlocks(&context.u, batch, batch, nrBlocks);
+		if (!allEqual(batch, nrBlocks, ciphertext, blockSize))
+		{
+			return 0;
+		}
+
+		kernel->decryptBlocks(&context.u, batch, batch, nrBlocks);
+		if (!allEqual(batch, nrBlocks, plaintext, blockSize))
+		{
+			return 0;
+		}
+	}
+
+	if (cipher->encryptKeyed != NULL)
+	{
+		for (i = 0; i < KEYED_BLOCKS; i++)
+		{
+			fromHex(vector->key, keys + i * (vector->keyLen / 8));
+			memcpy(batch + i * blockSize, plaintext, blockSize);
+		}
+
+		cipher->encryptKeyed(keys, vector->keyLen, batch, batch, KEYED_BLOCKS, 1);
+		if (!allEqual(batch, KEYED_BLOCKS, ciphertext, blockSize))
+		{
+			return 0;
+		}
+
+		for (i = 0; i < KEYED_BLOCKS; i++)
+		{
+			memcpy(batch + i * blockSize, plaintext, blockSize);
+		}
+
+		cipher->encryptKeyed(keys, vector->keyLen, batch, batch, 3, 3);
+		if (!allEqual(batch, KEYED_BLOCKS, ciphertext, blockSize))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+const SelftestVector* SELFTEST_vectors(int* count)
+{
+	*count = sizeof(vectors) / sizeof(vectors[0]);
+
+	return vectors;
+}
+
+CipherStatus SELFTEST_run(CipherId id)
+{
+	const CipherDescriptor* cipher = CIPHER_get(id);
+	size_t i;
+
+	if (cipher == NULL)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+	{
+		if (vectors[i].id == id && !checkVector(cipher, &vectors[i]))
+		{
+			return CIPHER_ERROR_SELFTEST;
+		}
+	}
+
+	return CIPHER_OK;
+}
+
+CipherStatus SELFTEST_cipher(CipherId id)
+{
+	int8_t result;
+
+	if ((unsigned int)id >= CIPHER_COUNT)
+	{
+		return CIPHER_ERROR_ID;
+	}
+
+	// threads racing on the first use both run the tests, with the same result
+	result = __atomic_load_n(&results[id], __ATOMIC_ACQUIRE);
+	if (result == 0)
+	{
+		result = SELFTEST_run(id) == CIPHER_OK ? 1 : -1;
+		__atomic_store_n(&results[id], result, __ATOMIC_RELEASE);
+	}
+
+	return result > 0 ? CIPHER_OK : CIPHER_ERROR_SELFTEST;
+}
+
+CipherStatus SELFTEST_all(void)
+{
+	CipherStatus status = CIPHER_OK;
+	int i;
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		if (SELFTEST_cipher(i) != CIPHER_OK)
+		{
+			status = CIPHER_ERROR_SELFTEST;
+		}
+	}
+
+	return status;
+}
+
+#ifdef CIPHER_SELFTEST_AT_LOAD
+__attribute__((constructor)) static void selftestAtLoad(void)
+{
+	SELFTEST_all();
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+/* SELFTEST.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+// known answer, byte strings in hex as in the *_main functions
+typedef struct
+{
+	CipherId id;
+	uint16_t keyLen;
+	const char* key;
+	const char* plaintext;
+	const char* ciphertext;
+} SelftestVector;
+
+const SelftestVector* SELFTEST_vectors(int* count);
+
+/*
+	Known answer tests of a cipher: every vector through the full and the
+	encryption-only key schedules and through every kernel, encrypting and
+	decrypting a batch of lanes + 1 blocks. No I/O, no allocation, a few
+	microseconds per cipher. Returns CIPHER_OK or CIPHER_ERROR_SELFTEST.
+*/
+CipherStatus SELFTEST_run(CipherId id);
+
+/*
+	Same as SELFTEST_run, but only the first call per cipher runs the
+	tests, later ones return the cached result. CIPHER_init and
+	CIPHER_init_encrypt call it, so a cipher is tested the first time it
+	is used (unless built with -DCIPHER_NO_SELFTEST).
+*/
+CipherStatus SELFTEST_cipher(CipherId id);
+
+// tests every cipher at once, e.g. at startup; -DCIPHER_SELFTEST_AT_LOAD runs it before main
+CipherStatus SELFTEST_all(void);
\ No newline at end of file
@@ -0,0 +1,282 @@
+/* SIMD.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Portable vector layer over the GCC/Clang vector extensions, used by
+ * the batch ("lanes") kernels of the ciphers. Each lane holds the word
+ * of a different block, so a round is written once, as in the scalar
+ * code, and the compiler maps it to SSE2/AVX2/AVX-512, NEON, ... or to
+ * plain scalar code on targets without vectors.
+ *
+ * The width follows the target (16 bytes, 32 with AVX2, 64 with
+ * AVX-512F) and can be forced with -DSIMD_BYTES=N (a power of two).
+ * Other compilers get no SIMD_AVAILABLE and the ciphers keep their
+ * reference kernel only.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_AVAILABLE
+
+#ifndef SIMD_BYTES
+#if defined(__AVX512F__)
+#define SIMD_BYTES 64
+#elif defined(__AVX2__)
+#define SIMD_BYTES 32
+#else
+#define SIMD_BYTES 16
+#endif
+#endif
+
+typedef uint8_t SimdU8 __attribute__((vector_size(SIMD_BYTES)));
+typedef uint16_t SimdU16 __attribute__((vector_size(SIMD_BYTES)));
+typedef uint32_t SimdU32 __attribute__((vector_size(SIMD_BYTES)));
+typedef uint64_t SimdU64 __attribute__((vector_size(SIMD_BYTES)));
+
+// number of lanes of each element size
+#define SIMD_LANES_8 (SIMD_BYTES)
+#define SIMD_LANES_16 (SIMD_BYTES / 2)
+#define SIMD_LANES_32 (SIMD_BYTES / 4)
+#define SIMD_LANES_64 (SIMD_BYTES / 8)
+
+// rotations by a constant, 0 < n < element bits
+
+static inline SimdU8 SIMD_rol8(SimdU8 x, int n)
+{
+	return x << n | x >> (8 - n);
+}
+
+static inline SimdU16 SIMD_rol16(SimdU16 x, int n)
+{
+	return x << n | x >> (16 - n);
+}
+
+static inline SimdU32 SIMD_rol32(SimdU32 x, int n)
+{
+	return x << n | x >> (32 - n);
+}
+
+static inline SimdU32 SIMD_ror32(SimdU32 x, int n)
+{
+	return x >> n | x << (32 - n);
+}
+
+static inline SimdU64 SIMD_rol64(SimdU64 x, int n)
+{
+	return x << n | x >> (64 - n);
+}
+
+static inline SimdU64 SIMD_ror64(SimdU64 x, int n)
+{
+	return x >> n | x << (64 - n);
+}
+
+// lanes of a where mask is all ones, of b where it is zero (masks come from comparisons)
+static inline SimdU32 SIMD_select32(SimdU32 mask, SimdU32 a, SimdU32 b)
+{
+	return (a & mask) | (b & ~mask);
+}
+
+// byte i of the result is byte indices[i] of x (indices below SIMD_BYTES)
+static inline SimdU8 SIMD_shuffle8(SimdU8 x, SimdU8 indices)
+{
+#if defined(__clang__)
+	SimdU8 r;
+	int i;
+
+	// clang only has constant shuffles on generic vectors
+	for (i = 0; i < SIMD_BYTES; i++)
+	{
+		r[i] = x[indices[i] & (SIMD_BYTES - 1)];
+	}
+
+	return r;
+#else
+	return __builtin_shuffle(x, indices);
+#endif
+}
+
+// reverses the bytes of each element of the given size (2, 4 or 8)
+static inline SimdU8 SIMD_bswap(SimdU8 x, int size)
+{
+	SimdU8 indices;
+	int i;
+
+	for (i = 0; i < SIMD_BYTES; i++)
+	{
+		indices[i] = (uint8_t)(i ^ (size - 1));
+	}
+
+	return SIMD_shuffle8(x, indices);
+}
+
+/*
+	Transposes between blocks and lanes. A load puts word j of block i in
+	lane i of x[j] (words read big-endian, as by the CIPHER layer), for
+	count <= lanes consecutive blocks of nrWords words (at most 4);
+	missing lanes are zero. A store writes back the first count lanes.
+	Loads go through a generic element transpose the compiler vectorizes
+	and a byte shuffle.
+*/
+
+static inline void SIMD_load_be64(SimdU64* x, int nrWords, const uint8_t* in, size_t count)
+{
+	uint64_t words[4 * SIMD_LANES_64] = { 0 };
+	SimdU8 bytes;
+	size_t i;
+	int j;
+
+	memcpy(words, in, count * nrWords * 8);
+	for (j = 0; j < nrWords; j++)
+	{
+		for (i = 0; i < SIMD_LANES_64; i++)
+		{
+			x[j][i] = words[i * nrWords + j];
+		}
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		memcpy(&bytes, &x[j], SIMD_BYTES);
+		bytes = SIMD_bswap(bytes, 8);
+		memcpy(&x[j], &bytes, SIMD_BYTES);
+#endif
+	}
+}
+
+static inline void SIMD_store_be64(const SimdU64* x, int nrWords, uint8_t* out, size_t count)
+{
+	uint64_t words[4 * SIMD_LANES_64];
+	SimdU64 w;
+	SimdU8 bytes;
+	size_t i;
+	int j;
+
+	for (j = 0; j < nrWords; j++)
+	{
+		w = x[j];
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		memcpy(&bytes, &w, SIMD_BYTES);
+		bytes = SIMD_bswap(bytes, 8);
+		memcpy(&w, &bytes, SIMD_BYTES);
+#endif
+		for (i = 0; i < SIMD_LANES_64; i++)
+		{
+			words[i * nrWords + j] = w[i];
+		}
+	}
+	memcpy(out, words, count * nrWords * 8);
+}
+
+static inline void SIMD_load_be32(SimdU32* x, int nrWords, const uint8_t* in, size_t count)
+{
+	uint32_t words[4 * SIMD_LANES_32] = { 0 };
+	SimdU8 bytes;
+	size_t i;
+	int j;
+
+	memcpy(words, in, count * nrWords * 4);
+	for (j = 0; j < nrWords; j++)
+	{
+		for (i = 0; i < SIMD_LANES_32; i++)
+		{
+			x[j][i] = words[i * nrWords + j];
+		}
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		memcpy(&bytes, &x[j], SIMD_BYTES);
+		bytes = SIMD_bswap(bytes, 4);
+		memcpy(&x[j], &bytes, SIMD_BYTES);
+#endif
+	}
+}
+
+static inline void SIMD_store_be32(const SimdU32* x, int nrWords, uint8_t* out, size_t count)
+{
+	uint32_t words[4 * SIMD_LANES_32];
+	SimdU32 w;
+	SimdU8 bytes;
+	size_t i;
+	int j;
+
+	for (j = 0; j < nrWords; j++)
+	{
+		w = x[j];
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		memcpy(&bytes, &w, SIMD_BYTES);
+		bytes = SIMD_bswap(bytes, 4);
+		memcpy(&w, &bytes, SIMD_BYTES);
+#endif
+		for (i = 0; i < SIMD_LANES_32; i++)
+		{
+			words[i * nrWords + j] = w[i];
+		}
+	}
+	memcpy(out, words, count * nrWords * 4);
+}
+
+// 16 bits big-endian words widened to 32 bits lanes, for products that need 32 bits
+static inline void SIMD_load_be16(SimdU32* x, int nrWords, const uint8_t* in, size_t count)
+{
+	size_t i;
+	int j;
+
+	for (j = 0; j < nrWords; j++)
+	{
+		for (i = 0; i < SIMD_LANES_32; i++)
+		{
+			const uint8_t* p = in + (i * nrWords + j) * 2;
+
+			x[j][i] = i < count ? (uint32_t)(p[0] << 8 | p[1]) : 0;
+		}
+	}
+}
+
+static inline void SIMD_store_be16(const SimdU32* x, int nrWords, uint8_t* out, size_t count)
+{
+	size_t i;
+	int j;
+
+	for (i = 0; i < count; i++)
+	{
+		for (j = 0; j < nrWords; j++)
+		{
+			out[(i * nrWords + j) * 2] = (uint8_t)(x[j][i] >> 8);
+			out[(i * nrWords + j) * 2 + 1] = (uint8_t)x[j][i];
+		}
+	}
+}
+
+// byte j of block i in lane i of x[j]
+static inline void SIMD_load_8(SimdU8* x, int nrBytes, const uint8_t* in, size_t count)
+{
+	size_t i;
+	int j;
+
+	for (j = 0; j < nrBytes; j++)
+	{
+		for (i = 0; i < SIMD_LANES_8; i++)
+		{
+			x[j][i] = i < count ? in[i * nrBytes + j] : 0;
+		}
+	}
+}
+
+static inline void SIMD_store_8(const SimdU8* x, int nrBytes, uint8_t* out, size_t count)
+{
+	size_t i;
+	int j;
+
+	for (i = 0; i < count; i++)
+	{
+		for (j = 0; j < nrBytes; j++)
+		{
+			out[i * nrBytes + j] = x[j][i];
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -172,6 +172,129 @@ void SIMON_decrypt(SimonContext* context, uint64_t* block, uint64_t* out)
 	out[1] = y;
 }
 
+#ifdef SIMD_AVAILABLE
+static SimdU64 fLanes(SimdU64 x)
+{
+	return (SIMD_rol64(x, 1) & SIMD_rol64(x, 8)) ^ SIMD_rol64(x, 2);
+}
+
+void SIMON_encrypt_lanes(const SimonContext* context, SimdU64* x, SimdU64* y)
+{
+	SimdU64 a = *x;
+	SimdU64 b = *y;
+	uint8_t i;
+
+	// the 69 rounds of the 192 bits key end with a single round and a swap
+	for (i = 0; i + 1 < context->nrSubkeys; i += 2)
+	{
+		b ^= fLanes(a) ^ context->subkeys[i];
+		a ^= fLanes(b) ^ context->subkeys[i + 1];
+	}
+
+	if (context->nrSubkeys == 69)
+	{
+		b ^= fLanes(a) ^ context->subkeys[68];
+		*x = b;
+		*y = a;
+		return;
+	}
+
+	*x = a;
+	*y = b;
+}
+
+void SIMON_decrypt_lanes(const SimonContext* context, SimdU64* x, SimdU64* y)
+{
+	SimdU64 a = *x;
+	SimdU64 b = *y;
+	int i = context->nrSubkeys - 1;
+
+	if (context->nrSubkeys == 69)
+	{
+		a = *y;
+		b = *x ^ fLanes(a) ^ context->subkeys[68];
+		i = 67;
+	}
+
+	for (; i >= 0; i -= 2)
+	{
+		a ^= fLanes(b) ^ context->subkeys[i];
+		b ^= fLanes(a) ^ context->subkeys[i - 1];
+	}
+
+	*x = a;
+	*y = b;
+}
+#endif
+
+#if defined(SIMD_AVAILABLE) && SIMD_LANES_64 >= 4
+/*
+	count key schedules, SIMD_LANES_64 at a time: lane l runs the schedule
+	of key l, as SIMON_init, and its subkeys are then copied to contexts[l].
+	The constant bit of subkey i is bit i - m of z, past the 64 bits of z
+	it is taken from tail (the last subkeys of SIMON_init).
+*/
+void SIMON_init_many(SimonContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count)
+{
+	const uint64_t c = 0xfffffffffffffffcLL;
+	int m = keyLen / 64;
+	int nrSubkeys = m == 2 ? 68 : (m == 3 ? 69 : 72);
+	uint64_t z = m == 2 ? 0x7369f885192c0ef5LL : (m == 3 ? 0xfc2ce51207a635dbLL : 0xfdc94c3a046d678bLL);
+	uint64_t tail = m == 2 ? 1 : 2;
+	SimdU64 subkeys[72];
+	SimdU64 t;
+	uint64_t bit;
+	size_t n;
+	size_t l;
+	int i;
+
+	for (; count > 0; count -= n, contexts += n, keys += n * m)
+	{
+		n = count < SIMD_LANES_64 ? count : SIMD_LANES_64;
+
+		for (i = 0; i < m; i++)
+		{
+			for (l = 0; l < SIMD_LANES_64; l++)
+			{
+				subkeys[i][l] = l < n ? keys[l * m + m - 1 - i] : 0;
+			}
+		}
+
+		for (i = m; i < nrSubkeys; i++)
+		{
+			bit = i - m < 64 ? z >> (i - m) & 1 : tail >> (i - m - 64) & 1;
+
+			t = SIMD_ror64(subkeys[i - 1], 3);
+			if (m == 4)
+			{
+				t ^= subkeys[i - 3];
+			}
+			subkeys[i] = c ^ bit ^ subkeys[i - m] ^ t ^ SIMD_ror64(t, 1);
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			contexts[l]->nrSubkeys = (uint8_t)nrSubkeys;
+			for (i = 0; i < nrSubkeys; i++)
+			{
+				contexts[l]->subkeys[i] = subkeys[i][l];
+			}
+		}
+	}
+}
+#else
+// narrower vectors do not beat SIMON_init
+void SIMON_init_many(SimonContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		SIMON_init(contexts[i], (uint64_t*)keys + i * (keyLen / 64), keyLen);
+	}
+}
+#endif
+
 void SIMON_main(void)
 {
 	SimonContext context;
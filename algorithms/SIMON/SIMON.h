@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include "../SIMD/SIMD.h"
+
 typedef struct
 {
 	uint8_t nrSubkeys;
@@ -19,5 +21,13 @@ typedef struct
 void SIMON_init(SimonContext* context, uint64_t* key, uint16_t keyLen);
 void SIMON_encrypt(SimonContext* context, uint64_t* block, uint64_t* out);
 void SIMON_decrypt(SimonContext* context, uint64_t* block, uint64_t* out);
+// count keys of keyLen / 64 words one after the other, same as SIMON_init on each
+void SIMON_init_many(SimonContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count);
+
+#ifdef SIMD_AVAILABLE
+// SIMD_LANES_64 blocks at once, word 0 of every block in x and word 1 in y
+void SIMON_encrypt_lanes(const SimonContext* context, SimdU64* x, SimdU64* y);
+void SIMON_decrypt_lanes(const SimonContext* context, SimdU64* x, SimdU64* y);
+#endif
 
 void SIMON_main(void);
\ No newline at end of file
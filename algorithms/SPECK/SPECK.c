@@ -136,6 +136,243 @@ void SPECK_decrypt(SpeckContext* context, uint64_t* block, uint64_t* out)
 	out[1] = y;
 }
 
+/*
+	SPECK_init and SPECK_encrypt under the key without a context: the key
+	schedule runs alongside the rounds, each subkey used as soon as it is
+	computed.
+*/
+void SPECK_encrypt_keyed(const uint64_t* key, uint16_t keyLen, const uint64_t* block, uint64_t* out)
+{
+	int nrWords = keyLen / 64;
+	int nrRounds = 30 + nrWords;
+	uint64_t A = key[nrWords - 1];
+	uint64_t B = key[nrWords - 2];
+	uint64_t C = nrWords > 2 ? key[nrWords - 3] : 0;
+	uint64_t D = nrWords > 3 ? key[0] : 0;
+	uint64_t x = block[0];
+	uint64_t y = block[1];
+	uint64_t temp;
+	int i;
+
+	for (i = 0; i < nrRounds; i++)
+	{
+		R(&x, &y, A);
+
+		// the key word of the next round moves to B
+		R(&B, &A, i);
+		if (nrWords == 3)
+		{
+			temp = B;
+			B = C;
+			C = temp;
+		}
+		else if (nrWords == 4)
+		{
+			temp = B;
+			B = C;
+			C = D;
+			D = temp;
+		}
+	}
+
+	out[0] = x;
+	out[1] = y;
+}
+
+#ifdef SIMD_AVAILABLE
+void SPECK_encrypt_lanes(const SpeckContext* context, SimdU64* x, SimdU64* y)
+{
+	SimdU64 a = *x;
+	SimdU64 b = *y;
+	uint8_t i;
+
+	for (i = 0; i < context->nrSubkeys; i++)
+	{
+		a = SIMD_ror64(a, 8);
+		a += b;
+		a ^= context->subkeys[i];
+		b = SIMD_rol64(b, 3);
+		b ^= a;
+	}
+
+	*x = a;
+	*y = b;
+}
+
+void SPECK_decrypt_lanes(const SpeckContext* context, SimdU64* x, SimdU64* y)
+{
+	SimdU64 a = *x;
+	SimdU64 b = *y;
+	int i;
+
+	for (i = context->nrSubkeys - 1; i >= 0; i--)
+	{
+		b ^= a;
+		b = SIMD_ror64(b, 3);
+		a ^= context->subkeys[i];
+		a -= b;
+		a = SIMD_rol64(a, 8);
+	}
+
+	*x = a;
+	*y = b;
+}
+
+// SPECK_encrypt_keyed of SIMD_LANES_64 blocks, each under the key words of its lane
+void SPECK_encrypt_keyed_lanes(const SimdU64* key, uint16_t keyLen, SimdU64* x, SimdU64* y)
+{
+	int nrWords = keyLen / 64;
+	int nrRounds = 30 + nrWords;
+	SimdU64 A = key[nrWords - 1];
+	SimdU64 B = key[nrWords - 2];
+	SimdU64 C = nrWords > 2 ? key[nrWords - 3] : A;
+	SimdU64 D = nrWords > 3 ? key[0] : A;
+	SimdU64 a = *x;
+	SimdU64 b = *y;
+	SimdU64 temp;
+	int i;
+
+	for (i = 0; i < nrRounds; i++)
+	{
+		a = SIMD_ror64(a, 8);
+		a += b;
+		a ^= A;
+		b = SIMD_rol64(b, 3);
+		b ^= a;
+
+		B = SIMD_ror64(B, 8);
+		B += A;
+		B ^= (uint64_t)i;
+		A = SIMD_rol64(A, 3);
+		A ^= B;
+		if (nrWords == 3)
+		{
+			temp = B;
+			B = C;
+			C = temp;
+		}
+		else if (nrWords == 4)
+		{
+			temp = B;
+			B = C;
+			C = D;
+			D = temp;
+		}
+	}
+
+	*x = a;
+	*y = b;
+}
+#endif
+
+#if defined(SIMD_AVAILABLE) && SIMD_LANES_64 >= 4
+static void RLanes(SimdU64* x, SimdU64* y, uint64_t k)
+{
+	*x = SIMD_ror64(*x, 8);
+	*x += *y;
+	*x ^= k;
+	*y = SIMD_rol64(*y, 3);
+	*y ^= *x;
+}
+
+/*
+	count key schedules, SIMD_LANES_64 at a time: lane l runs the schedule
+	of key l, as SPECK_init, and its subkeys are then copied to contexts[l].
+*/
+void SPECK_init_many(SpeckContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count)
+{
+	int nrWords = keyLen / 64;
+	int nrSubkeys = 30 + nrWords;
+	SimdU64 subkeys[34];
+	SimdU64 words[4];
+	SimdU64 A;
+	SimdU64 B;
+	SimdU64 C;
+	SimdU64 D;
+	size_t n;
+	size_t l;
+	int i;
+
+	for (; count > 0; count -= n, contexts += n, keys += n * nrWords)
+	{
+		n = count < SIMD_LANES_64 ? count : SIMD_LANES_64;
+
+		for (i = 0; i < nrWords; i++)
+		{
+			for (l = 0; l < SIMD_LANES_64; l++)
+			{
+				words[i][l] = l < n ? keys[l * nrWords + i] : 0;
+			}
+		}
+
+		if (keyLen == 128)
+		{
+			A = words[1];
+			B = words[0];
+
+			for (i = 0; i < 32; i++)
+			{
+				subkeys[i] = A;
+				RLanes(&B, &A, i);
+			}
+		}
+		else if (keyLen == 192)
+		{
+			A = words[2];
+			B = words[1];
+			C = words[0];
+
+			for (i = 0; i < 32; i += 2)
+			{
+				subkeys[i] = A;
+				RLanes(&B, &A, i);
+				subkeys[i + 1] = A;
+				RLanes(&C, &A, i + 1);
+			}
+			subkeys[32] = A;
+		}
+		else // 256
+		{
+			A = words[3];
+			B = words[2];
+			C = words[1];
+			D = words[0];
+
+			for (i = 0; i < 33; i += 3)
+			{
+				subkeys[i] = A;
+				RLanes(&B, &A, i);
+				subkeys[i + 1] = A;
+				RLanes(&C, &A, i + 1);
+				subkeys[i + 2] = A;
+				RLanes(&D, &A, i + 2);
+			}
+			subkeys[33] = A;
+		}
+
+		for (l = 0; l < n; l++)
+		{
+			contexts[l]->nrSubkeys = (uint8_t)nrSubkeys;
+			for (i = 0; i < nrSubkeys; i++)
+			{
+				contexts[l]->subkeys[i] = subkeys[i][l];
+			}
+		}
+	}
+}
+#else
+// narrower vectors do not beat SPECK_init
+void SPECK_init_many(SpeckContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		SPECK_init(contexts[i], (uint64_t*)keys + i * (keyLen / 64), keyLen);
+	}
+}
+#endif
+
 void SPECK_main(void)
 {
 	SpeckContext context;
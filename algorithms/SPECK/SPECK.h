@@ -10,6 +10,8 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include "../SIMD/SIMD.h"
+
 typedef struct
 {
 	uint8_t nrSubkeys;
@@ -19,5 +21,17 @@ typedef struct
 void SPECK_init(SpeckContext* context, uint64_t* key, uint16_t keyLen);
 void SPECK_encrypt(SpeckContext* context, uint64_t* block, uint64_t* out);
 void SPECK_decrypt(SpeckContext* context, uint64_t* block, uint64_t* out);
+// count keys of keyLen / 64 words one after the other, same as SPECK_init on each
+void SPECK_init_many(SpeckContext** contexts, const uint64_t* keys, uint16_t keyLen, size_t count);
+// SPECK_init + SPECK_encrypt under the key, without a context
+void SPECK_encrypt_keyed(const uint64_t* key, uint16_t keyLen, const uint64_t* block, uint64_t* out);
+
+#ifdef SIMD_AVAILABLE
+// SIMD_LANES_64 blocks at once, word 0 of every block in x and word 1 in y
+void SPECK_encrypt_lanes(const SpeckContext* context, SimdU64* x, SimdU64* y);
+void SPECK_decrypt_lanes(const SpeckContext* context, SimdU64* x, SimdU64* y);
+// a key per lane, key[j] holding word j of every key
+void SPECK_encrypt_keyed_lanes(const SimdU64* key, uint16_t keyLen, SimdU64* x, SimdU64* y);
+#endif
 
 void SPECK_main(void);
\ No newline at end of file
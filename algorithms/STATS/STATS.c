@@ -0,0 +1,362 @@
+/* STATS.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Opt-in runtime counters of the cipher library: bytes, calls, batch
+ * sizes, key setups and cache hits per cipher and kernel, bytes and
+ * calls per mode.
+ *
+ * Every thread gets its own block of counters on first use, aligned to
+ * cache lines so threads never share a line. Blocks are linked in a
+ * list that only grows (lock-free push) and are handed to a new thread
+ * when their owner exits, keeping their totals. The owner is the only
+ * writer, so an increment is a relaxed load and store, no lock prefix.
+ *
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "STATS.h"
+
+typedef struct
+{
+	_Alignas(64) StatsCipher counters;
+} StatsCipherLine;
+
+typedef struct StatsThread
+{
+	StatsCipherLine ciphers[CIPHER_COUNT];
+	_Alignas(64) StatsModeCounters modes[STATS_MODE_COUNT];
+	struct StatsThread* next;
+	int inUse;
+} StatsThread;
+
+static const char* modeNames[STATS_MODE_COUNT] = { "ECB", "CBC", "CTR", "GCM" };
+
+static StatsThread* threads = NULL;
+static _Thread_local StatsThread* current = NULL;
+static pthread_key_t releaseKey;
+static pthread_once_t releaseOnce = PTHREAD_ONCE_INIT;
+
+static void add(uint64_t* counter, uint64_t value)
+{
+	__atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+static uint64_t load(const uint64_t* counter)
+{
+	return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+// thread exit, the block and its totals go to the next thread
+static void releaseThread(void* block)
+{
+	__atomic_store_n(&((StatsThread*)block)->inUse, 0, __ATOMIC_RELEASE);
+}
+
+static void createReleaseKey(void)
+{
+	pthread_key_create(&releaseKey, releaseThread);
+}
+
+static StatsThread* acquireThread(void)
+{
+	StatsThread* block;
+	int expected;
+
+	pthread_once(&releaseOnce, createReleaseKey);
+
+	for (block = __atomic_load_n(&threads, __ATOMIC_ACQUIRE); block != NULL; block = block->next)
+	{
+		expected = 0;
+		if (__atomic_compare_exchange_n(&block->inUse, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		{
+			break;
+		}
+	}
+
+	if (block == NULL)
+	{
+		block = aligned_alloc(64, sizeof(StatsThread));
+		if (block == NULL)
+		{
+			return NULL;
+		}
+		memset(block, 0, sizeof(StatsThread));
+		block->inUse = 1;
+
+		block->next = __atomic_load_n(&threads, __ATOMIC_RELAXED);
+		while (!__atomic_compare_exchange_n(&threads, &block->next, block, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		{
+		}
+	}
+
+	pthread_setspecific(releaseKey, block);
+	current = block;
+
+	return block;
+}
+
+static StatsCipher* cipherCounters(CipherId cipher)
+{
+	StatsThread* block = current != NULL ? current : acquireThread();
+
+	if (block == NULL || (unsigned)cipher >= CIPHER_COUNT)
+	{
+		return NULL;
+	}
+
+	return &block->ciphers[cipher].counters;
+}
+
+void STATS_record_key_setup(CipherId cipher)
+{
+	StatsCipher* counters = cipherCounters(cipher);
+
+	if (counters != NULL)
+	{
+		add(&counters->keySetups, 1);
+	}
+}
+
+void STATS_record_blocks(CipherId cipher, int kernel, size_t nrBlocks, size_t bytes)
+{
+	StatsCipher* counters = cipherCounters(cipher);
+	int bucket;
+
+	if (counters == NULL || nrBlocks == 0)
+	{
+		return;
+	}
+
+	bucket = 63 - __builtin_clzll(nrBlocks);
+	if (bucket >= STATS_BATCH_BUCKETS)
+	{
+		bucket = STATS_BATCH_BUCKETS - 1;
+	}
+
+	add(&counters->bytes, bytes);
+	add(&counters->calls, 1);
+	add(&counters->kernelCalls[(unsigned)kernel < STATS_MAX_KERNELS ? kernel : 0], 1);
+	add(&counters->batchSizes[bucket], 1);
+}
+
+void STATS_record_mode(StatsMode mode, size_t bytes)
+{
+	StatsThread* block = current != NULL ? current : acquireThread();
+
+	if (block != NULL && (unsigned)mode < STATS_MODE_COUNT)
+	{
+		add(&block->modes[mode].bytes, bytes);
+		add(&block->modes[mode].calls, 1);
+	}
+}
+
+void STATS_record_cache_hit(CipherId cipher)
+{
+	StatsCipher* counters = cipherCounters(cipher);
+
+	if (counters != NULL)
+	{
+		add(&counters->cacheHits, 1);
+	}
+}
+
+const char* STATS_mode_name(StatsMode mode)
+{
+	return (unsigned)mode < STATS_MODE_COUNT ? modeNames[mode] : NULL;
+}
+
+void STATS_snapshot(StatsSnapshot* snapshot)
+{
+	const StatsThread* block;
+	int i;
+	int j;
+
+	memset(snapshot, 0, sizeof(StatsSnapshot));
+#ifdef CIPHER_STATS
+	snapshot->enabled = 1;
+#endif
+
+	for (block = __atomic_load_n(&threads, __ATOMIC_ACQUIRE); block != NULL; block = block->next)
+	{
+		snapshot->nrThreads += __atomic_load_n(&block->inUse, __ATOMIC_RELAXED);
+
+		for (i = 0; i < CIPHER_COUNT; i++)
+		{
+			const StatsCipher* from = &block->ciphers[i].counters;
+			StatsCipher* to = &snapshot->ciphers[i];
+
+			to->bytes += load(&from->bytes);
+			to->calls += load(&from->calls);
+			to->keySetups += load(&from->keySetups);
+			to->cacheHits += load(&from->cacheHits);
+			for (j = 0; j < STATS_MAX_KERNELS; j++)
+			{
+				to->kernelCalls[j] += load(&from->kernelCalls[j]);
+			}
+			for (j = 0; j < STATS_BATCH_BUCKETS; j++)
+			{
+				to->batchSizes[j] += load(&from->batchSizes[j]);
+			}
+		}
+
+		for (i = 0; i < STATS_MODE_COUNT; i++)
+		{
+			snapshot->modes[i].bytes += load(&block->modes[i].bytes);
+			snapshot->modes[i].calls += load(&block->modes[i].calls);
+		}
+	}
+}
+
+void STATS_delta(const StatsSnapshot* before, const StatsSnapshot* after, StatsSnapshot* delta)
+{
+	int i;
+	int j;
+
+	*delta = *after;
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		delta->ciphers[i].bytes -= before->ciphers[i].bytes;
+		delta->ciphers[i].calls -= before->ciphers[i].calls;
+		delta->ciphers[i].keySetups -= before->ciphers[i].keySetups;
+		delta->ciphers[i].cacheHits -= before->ciphers[i].cacheHits;
+		for (j = 0; j < STATS_MAX_KERNELS; j++)
+		{
+			delta->ciphers[i].kernelCalls[j] -= before->ciphers[i].kernelCalls[j];
+		}
+		for (j = 0; j < STATS_BATCH_BUCKETS; j++)
+		{
+			delta->ciphers[i].batchSizes[j] -= before->ciphers[i].batchSizes[j];
+		}
+	}
+
+	for (i = 0; i < STATS_MODE_COUNT; i++)
+	{
+		delta->modes[i].bytes -= before->modes[i].bytes;
+		delta->modes[i].calls -= before->modes[i].calls;
+	}
+}
+
+static void writeArray(FILE* file, const uint64_t* values, int count)
+{
+	int i;
+
+	fprintf(file, "[");
+	for (i = 0; i < count; i++)
+	{
+		fprintf(file, "%s%llu", i == 0 ? " " : ", ", (unsigned long long)values[i]);
+	}
+	fprintf(file, " ]");
+}
+
+void STATS_write_text(FILE* file, const StatsSnapshot* snapshot)
+{
+	int i;
+	int j;
+
+	fprintf(file, "stats %s, %d thread(s)\n", snapshot->enabled ? "enabled" : "disabled (build with CIPHER_STATS)", snapshot->nrThreads);
+	fprintf(file, "%-9s %14s %12s %10s %10s  %s\n", "cipher", "bytes", "calls", "key setups", "cache hits", "calls per kernel / batch size buckets 1, 2-3, 4-7...");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const StatsCipher* counters = &snapshot->ciphers[i];
+
+		if (counters->calls == 0 && counters->keySetups == 0 && counters->cacheHits == 0)
+		{
+			continue;
+		}
+
+		fprintf(file, "%-9s %14llu %12llu %10llu %10llu  ", CIPHER_get(i)->name,
+			(unsigned long long)counters->bytes, (unsigned long long)counters->calls,
+			(unsigned long long)counters->keySetups, (unsigned long long)counters->cacheHits);
+		writeArray(file, counters->kernelCalls, STATS_MAX_KERNELS);
+		fprintf(file, " ");
+
+		// trailing empty buckets are not printed
+		for (j = STATS_BATCH_BUCKETS; j > 1 && counters->batchSizes[j - 1] == 0; j--);
+		writeArray(file, counters->batchSizes, j);
+		fprintf(file, "\n");
+	}
+
+	fprintf(file, "%-9s %14s %12s\n", "mode", "bytes", "calls");
+	for (i = 0; i < STATS_MODE_COUNT; i++)
+	{
+		if (snapshot->modes[i].calls != 0)
+		{
+			fprintf(file, "%-9s %14llu %12llu\n", modeNames[i],
+				(unsigned long long)snapshot->modes[i].bytes, (unsigned long long)snapshot->modes[i].calls);
+		}
+	}
+}
+
+void STATS_write_json(FILE* file, const StatsSnapshot* snapshot)
+{
+	int i;
+
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"enabled\": %s,\n", snapshot->enabled ? "true" : "false");
+	fprintf(file, "\t\"threads\": %d,\n", snapshot->nrThreads);
+	fprintf(file, "\t\"ciphers\": {\n");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const StatsCipher* counters = &snapshot->ciphers[i];
+
+		fprintf(file, "\t\t\"%s\": { \"bytes\": %llu, \"calls\": %llu, \"keySetups\": %llu, \"cacheHits\": %llu, \"kernels\": ",
+			CIPHER_get(i)->name, (unsigned long long)counters->bytes, (unsigned long long)counters->calls,
+			(unsigned long long)counters->keySetups, (unsigned long long)counters->cacheHits);
+		writeArray(file, counters->kernelCalls, STATS_MAX_KERNELS);
+		fprintf(file, ", \"batchSizes\": ");
+		writeArray(file, counters->batchSizes, STATS_BATCH_BUCKETS);
+		fprintf(file, " }%s\n", i + 1 < CIPHER_COUNT ? "," : "");
+	}
+
+	fprintf(file, "\t},\n");
+	fprintf(file, "\t\"modes\": {\n");
+
+	for (i = 0; i < STATS_MODE_COUNT; i++)
+	{
+		fprintf(file, "\t\t\"%s\": { \"bytes\": %llu, \"calls\": %llu }%s\n", modeNames[i],
+			(unsigned long long)snapshot->modes[i].bytes, (unsigned long long)snapshot->modes[i].calls,
+			i + 1 < STATS_MODE_COUNT ? "," : "");
+	}
+
+	fprintf(file, "\t}\n}\n");
+}
+
+int STATS_save(const char* path, int json)
+{
+	StatsSnapshot snapshot;
+	char temporary[4096];
+	FILE* file;
+
+	// written aside and renamed, so a reader never sees a partial file
+	if (snprintf(temporary, sizeof(temporary), "%s.tmp", path) >= (int)sizeof(temporary) ||
+		(file = fopen(temporary, "w")) == NULL)
+	{
+		return 0;
+	}
+
+	STATS_snapshot(&snapshot);
+	if (json)
+	{
+		STATS_write_json(file, &snapshot);
+	}
+	else
+	{
+		STATS_write_text(file, &snapshot);
+	}
+
+	if (fclose(file) != 0)
+	{
+		remove(temporary);
+		return 0;
+	}
+
+	return rename(temporary, path) == 0;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+/* STATS.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../CIPHER/CIPHER.h"
+
+// kernel 0 is the reference (one block at a time) implementation
+#define STATS_MAX_KERNELS 4
+// batch sizes are counted in power of two buckets: 1, 2-3, 4-7, ...
+#define STATS_BATCH_BUCKETS 16
+
+typedef enum
+{
+	STATS_MODE_ECB = 0,
+	STATS_MODE_CBC,
+	STATS_MODE_CTR,
+	STATS_MODE_GCM,
+	STATS_MODE_COUNT
+} StatsMode;
+
+typedef struct
+{
+	uint64_t bytes;
+	uint64_t calls;
+	uint64_t keySetups;
+	uint64_t cacheHits;
+	uint64_t kernelCalls[STATS_MAX_KERNELS];
+	uint64_t batchSizes[STATS_BATCH_BUCKETS];
+} StatsCipher;
+
+typedef struct
+{
+	uint64_t bytes;
+	uint64_t calls;
+} StatsModeCounters;
+
+typedef struct
+{
+	int enabled;
+	int nrThreads;
+	StatsCipher ciphers[CIPHER_COUNT];
+	StatsModeCounters modes[STATS_MODE_COUNT];
+} StatsSnapshot;
+
+/*
+	The hooks below are compiled in only with -DCIPHER_STATS (make STATS=1),
+	otherwise they expand to nothing. Each thread increments its own
+	cache-line aligned counters without atomics read-modify-write or locks,
+	readers sum the per-thread counters with relaxed loads.
+*/
+#ifdef CIPHER_STATS
+#define STATS_KEY_SETUP(cipher) STATS_record_key_setup(cipher)
+#define STATS_BLOCKS(cipher, kernel, nrBlocks, bytes) STATS_record_blocks(cipher, kernel, nrBlocks, bytes)
+#define STATS_MODE(mode, bytes) STATS_record_mode(mode, bytes)
+#define STATS_CACHE_HIT(cipher) STATS_record_cache_hit(cipher)
+#else
+#define STATS_KEY_SETUP(cipher) ((void)0)
+#define STATS_BLOCKS(cipher, kernel, nrBlocks, bytes) ((void)0)
+#define STATS_MODE(mode, bytes) ((void)0)
+#define STATS_CACHE_HIT(cipher) ((void)0)
+#endif
+
+void STATS_record_key_setup(CipherId cipher);
+void STATS_record_blocks(CipherId cipher, int kernel, size_t nrBlocks, size_t bytes);
+void STATS_record_mode(StatsMode mode, size_t bytes);
+void STATS_record_cache_hit(CipherId cipher);
+
+const char* STATS_mode_name(StatsMode mode);
+
+// sums the counters of every thread, lock-free and safe while they run
+void STATS_snapshot(StatsSnapshot* snapshot);
+
+// only the difference between two snapshots, e.g. for a periodic exporter
+void STATS_delta(const StatsSnapshot* before, const StatsSnapshot* after, StatsSnapshot* delta);
+
+void STATS_write_text(FILE* file, const StatsSnapshot* snapshot);
+void STATS_write_json(FILE* file, const StatsSnapshot* snapshot);
+
+// writes a snapshot to path, as JSON when json is not 0
+int STATS_save(const char* path, int json);
\ No newline at end of file
@@ -0,0 +1,211 @@
+/* bench.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Entry point of the benchmark executable. Each benchmark is a
+ * sub-command, e.g.:
+ *
+ *		./bench keysetup -c SEED -n 20000
+ *
+ * With a STATS=1 build, BENCH_STATS=path writes the runtime counters of
+ * the run to path (JSON when it ends with .json, text otherwise).
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+#include "../algorithms/STATS/STATS.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BENCH_X86
+#endif
+
+typedef struct
+{
+	const char* name;
+	int (*run)(int argc, char** argv);
+	const char* description;
+} BenchCommand;
+
+static const BenchCommand commands[] =
+{
+	{ "keysetup", BENCH_keysetup, "key schedule latency and new key + N blocks cost" },
+	{ "scaling", BENCH_scaling, "1..N threads, shared/replicated contexts (not tables), pinning and sockets" },
+	{ "cache", BENCH_cache, "latency with flushed tables, evicted caches and a polluting co-runner" },
+	{ "latency", BENCH_latency, "p50..p99.9 and max per operation, fixed key and key setup per operation" },
+	{ "baseline", BENCH_baseline, "saves throughput trials as JSON tagged with CPU, compiler and flags" },
+	{ "compare", BENCH_compare, "significance-tested deltas between two baselines, exit 1 on regression" },
+	{ "counters", BENCH_counters, "cycles, instructions, IPC, cache and branch misses per block (perf_event_open)" },
+	{ "profile", BENCH_profile, "share of each internal cipher step in the cycles (make PROFILE=1)" },
+	{ "verify", BENCH_verify, "every batch kernel against the reference block functions (-k 1000000 for a deployment gate)" },
+	{ "cascade", BENCH_cascade, "two ciphers per block, two passes against the fused tile pipeline" },
+	{ "bulk", BENCH_bulk, "ECB/CTR jobs with and without the non-temporal bulk path, cache footprint" },
+	{ "burst", BENCH_burst, "bursts of short GCM packets: per-packet calls against BURST_process" },
+	{ "iovec", BENCH_iovec, "segment chains: linearize + MODES against IOVEC in place" },
+	{ "fpe", BENCH_fpe, "FF1/FF3-1 tokenization: per-value calls against the batch API" },
+	{ "column", BENCH_column, "column encryption: per-value CTR calls against COLUMN" },
+	{ "rng", BENCH_rng, "counter-based RNG: per-value calls against bulk fills, skip-ahead checks" },
+	{ "drbg", BENCH_drbg, "CTR_DRBG: small requests, bulk requests, thread instances and fork" },
+	{ "kdf", BENCH_kdf, "SP 800-108 CMAC KDF: per-key derivation against KDF_derive_many" },
+	{ "bchash", BENCH_bchash, "block cipher hashes: rekeyed contexts against key-agile and batch BCHASH" },
+	{ "gost94", BENCH_gost94, "GOST R 34.11-94: known answers, batched step encryptions and throughput" },
+	{ "rotate", BENCH_rotate, "hot key rotation: fixed context, mutex and KEYHANDLE under a rotating key" }
+};
+
+static uint64_t randomState = 0x9e3779b97f4a7c15;
+
+uint64_t BENCH_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void BENCH_random_bytes(uint8_t* buffer, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 7;
+		randomState ^= randomState << 17;
+		buffer[i] = (uint8_t)(randomState >> 32);
+	}
+}
+
+int BENCH_can_flush(void)
+{
+#ifdef BENCH_X86
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+void BENCH_flush(const void* address, size_t size)
+{
+#ifdef BENCH_X86
+	const uint8_t* line = (const uint8_t*)((uintptr_t)address & ~(uintptr_t)63);
+	const uint8_t* end = (const uint8_t*)address + size;
+
+	for (; line < end; line += 64)
+	{
+		_mm_clflush(line);
+	}
+#endif
+}
+
+void BENCH_fence(void)
+{
+#ifdef BENCH_X86
+	_mm_mfence();
+#else
+	__sync_synchronize();
+#endif
+}
+
+static int compareDouble(const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+
+	return (x > y) - (x < y);
+}
+
+double BENCH_median(double* values, int count)
+{
+	qsort(values, count, sizeof(double), compareDouble);
+
+	if (count % 2 == 0)
+	{
+		return (values[count / 2 - 1] + values[count / 2]) / 2;
+	}
+
+	return values[count / 2];
+}
+
+const char* BENCH_string_option(int argc, char** argv, const char* option, const char* defaultValue)
+{
+	int i;
+
+	for (i = 0; i < argc - 1; i++)
+	{
+		if (strcmp(argv[i], option) == 0)
+		{
+			return argv[i + 1];
+		}
+	}
+
+	return defaultValue;
+}
+
+const CipherDescriptor* BENCH_cipher_option(int argc, char** argv)
+{
+	const char* name = BENCH_string_option(argc, argv, "-c", NULL);
+
+	return name != NULL ? CIPHER_find(name) : NULL;
+}
+
+long BENCH_long_option(int argc, char** argv, const char* option, long defaultValue)
+{
+	int i;
+
+	for (i = 0; i < argc - 1; i++)
+	{
+		if (strcmp(argv[i], option) == 0)
+		{
+			return strtol(argv[i + 1], NULL, 0);
+		}
+	}
+
+	return defaultValue;
+}
+
+static void usage(const char* program)
+{
+	size_t i;
+
+	printf("usage: %s <benchmark> [-c CIPHER] [options]\n\n", program);
+	for (i = 0; i < sizeof(commands) / sizeof(commands[0]); i++)
+	{
+		printf("\t%-12s %s\n", commands[i].name, commands[i].description);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t i;
+
+	if (argc < 2)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	for (i = 0; i < sizeof(commands) / sizeof(commands[0]); i++)
+	{
+		if (strcmp(argv[1], commands[i].name) == 0)
+		{
+			int result = commands[i].run(argc - 2, argv + 2);
+			const char* statsPath = getenv("BENCH_STATS");
+
+			if (statsPath != NULL)
+			{
+				size_t length = strlen(statsPath);
+				STATS_save(statsPath, length >= 5 && strcmp(statsPath + length - 5, ".json") == 0);
+			}
+
+			return result;
+		}
+	}
+
+	usage(argv[0]);
+	return 1;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+/* bench.h
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../algorithms/CIPHER/CIPHER.h"
+
+#define BENCH_TRIALS 5
+
+// monotonic clock in nanoseconds
+uint64_t BENCH_now(void);
+
+// deterministic xorshift generator, so runs are reproducible
+void BENCH_random_bytes(uint8_t* buffer, size_t length);
+
+// evicts every cache line of the range (clflush), no-op when unsupported
+int BENCH_can_flush(void);
+void BENCH_flush(const void* address, size_t size);
+void BENCH_fence(void);
+
+// median of the values, reorders the array
+double BENCH_median(double* values, int count);
+
+const char* BENCH_string_option(int argc, char** argv, const char* option, const char* defaultValue);
+long BENCH_long_option(int argc, char** argv, const char* option, long defaultValue);
+
+// parses "-c NAME" into a cipher filter, NULL means every cipher
+const CipherDescriptor* BENCH_cipher_option(int argc, char** argv);
+
+int BENCH_keysetup(int argc, char** argv);
+int BENCH_scaling(int argc, char** argv);
+int BENCH_cache(int argc, char** argv);
+int BENCH_latency(int argc, char** argv);
+int BENCH_baseline(int argc, char** argv);
+int BENCH_compare(int argc, char** argv);
+int BENCH_counters(int argc, char** argv);
+int BENCH_profile(int argc, char** argv);
+int BENCH_verify(int argc, char** argv);
+int BENCH_cascade(int argc, char** argv);
+int BENCH_bulk(int argc, char** argv);
+int BENCH_burst(int argc, char** argv);
+int BENCH_iovec(int argc, char** argv);
+int BENCH_fpe(int argc, char** argv);
+int BENCH_column(int argc, char** argv);
+int BENCH_rng(int argc, char** argv);
+int BENCH_drbg(int argc, char** argv);
+int BENCH_kdf(int argc, char** argv);
+int BENCH_bchash(int argc, char** argv);
+int BENCH_gost94(int argc, char** argv);
+int BENCH_rotate(int argc, char** argv);
\ No newline at end of file
@@ -0,0 +1,507 @@
+/* bench_baseline.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Baseline storage and regression comparison. "baseline" measures the
+ * ECB throughput (ns per byte) of every cipher for a few request sizes,
+ * keeping every repeated trial, and saves it as JSON tagged with the
+ * CPU model, compiler and flags:
+ *
+ *		./bench baseline -o base.json -r 15
+ *
+ * "compare" loads two result sets (or one and a fresh run when the
+ * second file is omitted), runs a Mann-Whitney U test over the trials
+ * of every cipher/size pair and prints the median deltas. It exits with
+ * 1 when any pair is significantly slower by more than -t percent:
+ *
+ *		./bench compare base.json new.json -t 5
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define BASELINE_VERSION 1
+#define MAX_TRIALS 64
+#define MAX_RESULTS (CIPHER_COUNT * 4)
+#define BYTES_PER_TRIAL (256 * 1024)
+
+#ifndef BENCH_CFLAGS
+#define BENCH_CFLAGS "unknown"
+#endif
+
+typedef struct
+{
+	char cipher[16];
+	long size;
+	int nrTrials;
+	double trials[MAX_TRIALS];
+} BaselineResult;
+
+typedef struct
+{
+	int version;
+	char cpu[128];
+	char compiler[128];
+	char flags[128];
+	int nrResults;
+	BaselineResult results[MAX_RESULTS];
+} Baseline;
+
+static const long sizes[] = { 16, 256, 4096, 65536 };
+
+static void cpuModel(char* model, size_t length)
+{
+	FILE* file = fopen("/proc/cpuinfo", "r");
+	char line[256];
+	char* value;
+
+	snprintf(model, length, "unknown");
+	if (file == NULL)
+	{
+		return;
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		if (strncmp(line, "model name", 10) == 0 && (value = strchr(line, ':')) != NULL)
+		{
+			value += 2;
+			value[strcspn(value, "\n")] = 0;
+			snprintf(model, length, "%s", value);
+			break;
+		}
+	}
+	fclose(file);
+}
+
+static void measure(Baseline* baseline, const CipherDescriptor* filter, int nrTrials)
+{
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	CipherContext context;
+	uint8_t* data;
+	uint64_t start;
+	size_t s;
+	long repetitions;
+	long r;
+	int i;
+	int t;
+
+	baseline->version = BASELINE_VERSION;
+	cpuModel(baseline->cpu, sizeof(baseline->cpu));
+#if defined(__clang__)
+	snprintf(baseline->compiler, sizeof(baseline->compiler), "clang %s", __clang_version__);
+#elif defined(__GNUC__)
+	snprintf(baseline->compiler, sizeof(baseline->compiler), "gcc %s", __VERSION__);
+#else
+	snprintf(baseline->compiler, sizeof(baseline->compiler), "unknown");
+#endif
+	snprintf(baseline->flags, sizeof(baseline->flags), "%s", BENCH_CFLAGS);
+	baseline->nrResults = 0;
+
+	BENCH_random_bytes(key, sizeof(key));
+	data = malloc(sizes[sizeof(sizes) / sizeof(sizes[0]) - 1]);
+	BENCH_random_bytes(data, sizes[sizeof(sizes) / sizeof(sizes[0]) - 1]);
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		CIPHER_init(&context, cipher->id, key, cipher->keyLengths[0]);
+
+		for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+		{
+			BaselineResult* result = &baseline->results[baseline->nrResults++];
+			size_t nrBlocks = sizes[s] / cipher->blockSize;
+
+			snprintf(result->cipher, sizeof(result->cipher), "%s", cipher->name);
+			result->size = sizes[s];
+			result->nrTrials = nrTrials;
+			repetitions = BYTES_PER_TRIAL / sizes[s];
+
+			// warm up
+			CIPHER_encrypt_blocks(&context, data, data, nrBlocks);
+
+			for (t = 0; t < nrTrials; t++)
+			{
+				start = BENCH_now();
+				for (r = 0; r < repetitions; r++)
+				{
+					CIPHER_encrypt_blocks(&context, data, data, nrBlocks);
+				}
+				result->trials[t] = (double)(BENCH_now() - start) / ((double)repetitions * sizes[s]);
+			}
+		}
+	}
+
+	free(data);
+}
+
+static int save(const Baseline* baseline, const char* path)
+{
+	FILE* file = fopen(path, "w");
+	int i;
+	int t;
+
+	if (file == NULL)
+	{
+		printf("cannot write %s\n", path);
+		return 0;
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"version\": %d,\n", baseline->version);
+	fprintf(file, "\t\"cpu\": \"%s\",\n", baseline->cpu);
+	fprintf(file, "\t\"compiler\": \"%s\",\n", baseline->compiler);
+	fprintf(file, "\t\"flags\": \"%s\",\n", baseline->flags);
+	fprintf(file, "\t\"unit\": \"ns/byte\",\n");
+	fprintf(file, "\t\"results\": [\n");
+
+	for (i = 0; i < baseline->nrResults; i++)
+	{
+		const BaselineResult* result = &baseline->results[i];
+
+		fprintf(file, "\t\t{ \"cipher\": \"%s\", \"size\": %ld, \"trials\": [", result->cipher, result->size);
+		for (t = 0; t < result->nrTrials; t++)
+		{
+			fprintf(file, "%s%.6f", t == 0 ? " " : ", ", result->trials[t]);
+		}
+		fprintf(file, " ] }%s\n", i + 1 < baseline->nrResults ? "," : "");
+	}
+
+	fprintf(file, "\t]\n}\n");
+	fclose(file);
+
+	return 1;
+}
+
+// copies the string value following "key": into value, returns the position after it
+static const char* stringField(const char* json, const char* key, char* value, size_t length)
+{
+	const char* p = strstr(json, key);
+	size_t n = 0;
+
+	if (p == NULL || (p = strchr(p + strlen(key), '"')) == NULL)
+	{
+		return NULL;
+	}
+
+	for (p++; *p != 0 && *p != '"'; p++)
+	{
+		if (n + 1 < length)
+		{
+			value[n++] = *p;
+		}
+	}
+	value[n] = 0;
+
+	return *p == '"' ? p + 1 : NULL;
+}
+
+static const char* numberField(const char* json, const char* key, double* value)
+{
+	const char* p = strstr(json, key);
+	char* end;
+
+	if (p == NULL || (p = strchr(p, ':')) == NULL)
+	{
+		return NULL;
+	}
+
+	*value = strtod(p + 1, &end);
+	return end != p + 1 ? end : NULL;
+}
+
+// reads the files written by save(), not a general JSON parser
+static int load(Baseline* baseline, const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	const char* p;
+	char* json;
+	double number;
+	long length;
+	char* end;
+
+	if (file == NULL)
+	{
+		printf("cannot read %s\n", path);
+		return 0;
+	}
+
+	fseek(file, 0, SEEK_END);
+	length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	json = malloc(length + 1);
+	length = (long)fread(json, 1, length, file);
+	json[length] = 0;
+	fclose(file);
+
+	memset(baseline, 0, sizeof(Baseline));
+	if (numberField(json, "\"version\"", &number) == NULL || (int)number != BASELINE_VERSION)
+	{
+		printf("%s: unsupported baseline version\n", path);
+		free(json);
+		return 0;
+	}
+	baseline->version = (int)number;
+	stringField(json, "\"cpu\"", baseline->cpu, sizeof(baseline->cpu));
+	stringField(json, "\"compiler\"", baseline->compiler, sizeof(baseline->compiler));
+	stringField(json, "\"flags\"", baseline->flags, sizeof(baseline->flags));
+
+	p = json;
+	while (baseline->nrResults < MAX_RESULTS && (p = strstr(p, "\"cipher\"")) != NULL)
+	{
+		BaselineResult* result = &baseline->results[baseline->nrResults];
+
+		if ((p = stringField(p, "\"cipher\"", result->cipher, sizeof(result->cipher))) == NULL ||
+			(p = numberField(p, "\"size\"", &number)) == NULL ||
+			(p = strstr(p, "\"trials\"")) == NULL ||
+			(p = strchr(p, '[')) == NULL)
+		{
+			break;
+		}
+		result->size = (long)number;
+
+		for (p++; result->nrTrials < MAX_TRIALS; p = end)
+		{
+			while (*p == ' ' || *p == ',' || *p == '\t')
+			{
+				p++;
+			}
+			number = strtod(p, &end);
+			if (end == p)
+			{
+				break;
+			}
+			result->trials[result->nrTrials++] = number;
+		}
+
+		baseline->nrResults++;
+	}
+
+	free(json);
+	return 1;
+}
+
+static const BaselineResult* findResult(const Baseline* baseline, const char* cipher, long size)
+{
+	int i;
+
+	for (i = 0; i < baseline->nrResults; i++)
+	{
+		if (strcmp(baseline->results[i].cipher, cipher) == 0 && baseline->results[i].size == size)
+		{
+			return &baseline->results[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+	Two-sided Mann-Whitney U test with the normal approximation and tie
+	correction. It only assumes the trials are independent, which suits
+	timing noise that is skewed and has outliers.
+*/
+static double mannWhitney(const double* a, int nrA, const double* b, int nrB)
+{
+	double values[2 * MAX_TRIALS];
+	int fromA[2 * MAX_TRIALS];
+	double rankSumA = 0;
+	double ties = 0;
+	double u;
+	double mean;
+	double variance;
+	int n = nrA + nrB;
+	int i;
+	int j;
+	int k;
+
+	for (i = 0; i < nrA; i++)
+	{
+		values[i] = a[i];
+		fromA[i] = 1;
+	}
+	for (i = 0; i < nrB; i++)
+	{
+		values[nrA + i] = b[i];
+		fromA[nrA + i] = 0;
+	}
+
+	// insertion sort, n is small
+	for (i = 1; i < n; i++)
+	{
+		double value = values[i];
+		int origin = fromA[i];
+
+		for (j = i - 1; j >= 0 && values[j] > value; j--)
+		{
+			values[j + 1] = values[j];
+			fromA[j + 1] = fromA[j];
+		}
+		values[j + 1] = value;
+		fromA[j + 1] = origin;
+	}
+
+	for (i = 0; i < n; i = j)
+	{
+		for (j = i; j < n && values[j] == values[i]; j++);
+
+		// tied values share the average rank
+		for (k = i; k < j; k++)
+		{
+			if (fromA[k])
+			{
+				rankSumA += (i + j + 1) / 2.0;
+			}
+		}
+		ties += (double)(j - i) * (j - i) * (j - i) - (j - i);
+	}
+
+	u = rankSumA - nrA * (nrA + 1) / 2.0;
+	mean = nrA * nrB / 2.0;
+	variance = nrA * nrB / 12.0 * ((n + 1) - ties / ((double)n * (n - 1)));
+
+	if (variance <= 0)
+	{
+		return 1;
+	}
+
+	return erfc(fabs(u - mean) / sqrt(variance) / sqrt(2));
+}
+
+static double median(const double* values, int count)
+{
+	double sorted[MAX_TRIALS];
+
+	memcpy(sorted, values, count * sizeof(double));
+	return BENCH_median(sorted, count);
+}
+
+// -r, 0 (with a message) when out of 2 .. MAX_TRIALS
+static int trialsOption(int argc, char** argv)
+{
+	long nrTrials = BENCH_long_option(argc, argv, "-r", 15);
+
+	if (nrTrials < 2 || nrTrials > MAX_TRIALS)
+	{
+		printf("-r must be between 2 and %d\n", MAX_TRIALS);
+		return 0;
+	}
+
+	return (int)nrTrials;
+}
+
+int BENCH_baseline(int argc, char** argv)
+{
+	const char* path = BENCH_string_option(argc, argv, "-o", "baseline.json");
+	int nrTrials = trialsOption(argc, argv);
+	static Baseline baseline;
+
+	if (nrTrials == 0)
+	{
+		return 1;
+	}
+
+	measure(&baseline, BENCH_cipher_option(argc, argv), nrTrials);
+	if (!save(&baseline, path))
+	{
+		return 1;
+	}
+
+	printf("%d results x %d trials saved to %s (%s, %s)\n", baseline.nrResults, nrTrials, path, baseline.cpu, baseline.compiler);
+	return 0;
+}
+
+int BENCH_compare(int argc, char** argv)
+{
+	double threshold = BENCH_long_option(argc, argv, "-t", 5);
+	double alpha = 0.01;
+	static Baseline old;
+	static Baseline new;
+	int nrRegressions = 0;
+	int nrTrials;
+	int i;
+
+	if (argc < 1 || argv[0][0] == '-' || !load(&old, argv[0]))
+	{
+		printf("usage: compare OLD.json [NEW.json] [-t PERCENT] [-r TRIALS] [-c CIPHER]\n");
+		return 2;
+	}
+
+	if (argc >= 2 && argv[1][0] != '-')
+	{
+		if (!load(&new, argv[1]))
+		{
+			return 2;
+		}
+	}
+	else
+	{
+		nrTrials = trialsOption(argc, argv);
+		if (nrTrials == 0)
+		{
+			return 2;
+		}
+		measure(&new, BENCH_cipher_option(argc, argv), nrTrials);
+	}
+
+	if (strcmp(old.cpu, new.cpu) != 0 || strcmp(old.compiler, new.compiler) != 0 || strcmp(old.flags, new.flags) != 0)
+	{
+		printf("warning: different environments\n\told: %s, %s, %s\n\tnew: %s, %s, %s\n",
+			old.cpu, old.compiler, old.flags, new.cpu, new.compiler, new.flags);
+	}
+
+	printf("threshold %.0f%%, significance p < %.2f\n", threshold, alpha);
+	printf("%-9s %6s %11s %11s %8s %8s  %s\n", "cipher", "size", "old ns/B", "new ns/B", "delta", "p", "verdict");
+
+	for (i = 0; i < new.nrResults; i++)
+	{
+		const BaselineResult* current = &new.results[i];
+		const BaselineResult* previous = findResult(&old, current->cipher, current->size);
+		const char* verdict = "same";
+		double before;
+		double after;
+		double delta;
+		double p;
+
+		if (previous == NULL || previous->nrTrials == 0 || current->nrTrials == 0)
+		{
+			continue;
+		}
+
+		before = median(previous->trials, previous->nrTrials);
+		after = median(current->trials, current->nrTrials);
+		delta = (after - before) / before * 100;
+		p = mannWhitney(previous->trials, previous->nrTrials, current->trials, current->nrTrials);
+
+		// a delta only counts when it is both significant and large enough
+		if (p < alpha && delta > threshold)
+		{
+			verdict = "REGRESSION";
+			nrRegressions++;
+		}
+		else if (p < alpha && delta < -threshold)
+		{
+			verdict = "faster";
+		}
+		else if (p < alpha)
+		{
+			verdict = "within threshold";
+		}
+
+		printf("%-9s %6ld %11.3f %11.3f %+7.1f%% %8.4f  %s\n", current->cipher, current->size, before, after, delta, p, verdict);
+	}
+
+	printf("%d regression(s)\n", nrRegressions);
+	return nrRegressions > 0 ? 1 : 0;
+}
\ No newline at end of file
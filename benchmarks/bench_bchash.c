@@ -0,0 +1,186 @@
+/* bench_bchash.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Hashing of -n messages (4096) of -s / 2 to -s bytes (64) with the block
+ * cipher based hashes of BCHASH over a cipher (-c, SPECK by default), for
+ * every construction the cipher supports:
+ *		- contexts: the construction over CIPHER_init + CIPHER_encrypt,
+ *		  a full key setup per compression
+ *		- one by one: BCHASH_init/update/final per message (key-agile)
+ *		- batch: BCHASH_hash_many
+ *
+ * The three must give the same digests.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/BCHASH/BCHASH.h"
+
+// the construction with a context per compression, padded is scratch space
+static void referenceHash(BchashMode mode, CipherId id, const uint8_t* message, size_t length, uint8_t* padded, uint8_t* digest)
+{
+	size_t nrBlocks = (length + 1 + 8 + BCHASH_BLOCK_SIZE - 1) / BCHASH_BLOCK_SIZE;
+	uint8_t state[BCHASH_MAX_DIGEST_SIZE] = { 0 };
+	uint8_t key[32];
+	uint8_t g[16];
+	uint8_t e[32];
+	CipherContext context;
+	const uint8_t* m;
+	size_t i;
+	int b;
+
+	memset(padded, 0, nrBlocks * BCHASH_BLOCK_SIZE);
+	memcpy(padded, message, length);
+	padded[length] = 0x80;
+	for (b = 0; b < 8; b++)
+	{
+		padded[nrBlocks * BCHASH_BLOCK_SIZE - 8 + b] = (uint8_t)((uint64_t)length * 8 >> (56 - 8 * b));
+	}
+
+	for (i = 0; i < nrBlocks; i++)
+	{
+		m = padded + i * BCHASH_BLOCK_SIZE;
+		if (mode == BCHASH_HIROSE)
+		{
+			memcpy(key, state + 16, 16);
+			memcpy(key + 16, m, 16);
+			CIPHER_init(&context, id, key, 256);
+			memcpy(g, state, 16);
+			CIPHER_encrypt(&context, g, e);
+			g[15] ^= 0x01;
+			CIPHER_encrypt(&context, g, e + 16);
+			for (b = 0; b < 16; b++)
+			{
+				state[16 + b] = e[16 + b] ^ g[b];
+				state[b] ^= e[b];
+			}
+		}
+		else
+		{
+			CIPHER_init(&context, id, state, 128);
+			CIPHER_encrypt(&context, m, e);
+			for (b = 0; b < 16; b++)
+			{
+				state[b] = (mode == BCHASH_MP ? state[b] : 0) ^ e[b] ^ m[b];
+			}
+		}
+	}
+
+	memcpy(digest, state, BCHASH_digest_size(mode));
+}
+
+int BENCH_bchash(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	size_t count = (size_t)BENCH_long_option(argc, argv, "-n", 4096);
+	size_t size = (size_t)BENCH_long_option(argc, argv, "-s", 64);
+	BchashContext context;
+	const uint8_t** messages;
+	size_t* lengths;
+	uint8_t** digests;
+	uint8_t* data;
+	uint8_t* padded;
+	uint8_t* expected;
+	uint8_t* single;
+	uint8_t* batch;
+	double times[3] = { 0 };
+	double elapsed;
+	uint64_t start;
+	size_t digestSize;
+	int failures = 0;
+	int mode;
+	size_t i;
+	int t;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_SPECK);
+	}
+	size = size < 2 ? 2 : size;
+
+	messages = malloc(count * sizeof(uint8_t*));
+	lengths = malloc(count * sizeof(size_t));
+	digests = malloc(count * sizeof(uint8_t*));
+	data = malloc(count * size);
+	padded = malloc(size + 2 * BCHASH_BLOCK_SIZE);
+	expected = malloc(count * BCHASH_MAX_DIGEST_SIZE);
+	single = malloc(count * BCHASH_MAX_DIGEST_SIZE);
+	batch = malloc(count * BCHASH_MAX_DIGEST_SIZE);
+	BENCH_random_bytes(data, count * size);
+
+	for (i = 0; i < count; i++)
+	{
+		messages[i] = data + i * size;
+		lengths[i] = size / 2 + i % (size - size / 2 + 1);
+		digests[i] = batch + i * BCHASH_MAX_DIGEST_SIZE;
+	}
+
+	printf("%s, %zu messages of %zu to %zu bytes\n", cipher->name, count, size / 2, size);
+	printf("%-7s %14s %14s %14s %9s\n", "hash", "contexts ns", "one by one ns", "batch ns", "speedup");
+
+	for (mode = 0; mode < BCHASH_MODE_COUNT; mode++)
+	{
+		if (BCHASH_init(&context, mode, cipher->id) != CIPHER_OK)
+		{
+			printf("%-7s %14s\n", BCHASH_name(mode), "n/a");
+			continue;
+		}
+		digestSize = BCHASH_digest_size(mode);
+
+		for (t = 0; t < BENCH_TRIALS; t++)
+		{
+			start = BENCH_now();
+			for (i = 0; i < count; i++)
+			{
+				referenceHash(mode, cipher->id, messages[i], lengths[i], padded, expected + i * BCHASH_MAX_DIGEST_SIZE);
+			}
+			elapsed = (double)(BENCH_now() - start) / count;
+			times[0] = t == 0 || elapsed < times[0] ? elapsed : times[0];
+
+			start = BENCH_now();
+			for (i = 0; i < count; i++)
+			{
+				BCHASH_init(&context, mode, cipher->id);
+				BCHASH_update(&context, messages[i], lengths[i]);
+				BCHASH_final(&context, single + i * BCHASH_MAX_DIGEST_SIZE);
+			}
+			elapsed = (double)(BENCH_now() - start) / count;
+			times[1] = t == 0 || elapsed < times[1] ? elapsed : times[1];
+
+			start = BENCH_now();
+			BCHASH_hash_many(mode, cipher->id, messages, lengths, digests, count);
+			elapsed = (double)(BENCH_now() - start) / count;
+			times[2] = t == 0 || elapsed < times[2] ? elapsed : times[2];
+		}
+
+		printf("%-7s %14.1f %14.1f %14.1f %8.2fx\n", BCHASH_name(mode), times[0], times[1], times[2], times[0] / times[2]);
+
+		for (i = 0; i < count; i++)
+		{
+			if (memcmp(single + i * BCHASH_MAX_DIGEST_SIZE, expected + i * BCHASH_MAX_DIGEST_SIZE, digestSize) != 0
+				|| memcmp(batch + i * BCHASH_MAX_DIGEST_SIZE, expected + i * BCHASH_MAX_DIGEST_SIZE, digestSize) != 0)
+			{
+				printf("FAIL: %s digest of message %zu (%zu bytes) differs from the construction over contexts\n",
+					BCHASH_name(mode), i, lengths[i]);
+				failures++;
+				break;
+			}
+		}
+	}
+
+	free(messages);
+	free(lengths);
+	free(digests);
+	free(data);
+	free(padded);
+	free(expected);
+	free(single);
+	free(batch);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
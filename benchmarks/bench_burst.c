@@ -0,0 +1,177 @@
+/* bench_burst.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Bursts of -n short packets (-s bytes, 64 by default) sealed then
+ * opened with -k keys (4 by default, 128 bits ciphers only, ARIA by
+ * default), as a packet gateway would:
+ *		- per packet: one GCM_seal/GCM_open call each
+ *		- burst: one BURST_process call for the whole burst
+ *
+ * Both must give the same ciphertext and tags, and every open must
+ * succeed; a packet with a corrupted tag must fail and be zeroed.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/BURST/BURST.h"
+
+#define MAX_KEYS 16
+#define NONCE_SIZE 12
+#define AAD_SIZE 16
+
+static double packetRate(uint64_t nanoseconds, size_t count)
+{
+	return (double)count / nanoseconds * 1000;
+}
+
+int BENCH_burst(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	size_t count = (size_t)BENCH_long_option(argc, argv, "-n", 64);
+	size_t length = (size_t)BENCH_long_option(argc, argv, "-s", 64);
+	size_t nrKeys = (size_t)BENCH_long_option(argc, argv, "-k", 4);
+	long iterations = BENCH_long_option(argc, argv, "-i", 200);
+	CipherContext contexts[MAX_KEYS];
+	GcmContext gcm[MAX_KEYS];
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	double separate[BENCH_TRIALS];
+	double burst[BENCH_TRIALS];
+	uint8_t* nonces;
+	uint8_t* aad;
+	uint8_t* plaintext;
+	uint8_t* expected;
+	uint8_t* expectedTags;
+	uint8_t* data;
+	uint8_t* tags;
+	BurstOp* ops;
+	uint64_t start;
+	int failures = 0;
+	size_t i;
+	long n;
+	int t;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_ARIA);
+	}
+	if (cipher->blockSize != GCM_BLOCK_SIZE || count == 0)
+	{
+		printf("%s is not a 128 bits cipher\n", cipher->name);
+		return 1;
+	}
+	if (nrKeys < 1 || nrKeys > MAX_KEYS)
+	{
+		nrKeys = 4;
+	}
+
+	for (i = 0; i < nrKeys; i++)
+	{
+		BENCH_random_bytes(key, sizeof(key));
+		CIPHER_init(&contexts[i], cipher->id, key, cipher->keyLengths[0]);
+		GCM_init(&gcm[i], &contexts[i]);
+	}
+
+	nonces = malloc(count * NONCE_SIZE);
+	aad = malloc(count * AAD_SIZE);
+	plaintext = malloc(count * length + 1);
+	expected = malloc(count * length + 1);
+	data = malloc(count * length + 1);
+	expectedTags = malloc(count * GCM_TAG_SIZE);
+	tags = malloc(count * GCM_TAG_SIZE);
+	ops = malloc(count * sizeof(BurstOp));
+	BENCH_random_bytes(nonces, count * NONCE_SIZE);
+	BENCH_random_bytes(aad, count * AAD_SIZE);
+	BENCH_random_bytes(plaintext, count * length);
+
+	// packets of the keys interleaved, as they arrive
+	for (i = 0; i < count; i++)
+	{
+		ops[i].operation = BURST_GCM_SEAL;
+		ops[i].gcm = &gcm[i % nrKeys];
+		ops[i].cipher = NULL;
+		ops[i].nonce = nonces + i * NONCE_SIZE;
+		ops[i].nonceLength = NONCE_SIZE;
+		ops[i].aad = aad + i * AAD_SIZE;
+		ops[i].aadLength = AAD_SIZE;
+		ops[i].in = plaintext + i * length;
+		ops[i].out = data + i * length;
+		ops[i].length = length;
+		ops[i].tag = tags + i * GCM_TAG_SIZE;
+		ops[i].tagLength = GCM_TAG_SIZE;
+	}
+
+	for (t = 0; t < BENCH_TRIALS; t++)
+	{
+		start = BENCH_now();
+		for (n = 0; n < iterations; n++)
+		{
+			for (i = 0; i < count; i++)
+			{
+				GCM_seal(ops[i].gcm, ops[i].nonce, NONCE_SIZE, ops[i].aad, AAD_SIZE,
+					ops[i].in, expected + i * length, length, expectedTags + i * GCM_TAG_SIZE, GCM_TAG_SIZE);
+			}
+		}
+		separate[t] = packetRate((BENCH_now() - start) / iterations, count);
+
+		start = BENCH_now();
+		for (n = 0; n < iterations; n++)
+		{
+			BURST_process(ops, count);
+		}
+		burst[t] = packetRate((BENCH_now() - start) / iterations, count);
+	}
+
+	printf("%s, %zu packets of %zu bytes, %zu keys\n", cipher->name, count, length, nrKeys);
+	printf("%-10s %10.2f Mpackets/s\n", "per packet", BENCH_median(separate, BENCH_TRIALS));
+	printf("%-10s %10.2f Mpackets/s\n", "burst", BENCH_median(burst, BENCH_TRIALS));
+
+	if (memcmp(data, expected, count * length) != 0 || memcmp(tags, expectedTags, count * GCM_TAG_SIZE) != 0)
+	{
+		printf("FAIL: burst seal differs from GCM_seal\n");
+		failures++;
+	}
+
+	// open in place, the last packet with a corrupted tag
+	for (i = 0; i < count; i++)
+	{
+		ops[i].operation = BURST_GCM_OPEN;
+		ops[i].in = data + i * length;
+	}
+	tags[(count - 1) * GCM_TAG_SIZE] ^= 1;
+
+	if (BURST_process(ops, count) != 1 || ops[count - 1].status != CIPHER_ERROR_TAG)
+	{
+		printf("FAIL: burst open did not reject the corrupted tag only\n");
+		failures++;
+	}
+	if (memcmp(data, plaintext, (count - 1) * length) != 0)
+	{
+		printf("FAIL: burst open differs from the plaintext\n");
+		failures++;
+	}
+	for (i = (count - 1) * length; i < count * length; i++)
+	{
+		if (data[i] != 0)
+		{
+			printf("FAIL: rejected packet was released\n");
+			failures++;
+			break;
+		}
+	}
+
+	free(nonces);
+	free(aad);
+	free(plaintext);
+	free(expected);
+	free(data);
+	free(expectedTags);
+	free(tags);
+	free(ops);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
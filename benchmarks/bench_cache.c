@@ -0,0 +1,193 @@
+/* bench_cache.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Cache-cold and cache-pressure benchmark. A request is a small ECB
+ * call (-s bytes, 64 by default) and its latency is measured under:
+ *		- hot:      back to back calls, everything cache resident
+ *		- flush:    clflush of the cipher's lookup tables and context
+ *		            before every call
+ *		- evict:    walk of an eviction buffer (-e KiB) between calls,
+ *		            as other work of a service would do
+ *		- corunner: a second thread streams over its own buffer (-p KiB)
+ *		            for the whole run, competing for the shared cache
+ *
+ * Table-based ciphers (lookup tables reported by the descriptor) are
+ * listed next to the table-free ARX/bitwise ones to compare how both
+ * kinds degrade when the cache is not on their side.
+ *
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define NR_CALLS 2001
+
+typedef struct
+{
+	uint8_t* buffer;
+	size_t length;
+	volatile int stop;
+} Corunner;
+
+static double timerOverhead;
+
+static void* corunnerMain(void* argument)
+{
+	Corunner* corunner = (Corunner*)argument;
+	size_t i;
+
+	while (!corunner->stop)
+	{
+		for (i = 0; i < corunner->length; i += 64)
+		{
+			corunner->buffer[i]++;
+		}
+	}
+
+	return NULL;
+}
+
+static void evict(uint8_t* buffer, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i += 64)
+	{
+		buffer[i]++;
+	}
+}
+
+static void flushCipher(CipherContext* context)
+{
+	const void* address;
+	size_t size;
+	int i;
+
+	for (i = 0; (size = CIPHER_lookup_table(context->cipher, i, &address)) != 0; i++)
+	{
+		BENCH_flush(address, size);
+	}
+	BENCH_flush(context, sizeof(CipherContext));
+	BENCH_fence();
+}
+
+// median latency in ns of one request under the given condition
+static double requestLatency(CipherContext* context, uint8_t* data, size_t nrBlocks, int flush, uint8_t* evictBuffer, size_t evictLength)
+{
+	static double samples[NR_CALLS];
+	uint64_t start;
+	int i;
+
+	for (i = 0; i < NR_CALLS; i++)
+	{
+		if (flush)
+		{
+			flushCipher(context);
+		}
+		if (evictBuffer != NULL)
+		{
+			evict(evictBuffer, evictLength);
+		}
+
+		start = BENCH_now();
+		CIPHER_encrypt_blocks(context, data, data, nrBlocks);
+		samples[i] = BENCH_now() - start - timerOverhead;
+	}
+
+	return BENCH_median(samples, NR_CALLS);
+}
+
+static void measureTimerOverhead(void)
+{
+	static double samples[NR_CALLS];
+	uint64_t start;
+	int i;
+
+	for (i = 0; i < NR_CALLS; i++)
+	{
+		start = BENCH_now();
+		samples[i] = BENCH_now() - start;
+	}
+	timerOverhead = BENCH_median(samples, NR_CALLS);
+}
+
+int BENCH_cache(int argc, char** argv)
+{
+	const CipherDescriptor* filter = BENCH_cipher_option(argc, argv);
+	size_t requestLength = (size_t)BENCH_long_option(argc, argv, "-s", 64);
+	size_t evictLength = (size_t)BENCH_long_option(argc, argv, "-e", 8 * 1024) * 1024;
+	size_t corunnerLength = (size_t)BENCH_long_option(argc, argv, "-p", 8 * 1024) * 1024;
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	CipherContext context;
+	Corunner corunner;
+	pthread_t thread;
+	uint8_t* evictBuffer;
+	uint8_t* data;
+	int i;
+
+	measureTimerOverhead();
+
+	BENCH_random_bytes(key, sizeof(key));
+	evictBuffer = malloc(evictLength);
+	memset(evictBuffer, 0, evictLength);
+	data = malloc(requestLength + CIPHER_MAX_BLOCK_SIZE);
+	BENCH_random_bytes(data, requestLength + CIPHER_MAX_BLOCK_SIZE);
+
+	printf("request %zu bytes, evict %zu KiB, corunner %zu KiB%s\n", requestLength, evictLength / 1024, corunnerLength / 1024,
+		BENCH_can_flush() ? "" : ", clflush not available");
+	printf("%-9s %-6s %7s %9s %9s %7s %9s %7s %9s %7s\n", "cipher", "kind", "tables", "hot ns", "flush ns", "x hot", "evict ns", "x hot", "corun ns", "x hot");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+		size_t nrBlocks = (requestLength + cipher->blockSize - 1) / cipher->blockSize;
+		size_t tables = 0;
+		const void* address;
+		size_t size;
+		double hot;
+		double flushed;
+		double evicted;
+		double contended;
+		int t;
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		for (t = 0; (size = CIPHER_lookup_table(cipher, t, &address)) != 0; t++)
+		{
+			tables += size;
+		}
+
+		CIPHER_init(&context, cipher->id, key, cipher->keyLengths[0]);
+
+		hot = requestLatency(&context, data, nrBlocks, 0, NULL, 0);
+		flushed = BENCH_can_flush() ? requestLatency(&context, data, nrBlocks, 1, NULL, 0) : 0;
+		evicted = requestLatency(&context, data, nrBlocks, 0, evictBuffer, evictLength);
+
+		corunner.length = corunnerLength;
+		corunner.buffer = malloc(corunnerLength);
+		memset(corunner.buffer, 0, corunnerLength);
+		corunner.stop = 0;
+		pthread_create(&thread, NULL, corunnerMain, &corunner);
+		contended = requestLatency(&context, data, nrBlocks, 0, NULL, 0);
+		corunner.stop = 1;
+		pthread_join(thread, NULL);
+		free(corunner.buffer);
+
+		printf("%-9s %-6s %7zu %9.1f %9.1f %7.2f %9.1f %7.2f %9.1f %7.2f\n", cipher->name,
+			cipher->lookupTable != NULL ? "table" : "alu", tables,
+			hot, flushed, flushed / hot, evicted, evicted / hot, contended, contended / hot);
+	}
+
+	free(data);
+	free(evictBuffer);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+/* bench_column.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Encryption of a string column of -n rows (1000000 by default) with
+ * random lengths from 0 to 2 * -w bytes (16), and of a fixed -w bytes
+ * column, with a cipher (-c, ARIA by default):
+ *		- per value: one MODES_ctr_crypt call per value, counter built
+ *		  from its row ID
+ *		- column: COLUMN_encrypt_variable/COLUMN_encrypt_fixed, randomized
+ *		- deterministic: the strings in the deterministic mode, per value
+ *		  as one COLUMN_encrypt_variable call of a single row each
+ *
+ * Both columns must match their per-value calls. The deterministic one must
+ * not depend on the row IDs, and the xor of two ciphertexts of the same
+ * length must not be the xor of their values, as it would be with a shared
+ * keystream. Both must decrypt back.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/COLUMN/COLUMN.h"
+#include "../algorithms/MODES/MODES.h"
+
+// nonce + (row << 32), big-endian
+static void rowCounter(uint8_t* counter, const uint8_t* nonce, size_t blockSize, uint64_t row)
+{
+	unsigned int sum;
+	size_t i;
+
+	memcpy(counter, nonce, blockSize);
+	for (i = blockSize - 4; i > 0 && row != 0; i--)
+	{
+		sum = counter[i - 1] + (unsigned int)(row & 0xff);
+		counter[i - 1] = (uint8_t)sum;
+		row = (row >> 8) + (sum >> 8);
+	}
+}
+
+// whether two values of the same length (4 bytes or more) have ciphertexts with the xor of the values
+static int xorLeaks(const uint32_t* offsets, const uint8_t* values, const uint8_t* ciphertexts, size_t count)
+{
+	size_t previous[4096] = { 0 };
+	size_t length;
+	size_t a;
+	size_t b;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < count; i++)
+	{
+		length = offsets[i + 1] - offsets[i];
+		if (length < 4 || length >= 4096)
+		{
+			continue;
+		}
+		if (previous[length] != 0)
+		{
+			a = offsets[previous[length] - 1];
+			b = offsets[i];
+			for (j = 0; j < length; j++)
+			{
+				if ((values[a + j] ^ values[b + j]) != (ciphertexts[a + j] ^ ciphertexts[b + j]))
+				{
+					break;
+				}
+			}
+			if (j == length)
+			{
+				return 1;
+			}
+		}
+		previous[length] = i + 1;
+	}
+
+	return 0;
+}
+
+static double throughput(uint64_t nanoseconds, size_t length)
+{
+	return (double)length / nanoseconds * 1000;
+}
+
+int BENCH_column(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	size_t count = (size_t)BENCH_long_option(argc, argv, "-n", 1000000);
+	size_t width = (size_t)BENCH_long_option(argc, argv, "-w", 16);
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	uint8_t nonce[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t counter[CIPHER_MAX_BLOCK_SIZE];
+	CipherContext context;
+	uint32_t* offsets;
+	uint8_t* values;
+	uint8_t* expected;
+	uint8_t* data;
+	double perValue[3] = { 0 };
+	double column[3] = { 0 };
+	double speed;
+	size_t total;
+	size_t fixedTotal = count * width;
+	uint64_t start;
+	int failures = 0;
+	int deterministic;
+	size_t i;
+	int t;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_ARIA);
+	}
+
+	BENCH_random_bytes(key, sizeof(key));
+	BENCH_random_bytes(nonce, sizeof(nonce));
+	CIPHER_init_encrypt(&context, cipher->id, key, cipher->keyLengths[0]);
+
+	offsets = malloc((count + 1) * sizeof(uint32_t));
+	BENCH_random_bytes((uint8_t*)offsets, (count + 1) * sizeof(uint32_t));
+	total = 0;
+	for (i = 0; i < count; i++)
+	{
+		size_t length = offsets[i + 1] % (2 * width + 1);
+
+		offsets[i] = (uint32_t)total;
+		total += length;
+	}
+	offsets[count] = (uint32_t)total;
+
+	values = malloc(total > fixedTotal ? total : fixedTotal);
+	expected = malloc(total > fixedTotal ? total : fixedTotal);
+	data = malloc(total > fixedTotal ? total : fixedTotal);
+	BENCH_random_bytes(values, total > fixedTotal ? total : fixedTotal);
+
+	printf("%s, %zu rows, %zu bytes of strings, %zu bytes fixed width\n", cipher->name, count, total, width);
+	printf("%-20s %14s %14s %8s\n", "column", "per value MB/s", "column MB/s", "speedup");
+
+	// strings randomized, strings deterministic, fixed width randomized
+	for (deterministic = 0; deterministic < 3; deterministic++)
+	{
+		int fixed = deterministic == 2;
+		size_t length = fixed ? fixedTotal : total;
+		ColumnMode mode = deterministic == 1 ? COLUMN_DETERMINISTIC : COLUMN_RANDOMIZED;
+
+		for (t = 0; t < BENCH_TRIALS; t++)
+		{
+			start = BENCH_now();
+			for (i = 0; i < count; i++)
+			{
+				size_t offset = fixed ? i * width : offsets[i];
+
+				if (mode == COLUMN_DETERMINISTIC)
+				{
+					// offsets are absolute, so a single row needs no rebasing
+					COLUMN_encrypt_variable(&context, mode, nonce, i, offsets + i, values, expected, 1);
+				}
+				else
+				{
+					rowCounter(counter, nonce, cipher->blockSize, i);
+					MODES_ctr_crypt(&context, counter, values + offset, expected + offset, fixed ? width : offsets[i + 1] - offsets[i]);
+				}
+			}
+			speed = throughput(BENCH_now() - start, length);
+			perValue[deterministic] = speed > perValue[deterministic] ? speed : perValue[deterministic];
+
+			start = BENCH_now();
+			if (fixed)
+			{
+				COLUMN_encrypt_fixed(&context, mode, nonce, 0, values, data, width, count);
+			}
+			else
+			{
+				COLUMN_encrypt_variable(&context, mode, nonce, 0, offsets, values, data, count);
+			}
+			speed = throughput(BENCH_now() - start, length);
+			column[deterministic] = speed > column[deterministic] ? speed : column[deterministic];
+		}
+
+		printf("%-20s %14.1f %14.1f %7.2fx\n", fixed ? "fixed randomized" : mode == COLUMN_DETERMINISTIC ? "strings determin." : "strings randomized",
+			perValue[deterministic], column[deterministic], column[deterministic] / perValue[deterministic]);
+
+		if (memcmp(data, expected, length) != 0)
+		{
+			printf("FAIL: column output differs from the per-value calls\n");
+			failures++;
+		}
+
+		if (mode == COLUMN_DETERMINISTIC)
+		{
+			COLUMN_encrypt_variable(&context, mode, nonce, 12345, offsets, values, expected, count);
+			if (memcmp(data, expected, length) != 0)
+			{
+				printf("FAIL: deterministic output depends on the row IDs\n");
+				failures++;
+			}
+			if (xorLeaks(offsets, values, data, count))
+			{
+				printf("FAIL: deterministic ciphertexts keep the xor of the values\n");
+				failures++;
+			}
+		}
+
+		if (fixed)
+		{
+			COLUMN_decrypt_fixed(&context, mode, nonce, 0, data, data, width, count);
+		}
+		else
+		{
+			COLUMN_decrypt_variable(&context, mode, nonce, 0, offsets, data, data, count);
+		}
+		if (memcmp(data, values, length) != 0)
+		{
+			printf("FAIL: column decryption differs from the values\n");
+			failures++;
+		}
+	}
+
+	free(offsets);
+	free(values);
+	free(expected);
+	free(data);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,304 @@
+/* bench_counters.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Hardware performance counters around each measured kernel, to tell
+ * whether a cipher is bound by lookups, ALU work or branches. For the
+ * block kernel (ECB over -s bytes) and the key setup of every cipher it
+ * reports, through perf_event_open (user space only):
+ *		- cycles and instructions per byte, IPC
+ *		- L1D read misses, LLC read misses and branch misses per block
+ *		- with -p 1, uops dispatched to ports 0, 1, 5 and 6 per block
+ *		  (raw Intel events of Skylake to Ice Lake, skipped elsewhere)
+ *
+ * Counters that cannot be opened (paranoid level, containers, virtual
+ * machines or other CPUs) are printed as "-", and the wall clock time
+ * is always reported.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+typedef enum
+{
+	EVENT_CYCLES,
+	EVENT_INSTRUCTIONS,
+	EVENT_L1D_MISSES,
+	EVENT_LLC_MISSES,
+	EVENT_BRANCH_MISSES,
+	EVENT_PORT_0,
+	EVENT_PORT_1,
+	EVENT_PORT_5,
+	EVENT_PORT_6,
+	EVENT_COUNT
+} EventId;
+
+typedef struct
+{
+	int fd[EVENT_COUNT];
+	double value[EVENT_COUNT];
+	uint64_t elapsed;
+} Counters;
+
+#ifdef __linux__
+static int openEvent(uint32_t type, uint64_t config)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	// scaled by enabled/running time when the PMU multiplexes events
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t cacheMiss(uint64_t cache)
+{
+	return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// UOPS_DISPATCHED.PORT_n, event 0xa1 (Skylake, Cascade Lake, Ice Lake)
+static int hasPortEvents(void)
+{
+	FILE* file = fopen("/proc/cpuinfo", "r");
+	char line[256];
+	int intel = 0;
+
+	if (file == NULL)
+	{
+		return 0;
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		if (strncmp(line, "vendor_id", 9) == 0)
+		{
+			intel = strstr(line, "GenuineIntel") != NULL;
+			break;
+		}
+	}
+	fclose(file);
+
+	return intel;
+}
+#endif
+
+static void openCounters(Counters* counters, int ports)
+{
+	int i;
+
+	for (i = 0; i < EVENT_COUNT; i++)
+	{
+		counters->fd[i] = -1;
+	}
+
+#ifdef __linux__
+	counters->fd[EVENT_CYCLES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	counters->fd[EVENT_INSTRUCTIONS] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	counters->fd[EVENT_L1D_MISSES] = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D));
+	counters->fd[EVENT_LLC_MISSES] = openEvent(PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL));
+	counters->fd[EVENT_BRANCH_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+
+	if (ports && hasPortEvents())
+	{
+		counters->fd[EVENT_PORT_0] = openEvent(PERF_TYPE_RAW, 0x01a1);
+		counters->fd[EVENT_PORT_1] = openEvent(PERF_TYPE_RAW, 0x02a1);
+		counters->fd[EVENT_PORT_5] = openEvent(PERF_TYPE_RAW, 0x20a1);
+		counters->fd[EVENT_PORT_6] = openEvent(PERF_TYPE_RAW, 0x40a1);
+	}
+#endif
+}
+
+static void closeCounters(Counters* counters)
+{
+	int i;
+
+	for (i = 0; i < EVENT_COUNT; i++)
+	{
+		if (counters->fd[i] >= 0)
+		{
+#ifdef __linux__
+			close(counters->fd[i]);
+#endif
+		}
+	}
+}
+
+static int available(const Counters* counters, EventId event)
+{
+	return counters->fd[event] >= 0;
+}
+
+static void startCounters(Counters* counters)
+{
+	int i;
+
+	for (i = 0; i < EVENT_COUNT; i++)
+	{
+		if (counters->fd[i] >= 0)
+		{
+#ifdef __linux__
+			ioctl(counters->fd[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(counters->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+#endif
+		}
+	}
+	counters->elapsed = BENCH_now();
+}
+
+static void stopCounters(Counters* counters)
+{
+	uint64_t data[3];
+	int i;
+
+	counters->elapsed = BENCH_now() - counters->elapsed;
+
+	for (i = 0; i < EVENT_COUNT; i++)
+	{
+		counters->value[i] = 0;
+		if (counters->fd[i] < 0)
+		{
+			continue;
+		}
+
+#ifdef __linux__
+		ioctl(counters->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+		if (read(counters->fd[i], data, sizeof(data)) == sizeof(data) && data[2] != 0)
+		{
+			counters->value[i] = (double)data[0] * data[1] / data[2];
+		}
+#endif
+	}
+}
+
+static void printValue(const Counters* counters, EventId event, double divisor, int width)
+{
+	if (available(counters, event))
+	{
+		printf(" %*.2f", width, counters->value[event] / divisor);
+	}
+	else
+	{
+		printf(" %*s", width, "-");
+	}
+}
+
+static void printRow(const CipherDescriptor* cipher, const char* kernel, const Counters* counters, double nrBlocks, double nrBytes, int ports)
+{
+	printf("%-9s %-6s %9.2f", cipher->name, kernel, counters->elapsed / nrBytes);
+	printValue(counters, EVENT_CYCLES, nrBytes, 9);
+	printValue(counters, EVENT_CYCLES, nrBlocks, 10);
+	printValue(counters, EVENT_INSTRUCTIONS, nrBytes, 9);
+
+	if (available(counters, EVENT_CYCLES) && available(counters, EVENT_INSTRUCTIONS) && counters->value[EVENT_CYCLES] > 0)
+	{
+		printf(" %5.2f", counters->value[EVENT_INSTRUCTIONS] / counters->value[EVENT_CYCLES]);
+	}
+	else
+	{
+		printf(" %5s", "-");
+	}
+
+	printValue(counters, EVENT_L1D_MISSES, nrBlocks, 9);
+	printValue(counters, EVENT_LLC_MISSES, nrBlocks, 9);
+	printValue(counters, EVENT_BRANCH_MISSES, nrBlocks, 9);
+
+	if (ports)
+	{
+		printValue(counters, EVENT_PORT_0, nrBlocks, 8);
+		printValue(counters, EVENT_PORT_1, nrBlocks, 8);
+		printValue(counters, EVENT_PORT_5, nrBlocks, 8);
+		printValue(counters, EVENT_PORT_6, nrBlocks, 8);
+	}
+	printf("\n");
+}
+
+int BENCH_counters(int argc, char** argv)
+{
+	const CipherDescriptor* filter = BENCH_cipher_option(argc, argv);
+	size_t length = (size_t)BENCH_long_option(argc, argv, "-s", 4096);
+	long iterations = BENCH_long_option(argc, argv, "-n", 200);
+	int ports = (int)BENCH_long_option(argc, argv, "-p", 0);
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	CipherContext context;
+	Counters counters;
+	uint8_t* data;
+	long r;
+	int i;
+
+	openCounters(&counters, ports);
+	if (!available(&counters, EVENT_CYCLES) && !available(&counters, EVENT_INSTRUCTIONS))
+	{
+		printf("hardware counters not permitted or not supported (see /proc/sys/kernel/perf_event_paranoid), wall clock only\n");
+	}
+	else if (ports && !available(&counters, EVENT_PORT_0))
+	{
+		printf("port events not available on this CPU\n");
+	}
+
+	BENCH_random_bytes(key, sizeof(key));
+	data = malloc(length + CIPHER_MAX_BLOCK_SIZE);
+	BENCH_random_bytes(data, length + CIPHER_MAX_BLOCK_SIZE);
+
+	printf("ecb over %zu bytes x %ld, init x %ld (per call instead of per block)\n", length, iterations, iterations * 16);
+	printf("%-9s %-6s %9s %9s %10s %9s %5s %9s %9s %9s", "cipher", "kernel", "ns/B", "cyc/B", "cyc/blk", "ins/B", "IPC", "L1D/blk", "LLC/blk", "brm/blk");
+	if (ports)
+	{
+		printf(" %8s %8s %8s %8s", "p0/blk", "p1/blk", "p5/blk", "p6/blk");
+	}
+	printf("\n");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+		size_t nrBlocks = (length + cipher->blockSize - 1) / cipher->blockSize;
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		CIPHER_init(&context, cipher->id, key, cipher->keyLengths[0]);
+
+		// warm up, so the counters see the steady state
+		CIPHER_encrypt_blocks(&context, data, data, nrBlocks);
+
+		startCounters(&counters);
+		for (r = 0; r < iterations; r++)
+		{
+			CIPHER_encrypt_blocks(&context, data, data, nrBlocks);
+		}
+		stopCounters(&counters);
+		printRow(cipher, "ecb", &counters, (double)nrBlocks * iterations, (double)nrBlocks * cipher->blockSize * iterations, ports);
+
+		startCounters(&counters);
+		for (r = 0; r < iterations * 16; r++)
+		{
+			CIPHER_init(&context, cipher->id, key, cipher->keyLengths[0]);
+		}
+		stopCounters(&counters);
+		printRow(cipher, "init", &counters, (double)iterations * 16, (double)iterations * 16, ports);
+	}
+
+	closeCounters(&counters);
+	free(data);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,365 @@
+/* bench_drbg.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * CTR_DRBG over ARIA, CAMELLIA and SEED (or -c), -n requests of -s bytes
+ * (1000000 requests of 16 bytes by default):
+ *		- ns per small DRBG_generate request, served from the buffer
+ *		- MB/s of 64 KiB requests, straight from the Generate calls
+ *		- ns per DRBG_random_bytes request with -t threads (4), each on
+ *		  its own thread instance
+ *
+ * Checks the output of instantiate, generate, generate (the flow of the
+ * CAVP known answer tests) for every key length against a reference
+ * written block by block from SP 800-90A; there are no published vectors
+ * for these ciphers. Also checks that two instances with the same entropy
+ * input give the same output whatever the request sizes, that threads get
+ * different bytes and that a forked child does not repeat the bytes of
+ * its parent.
+ *
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "../algorithms/DRBG/DRBG.h"
+
+#define MAX_THREADS 64
+#define LARGE_REQUEST (64 << 10)
+
+typedef struct
+{
+	pthread_t thread;
+	long requests;
+	size_t length;
+	uint8_t first[16];
+	uint64_t nanoseconds;
+} Worker;
+
+// CTR_DRBG without derivation function, one CIPHER_encrypt per block
+typedef struct
+{
+	CipherContext cipher;
+	uint8_t V[16];
+	uint16_t keyLen;
+} Reference;
+
+static void referenceIncrement(uint8_t* V)
+{
+	int i;
+
+	for (i = 15; i >= 0; i--)
+	{
+		if (++V[i] != 0)
+		{
+			break;
+		}
+	}
+}
+
+// CTR_DRBG_Update (10.2.1.2), providedData of the seed length
+static void referenceUpdate(Reference* reference, const uint8_t* providedData)
+{
+	uint8_t temp[DRBG_MAX_SEED_LENGTH + 16];
+	size_t seedLength = reference->keyLen / 8 + 16;
+	size_t i;
+
+	for (i = 0; i < seedLength; i += 16)
+	{
+		referenceIncrement(reference->V);
+		CIPHER_encrypt(&reference->cipher, reference->V, temp + i);
+	}
+	for (i = 0; i < seedLength; i++)
+	{
+		temp[i] ^= providedData[i];
+	}
+
+	CIPHER_init_encrypt(&reference->cipher, reference->cipher.cipher->id, temp, reference->keyLen);
+	memcpy(reference->V, temp + reference->keyLen / 8, 16);
+}
+
+// CTR_DRBG_Instantiate_algorithm (10.2.1.3.1)
+static void referenceInstantiate(Reference* reference, CipherId id, uint16_t keyLen, const uint8_t* entropyInput,
+								 const uint8_t* personalization, size_t personalizationLength)
+{
+	uint8_t zeros[CIPHER_MAX_KEY_SIZE] = { 0 };
+	uint8_t seedMaterial[DRBG_MAX_SEED_LENGTH];
+	size_t i;
+
+	for (i = 0; i < keyLen / 8u + 16; i++)
+	{
+		seedMaterial[i] = entropyInput[i] ^ (i < personalizationLength ? personalization[i] : 0);
+	}
+
+	CIPHER_init_encrypt(&reference->cipher, id, zeros, keyLen);
+	memset(reference->V, 0, 16);
+	reference->keyLen = keyLen;
+	referenceUpdate(reference, seedMaterial);
+}
+
+// CTR_DRBG_Generate_algorithm (10.2.1.5.1) without additional input, length a multiple of 16
+static void referenceGenerate(Reference* reference, uint8_t* out, size_t length)
+{
+	uint8_t zeros[DRBG_MAX_SEED_LENGTH] = { 0 };
+	size_t i;
+
+	for (i = 0; i < length; i += 16)
+	{
+		referenceIncrement(reference->V);
+		CIPHER_encrypt(&reference->cipher, reference->V, out + i);
+	}
+	referenceUpdate(reference, zeros);
+}
+
+static void* workerMain(void* argument)
+{
+	Worker* worker = argument;
+	uint8_t data[256];
+	uint64_t start;
+	long i;
+
+	DRBG_random_bytes(worker->first, sizeof(worker->first));
+
+	start = BENCH_now();
+	for (i = 0; i < worker->requests; i++)
+	{
+		DRBG_random_bytes(data, worker->length);
+	}
+	worker->nanoseconds = BENCH_now() - start;
+
+	return NULL;
+}
+
+static int checkCipher(const CipherDescriptor* cipher, uint16_t keyLen)
+{
+	uint8_t entropy[DRBG_MAX_SEED_LENGTH];
+	uint8_t* a = malloc(3 * DRBG_BUFFER_SIZE);
+	uint8_t* b = malloc(3 * DRBG_BUFFER_SIZE);
+	DrbgContext* x = malloc(sizeof(DrbgContext));
+	DrbgContext* y = malloc(sizeof(DrbgContext));
+	size_t offset;
+	size_t n;
+	int failures = 0;
+
+	BENCH_random_bytes(entropy, sizeof(entropy));
+	DRBG_instantiate(x, cipher->id, keyLen, entropy, NULL, 0);
+	DRBG_instantiate(y, cipher->id, keyLen, entropy, NULL, 0);
+
+	DRBG_generate(x, a, 3 * DRBG_BUFFER_SIZE);
+	for (offset = 0; offset < 3 * DRBG_BUFFER_SIZE; offset += n)
+	{
+		n = offset % 7 + 1;
+		n = n < 3 * DRBG_BUFFER_SIZE - offset ? n : 3 * DRBG_BUFFER_SIZE - offset;
+		DRBG_generate(y, b + offset, n);
+	}
+	if (memcmp(a, b, 3 * DRBG_BUFFER_SIZE) != 0)
+	{
+		printf("FAIL: %s output depends on the request sizes\n", cipher->name);
+		failures++;
+	}
+
+	DRBG_uninstantiate(x);
+	DRBG_uninstantiate(y);
+	free(a);
+	free(b);
+	free(x);
+	free(y);
+
+	return failures;
+}
+
+// instantiate, generate, generate of one SP 800-90A Generate call each, as a CAVP test
+static int checkKnownAnswer(const CipherDescriptor* cipher, uint16_t keyLen)
+{
+	uint8_t entropy[DRBG_MAX_SEED_LENGTH];
+	uint8_t personalization[16];
+	uint8_t* output = malloc(2 * DRBG_BUFFER_SIZE);
+	uint8_t* expected = malloc(2 * DRBG_BUFFER_SIZE);
+	DrbgContext* context = malloc(sizeof(DrbgContext));
+	Reference reference;
+	int failures = 0;
+	size_t i;
+
+	for (i = 0; i < sizeof(entropy); i++)
+	{
+		entropy[i] = (uint8_t)i;
+	}
+	for (i = 0; i < sizeof(personalization); i++)
+	{
+		personalization[i] = (uint8_t)(0x80 + i);
+	}
+
+	DRBG_instantiate(context, cipher->id, keyLen, entropy, personalization, sizeof(personalization));
+	DRBG_generate(context, output, DRBG_BUFFER_SIZE);
+	DRBG_generate(context, output + DRBG_BUFFER_SIZE, DRBG_BUFFER_SIZE);
+
+	referenceInstantiate(&reference, cipher->id, keyLen, entropy, personalization, sizeof(personalization));
+	referenceGenerate(&reference, expected, DRBG_BUFFER_SIZE);
+	referenceGenerate(&reference, expected + DRBG_BUFFER_SIZE, DRBG_BUFFER_SIZE);
+
+	if (memcmp(output, expected, 2 * DRBG_BUFFER_SIZE) != 0)
+	{
+		printf("FAIL: %s %u bits output differs from the SP 800-90A reference\n", cipher->name, keyLen);
+		failures++;
+	}
+
+	DRBG_uninstantiate(context);
+	free(output);
+	free(expected);
+	free(context);
+
+	return failures;
+}
+
+static int checkFork(void)
+{
+	uint8_t parent[16];
+	uint8_t child[16];
+	int pipes[2];
+	pid_t pid;
+
+	// the thread instance holds buffered bytes the child must not reuse
+	DRBG_random_bytes(parent, 1);
+	if (pipe(pipes) != 0)
+	{
+		return 0;
+	}
+
+	pid = fork();
+	if (pid == 0)
+	{
+		DRBG_random_bytes(child, sizeof(child));
+		if (write(pipes[1], child, sizeof(child)) != sizeof(child))
+		{
+			_exit(1);
+		}
+		_exit(0);
+	}
+
+	DRBG_random_bytes(parent, sizeof(parent));
+	if (read(pipes[0], child, sizeof(child)) != sizeof(child))
+	{
+		memcpy(child, parent, sizeof(child));
+	}
+	waitpid(pid, NULL, 0);
+	close(pipes[0]);
+	close(pipes[1]);
+
+	if (memcmp(parent, child, sizeof(parent)) == 0)
+	{
+		printf("FAIL: the forked child repeats the bytes of its parent\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int BENCH_drbg(int argc, char** argv)
+{
+	const CipherDescriptor* selected = BENCH_cipher_option(argc, argv);
+	long requests = BENCH_long_option(argc, argv, "-n", 1000000);
+	size_t length = (size_t)BENCH_long_option(argc, argv, "-s", 16);
+	int nrThreads = (int)BENCH_long_option(argc, argv, "-t", 4);
+	static const CipherId ids[] = { CIPHER_ARIA, CIPHER_CAMELLIA, CIPHER_SEED };
+	Worker workers[MAX_THREADS];
+	DrbgContext* context = malloc(sizeof(DrbgContext));
+	uint8_t* data = malloc(LARGE_REQUEST);
+	const CipherDescriptor* cipher;
+	double small;
+	double large;
+	double elapsed;
+	uint64_t start;
+	uint64_t slowest;
+	int failures = 0;
+	long i;
+	int c;
+	int k;
+	int t;
+
+	length = length < 256 ? length : 256;
+	nrThreads = nrThreads < 1 ? 1 : nrThreads > MAX_THREADS ? MAX_THREADS : nrThreads;
+
+	printf("%zu bytes requests\n", length);
+	printf("%-10s %14s %16s\n", "cipher", "ns/request", "64 KiB req MB/s");
+
+	for (c = 0; c < 3; c++)
+	{
+		cipher = selected != NULL ? selected : CIPHER_get(ids[c]);
+		if (DRBG_init(context, cipher->id, cipher->keyLengths[0], NULL, NULL, 0) != CIPHER_OK)
+		{
+			printf("%-10s not a 128 bits cipher\n", cipher->name);
+			free(context);
+			free(data);
+			return 1;
+		}
+
+		small = 0;
+		large = 0;
+		for (t = 0; t < BENCH_TRIALS; t++)
+		{
+			start = BENCH_now();
+			for (i = 0; i < requests; i++)
+			{
+				DRBG_generate(context, data, length);
+			}
+			elapsed = (double)(BENCH_now() - start) / requests;
+			small = t == 0 || elapsed < small ? elapsed : small;
+
+			start = BENCH_now();
+			for (i = 0; i < 16; i++)
+			{
+				DRBG_generate(context, data, LARGE_REQUEST);
+			}
+			elapsed = (double)16 * LARGE_REQUEST / (BENCH_now() - start) * 1000;
+			large = elapsed > large ? elapsed : large;
+		}
+		printf("%-10s %14.1f %16.1f\n", cipher->name, small, large);
+
+		failures += checkCipher(cipher, cipher->keyLengths[0]);
+		for (k = 0; k < cipher->nrKeyLengths; k++)
+		{
+			failures += checkKnownAnswer(cipher, cipher->keyLengths[k]);
+		}
+		if (selected != NULL)
+		{
+			break;
+		}
+	}
+	DRBG_uninstantiate(context);
+
+	for (t = 0; t < nrThreads; t++)
+	{
+		workers[t].requests = requests;
+		workers[t].length = length;
+		pthread_create(&workers[t].thread, NULL, workerMain, &workers[t]);
+	}
+	slowest = 0;
+	for (t = 0; t < nrThreads; t++)
+	{
+		pthread_join(workers[t].thread, NULL);
+		slowest = workers[t].nanoseconds > slowest ? workers[t].nanoseconds : slowest;
+	}
+	printf("%d thread(s), DRBG_random_bytes: %.1f ns/request per thread\n", nrThreads, (double)slowest / requests);
+
+	for (t = 1; t < nrThreads; t++)
+	{
+		if (memcmp(workers[t].first, workers[0].first, sizeof(workers[0].first)) == 0)
+		{
+			printf("FAIL: two threads got the same bytes\n");
+			failures++;
+			break;
+		}
+	}
+
+	failures += checkFork();
+
+	free(context);
+	free(data);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/* bench_fpe.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Tokenization of -n values of -l numerals in radix -r (4096 card
+ * number like values of 16 decimal digits by default), with FF1 and
+ * FF3-1 over a 128 bits cipher (-c, ARIA by default):
+ *		- single: one FPE_encrypt call per value
+ *		- batch: FPE_encrypt_many over all the values
+ *
+ * Both must give the same tokens, every numeral of a token must be
+ * below the radix and the batch decryption must give the values back;
+ * the time per value is the minimum of the trials.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/FPE/FPE.h"
+
+static const char* methodNames[] = { "FF1", "FF3-1" };
+
+int BENCH_fpe(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	size_t count = (size_t)BENCH_long_option(argc, argv, "-n", 4096);
+	size_t length = (size_t)BENCH_long_option(argc, argv, "-l", 16);
+	uint32_t radix = (uint32_t)BENCH_long_option(argc, argv, "-r", 10);
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	FpeContext context;
+	uint16_t* values;
+	uint16_t* single;
+	uint16_t* batch;
+	uint8_t* tweaks;
+	size_t tweakLength;
+	double singleTime = 0;
+	double batchTime = 0;
+	uint64_t start;
+	double elapsed;
+	int failures = 0;
+	size_t i;
+	int m;
+	int t;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_ARIA);
+	}
+
+	values = malloc(count * length * sizeof(uint16_t));
+	single = malloc(count * length * sizeof(uint16_t));
+	batch = malloc(count * length * sizeof(uint16_t));
+	tweaks = malloc(count * 8);
+	BENCH_random_bytes(key, sizeof(key));
+	BENCH_random_bytes((uint8_t*)values, count * length * sizeof(uint16_t));
+	BENCH_random_bytes(tweaks, count * 8);
+	for (i = 0; i < count * length; i++)
+	{
+		values[i] = (uint16_t)(values[i] % radix);
+	}
+
+	printf("%s, %zu values of %zu numerals in radix %u\n", cipher->name, count, length, radix);
+	printf("%-6s %14s %14s %8s\n", "method", "single ns/val", "batch ns/val", "speedup");
+
+	for (m = FPE_FF1; m <= FPE_FF3_1; m++)
+	{
+		tweakLength = m == FPE_FF3_1 ? 7 : 8;
+		if (FPE_init(&context, (FpeMethod)m, cipher->id, key, cipher->keyLengths[0], radix) != CIPHER_OK
+			|| FPE_encrypt_many(&context, tweaks, tweakLength, values, batch, length, count) != CIPHER_OK)
+		{
+			printf("%-6s unsupported cipher, radix or length\n", methodNames[m]);
+			continue;
+		}
+
+		for (t = 0; t < BENCH_TRIALS; t++)
+		{
+			start = BENCH_now();
+			for (i = 0; i < count; i++)
+			{
+				FPE_encrypt(&context, tweaks + i * tweakLength, tweakLength, values + i * length, single + i * length, length);
+			}
+			elapsed = (double)(BENCH_now() - start) / count;
+			singleTime = t == 0 || elapsed < singleTime ? elapsed : singleTime;
+
+			start = BENCH_now();
+			FPE_encrypt_many(&context, tweaks, tweakLength, values, batch, length, count);
+			elapsed = (double)(BENCH_now() - start) / count;
+			batchTime = t == 0 || elapsed < batchTime ? elapsed : batchTime;
+		}
+
+		printf("%-6s %14.1f %14.1f %7.2fx\n", methodNames[m], singleTime, batchTime, singleTime / batchTime);
+
+		if (memcmp(single, batch, count * length * sizeof(uint16_t)) != 0)
+		{
+			printf("FAIL: %s batch tokens differ from the single calls\n", methodNames[m]);
+			failures++;
+		}
+		for (i = 0; i < count * length; i++)
+		{
+			if (batch[i] >= radix)
+			{
+				printf("FAIL: %s token numeral out of the radix\n", methodNames[m]);
+				failures++;
+				break;
+			}
+		}
+		FPE_decrypt_many(&context, tweaks, tweakLength, batch, batch, length, count);
+		if (memcmp(values, batch, count * length * sizeof(uint16_t)) != 0)
+		{
+			printf("FAIL: %s batch decryption differs from the values\n", methodNames[m]);
+			failures++;
+		}
+	}
+
+	free(values);
+	free(single);
+	free(batch);
+	free(tweaks);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
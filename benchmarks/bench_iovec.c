@@ -0,0 +1,169 @@
+/* bench_iovec.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Encryption of a chain of segments of random lengths (-g bytes on
+ * average, 1500 by default, so most blocks do not line up with them)
+ * holding -s bytes, in each mode:
+ *		- linearized: the chain copied into a contiguous buffer, the
+ *		  MODES function, and the result copied back into the chain
+ *		- iovec: IOVEC_encrypt in place on the chain
+ *
+ * Both must give the same ciphertext, and IOVEC_decrypt must give the
+ * plaintext back; throughput is the median of the trials.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/IOVEC/IOVEC.h"
+
+static void linearized(CipherContext* context, ModeId mode, uint8_t* iv, const IoVector* chain, size_t count,
+					   uint8_t* buffer, size_t length)
+{
+	size_t offset = 0;
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		memcpy(buffer + offset, chain[i].data, chain[i].length);
+		offset += chain[i].length;
+	}
+
+	if (mode == MODE_ECB)
+	{
+		MODES_ecb_encrypt(context, buffer, buffer, length);
+	}
+	else if (mode == MODE_CBC)
+	{
+		MODES_cbc_encrypt(context, iv, buffer, buffer, length);
+	}
+	else
+	{
+		MODES_ctr_crypt(context, iv, buffer, buffer, length);
+	}
+
+	offset = 0;
+	for (i = 0; i < count; i++)
+	{
+		memcpy(chain[i].data, buffer + offset, chain[i].length);
+		offset += chain[i].length;
+	}
+}
+
+static double throughput(uint64_t nanoseconds, size_t length)
+{
+	return (double)length / nanoseconds * 1000;
+}
+
+int BENCH_iovec(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	size_t length = (size_t)BENCH_long_option(argc, argv, "-s", 1 << 20);
+	size_t segment = (size_t)BENCH_long_option(argc, argv, "-g", 1500);
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	uint8_t iv[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t iv2[CIPHER_MAX_BLOCK_SIZE];
+	CipherContext context;
+	double copied[BENCH_TRIALS];
+	double direct[BENCH_TRIALS];
+	IoVector* chain;
+	uint8_t* plaintext;
+	uint8_t* data;
+	uint8_t* expected;
+	uint8_t* buffer;
+	uint8_t* random;
+	size_t count = 0;
+	size_t offset;
+	uint64_t start;
+	int failures = 0;
+	int m;
+	int t;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_ARIA);
+	}
+	if (segment < 1)
+	{
+		segment = 1;
+	}
+
+	BENCH_random_bytes(key, sizeof(key));
+	CIPHER_init(&context, cipher->id, key, cipher->keyLengths[0]);
+	length = length / cipher->blockSize * cipher->blockSize;
+
+	plaintext = malloc(length);
+	data = malloc(length);
+	expected = malloc(length);
+	buffer = malloc(length);
+	chain = malloc(length * sizeof(IoVector));
+	random = malloc(length * sizeof(uint32_t));
+	BENCH_random_bytes(plaintext, length);
+	BENCH_random_bytes(random, length * sizeof(uint32_t));
+
+	// segments of 1 to 2 * segment - 1 bytes over data
+	for (offset = 0; offset < length; offset += chain[count++].length)
+	{
+		uint32_t r;
+
+		memcpy(&r, random + count * sizeof(uint32_t), sizeof(r));
+		chain[count].data = data + offset;
+		chain[count].length = 1 + r % (2 * segment - 1);
+		if (chain[count].length > length - offset)
+		{
+			chain[count].length = length - offset;
+		}
+	}
+
+	printf("%s, %zu bytes in %zu segments\n", cipher->name, length, count);
+	printf("%-4s %12s %12s\n", "mode", "linearized", "iovec");
+
+	for (m = 0; m < MODE_COUNT; m++)
+	{
+		for (t = 0; t < BENCH_TRIALS; t++)
+		{
+			memcpy(data, plaintext, length);
+			memset(iv, 0, sizeof(iv));
+			start = BENCH_now();
+			linearized(&context, (ModeId)m, iv, chain, count, buffer, length);
+			copied[t] = throughput(BENCH_now() - start, length);
+			memcpy(expected, data, length);
+
+			memcpy(data, plaintext, length);
+			memset(iv2, 0, sizeof(iv2));
+			start = BENCH_now();
+			IOVEC_encrypt(&context, (ModeId)m, iv2, chain, count, chain, count);
+			direct[t] = throughput(BENCH_now() - start, length);
+		}
+
+		printf("%-4s %12.1f %12.1f MB/s\n", MODES_name((ModeId)m), BENCH_median(copied, BENCH_TRIALS),
+			BENCH_median(direct, BENCH_TRIALS));
+
+		if (memcmp(data, expected, length) != 0 || memcmp(iv, iv2, cipher->blockSize) != 0)
+		{
+			printf("FAIL: iovec %s ciphertext differs from the linearized one\n", MODES_name((ModeId)m));
+			failures++;
+		}
+
+		memset(iv2, 0, sizeof(iv2));
+		IOVEC_decrypt(&context, (ModeId)m, iv2, chain, count, chain, count);
+		if (memcmp(data, plaintext, length) != 0)
+		{
+			printf("FAIL: iovec %s decryption differs from the plaintext\n", MODES_name((ModeId)m));
+			failures++;
+		}
+	}
+
+	free(plaintext);
+	free(data);
+	free(expected);
+	free(buffer);
+	free(chain);
+	free(random);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
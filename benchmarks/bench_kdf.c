@@ -0,0 +1,173 @@
+/* bench_kdf.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Derivation of -n keys (10000) of -k bits (the first key length of the
+ * cipher) from one master key, with per-key labels and contexts, over a
+ * cipher (-c, ARIA by default), each key expanded into a context of the
+ * same cipher:
+ *		- one by one: KDF_derive then CIPHER_init per key
+ *		- batch: KDF_derive_many with contexts
+ *
+ * Both must give the same keys as a reference written out from SP 800-108
+ * (the PRF input laid out in memory, one CMAC_compute per block), and the
+ * contexts the same ciphertexts.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/KDF/KDF.h"
+#include "../algorithms/CMAC/CMAC.h"
+
+// K(i) = CMAC(master, [i]_32 || Label || 0x00 || Context || [L]_32), i from 1, truncated to L bits
+static void referenceKey(const CmacContext* cmac, const KdfRequest* request, uint16_t keyLen, uint8_t* key)
+{
+	size_t blockSize = cmac->cipher->cipher->blockSize;
+	// label and context fit in the 32 bytes of a request
+	uint8_t input[4 + 32 + 1 + 4];
+	uint8_t mac[CIPHER_MAX_BLOCK_SIZE];
+	size_t length = 4;
+	size_t done;
+	uint32_t i;
+
+	memcpy(input + length, request->label, request->labelLength);
+	length += request->labelLength;
+	input[length++] = 0x00;
+	memcpy(input + length, request->context, request->contextLength);
+	length += request->contextLength;
+	input[length++] = (uint8_t)((uint32_t)keyLen >> 24);
+	input[length++] = (uint8_t)((uint32_t)keyLen >> 16);
+	input[length++] = (uint8_t)(keyLen >> 8);
+	input[length++] = (uint8_t)keyLen;
+
+	for (i = 1, done = 0; done < keyLen / 8u; i++, done += blockSize)
+	{
+		input[0] = (uint8_t)(i >> 24);
+		input[1] = (uint8_t)(i >> 16);
+		input[2] = (uint8_t)(i >> 8);
+		input[3] = (uint8_t)i;
+		CMAC_compute(cmac, input, length, mac);
+		memcpy(key + done, mac, keyLen / 8u - done < blockSize ? keyLen / 8u - done : blockSize);
+	}
+}
+
+int BENCH_kdf(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	size_t count = (size_t)BENCH_long_option(argc, argv, "-n", 10000);
+	uint16_t keyLen;
+	uint8_t masterKey[CIPHER_MAX_KEY_SIZE];
+	uint8_t block[CIPHER_MAX_BLOCK_SIZE] = { 0 };
+	uint8_t expectedBlock[CIPHER_MAX_BLOCK_SIZE] = { 0 };
+	CipherContext master;
+	CmacContext cmac;
+	CipherContext* single;
+	CipherContext* batch;
+	KdfRequest* requests;
+	uint8_t* labels;
+	uint8_t* keys;
+	uint8_t* expected;
+	uint8_t* reference;
+	double singleTime = 0;
+	double batchTime = 0;
+	double elapsed;
+	uint64_t start;
+	int failures = 0;
+	size_t i;
+	int t;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_ARIA);
+	}
+	keyLen = (uint16_t)BENCH_long_option(argc, argv, "-k", cipher->keyLengths[0]);
+
+	BENCH_random_bytes(masterKey, sizeof(masterKey));
+	CIPHER_init(&master, cipher->id, masterKey, cipher->keyLengths[0]);
+
+	single = malloc(count * sizeof(CipherContext));
+	batch = malloc(count * sizeof(CipherContext));
+	requests = malloc(count * sizeof(KdfRequest));
+	labels = malloc(count * 32);
+	keys = malloc(count * (keyLen / 8));
+	expected = malloc(count * (keyLen / 8));
+	reference = malloc(count * (keyLen / 8));
+	BENCH_random_bytes(labels, count * 32);
+
+	// "file" label of 4 bytes, context of 12 to 28 bytes (a record ID and an owner)
+	for (i = 0; i < count; i++)
+	{
+		requests[i].label = labels + i * 32;
+		requests[i].labelLength = 4;
+		requests[i].context = labels + i * 32 + 4;
+		requests[i].contextLength = 12 + i % 17;
+		requests[i].key = keys + i * (keyLen / 8);
+	}
+
+	for (t = 0; t < BENCH_TRIALS; t++)
+	{
+		start = BENCH_now();
+		for (i = 0; i < count; i++)
+		{
+			KDF_derive(&master, requests[i].label, requests[i].labelLength, requests[i].context, requests[i].contextLength,
+				expected + i * (keyLen / 8), keyLen);
+			CIPHER_init(&single[i], cipher->id, expected + i * (keyLen / 8), keyLen);
+		}
+		elapsed = (double)(BENCH_now() - start) / count;
+		singleTime = t == 0 || elapsed < singleTime ? elapsed : singleTime;
+
+		start = BENCH_now();
+		if (KDF_derive_many(&master, requests, count, keyLen, batch, cipher->id) != CIPHER_OK)
+		{
+			printf("%s does not take %u bits keys\n", cipher->name, keyLen);
+			return 1;
+		}
+		elapsed = (double)(BENCH_now() - start) / count;
+		batchTime = t == 0 || elapsed < batchTime ? elapsed : batchTime;
+	}
+
+	printf("%s, %zu keys of %u bits\n", cipher->name, count, keyLen);
+	printf("%-10s %10.1f ns/key\n", "one by one", singleTime);
+	printf("%-10s %10.1f ns/key\n", "batch", batchTime);
+	printf("%-10s %10.2fx\n", "speedup", singleTime / batchTime);
+
+	CMAC_init(&cmac, &master);
+	for (i = 0; i < count; i++)
+	{
+		referenceKey(&cmac, &requests[i], keyLen, reference + i * (keyLen / 8));
+	}
+	if (memcmp(expected, reference, count * (keyLen / 8)) != 0)
+	{
+		printf("FAIL: KDF_derive keys differ from the SP 800-108 reference\n");
+		failures++;
+	}
+	if (memcmp(keys, reference, count * (keyLen / 8)) != 0)
+	{
+		printf("FAIL: batch keys differ from the SP 800-108 reference\n");
+		failures++;
+	}
+	for (i = 0; i < count; i++)
+	{
+		CIPHER_encrypt(&single[i], expectedBlock, expectedBlock);
+		CIPHER_encrypt(&batch[i], block, block);
+	}
+	if (memcmp(block, expectedBlock, sizeof(block)) != 0)
+	{
+		printf("FAIL: expanded contexts differ from CIPHER_init\n");
+		failures++;
+	}
+
+	free(single);
+	free(batch);
+	free(requests);
+	free(labels);
+	free(keys);
+	free(expected);
+	free(reference);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+/* bench_keysetup.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Key agility benchmark. For every cipher and key length it measures:
+ *		- full key schedule latency (*_init)
+ *		- encryption-only key schedule latency
+ *		- key schedule cost per key of CIPHER_init_many on NR_KEYS keys
+ *		- single block encryption latency
+ *		- end-to-end cost of "new key + N blocks" for N = 1..1024
+ *
+ * and reports the share of key setup in the end-to-end cost, together
+ * with the crossover N from which key setup stops dominating (< 50%).
+ *
+ */
+
+#include <string.h>
+
+#include "bench.h"
+
+#define NR_KEYS 64
+#define MAX_BLOCKS 1024
+
+// key setup is cycled over a pool of keys so the schedule is never cached
+static uint8_t keys[NR_KEYS][CIPHER_MAX_KEY_SIZE];
+static uint8_t blocks[MAX_BLOCKS * CIPHER_MAX_BLOCK_SIZE];
+static CipherContext contexts[NR_KEYS];
+
+static double initLatency(const CipherDescriptor* cipher, uint16_t keyLen, int encryptOnly, long iterations)
+{
+	CipherContext context;
+	double trials[BENCH_TRIALS];
+	uint64_t start;
+	long i;
+	int t;
+
+	for (t = 0; t < BENCH_TRIALS; t++)
+	{
+		start = BENCH_now();
+		for (i = 0; i < iterations; i++)
+		{
+			if (encryptOnly)
+			{
+				CIPHER_init_encrypt(&context, cipher->id, keys[i % NR_KEYS], keyLen);
+			}
+			else
+			{
+				CIPHER_init(&context, cipher->id, keys[i % NR_KEYS], keyLen);
+			}
+		}
+		trials[t] = (double)(BENCH_now() - start) / iterations;
+	}
+
+	return BENCH_median(trials, BENCH_TRIALS);
+}
+
+static double initManyLatency(const CipherDescriptor* cipher, uint16_t keyLen, long iterations)
+{
+	double trials[BENCH_TRIALS];
+	uint8_t packed[NR_KEYS * CIPHER_MAX_KEY_SIZE];
+	long repetitions = iterations / NR_KEYS + 1;
+	uint64_t start;
+	long i;
+	int t;
+
+	for (i = 0; i < NR_KEYS; i++)
+	{
+		memcpy(packed + i * (keyLen / 8), keys[i], keyLen / 8);
+	}
+
+	for (t = 0; t < BENCH_TRIALS; t++)
+	{
+		start = BENCH_now();
+		for (i = 0; i < repetitions; i++)
+		{
+			CIPHER_init_many(contexts, cipher->id, packed, keyLen, NR_KEYS);
+		}
+		trials[t] = (double)(BENCH_now() - start) / (repetitions * NR_KEYS);
+	}
+
+	return BENCH_median(trials, BENCH_TRIALS);
+}
+
+static double blockLatency(const CipherDescriptor* cipher, uint16_t keyLen, long iterations)
+{
+	CipherContext context;
+	double trials[BENCH_TRIALS];
+	uint8_t block[CIPHER_MAX_BLOCK_SIZE] = { 0 };
+	uint64_t start;
+	long i;
+	int t;
+
+	CIPHER_init(&context, cipher->id, keys[0], keyLen);
+
+	for (t = 0; t < BENCH_TRIALS; t++)
+	{
+		start = BENCH_now();
+		for (i = 0; i < iterations; i++)
+		{
+			// chained so successive blocks cannot overlap
+			CIPHER_encrypt(&context, block, block);
+		}
+		trials[t] = (double)(BENCH_now() - start) / iterations;
+	}
+
+	return BENCH_median(trials, BENCH_TRIALS);
+}
+
+static double newKeyLatency(const CipherDescriptor* cipher, uint16_t keyLen, int nrBlocks, long iterations)
+{
+	CipherContext context;
+	double trials[BENCH_TRIALS];
+	uint64_t start;
+	long repetitions = iterations / nrBlocks;
+	long i;
+	int b;
+	int t;
+
+	if (repetitions < 16)
+	{
+		repetitions = 16;
+	}
+
+	for (t = 0; t < BENCH_TRIALS; t++)
+	{
+		start = BENCH_now();
+		for (i = 0; i < repetitions; i++)
+		{
+			CIPHER_init_encrypt(&context, cipher->id, keys[i % NR_KEYS], keyLen);
+			for (b = 0; b < nrBlocks; b++)
+			{
+				uint8_t* block = blocks + b * cipher->blockSize;
+				CIPHER_encrypt(&context, block, block);
+			}
+		}
+		trials[t] = (double)(BENCH_now() - start) / repetitions;
+	}
+
+	return BENCH_median(trials, BENCH_TRIALS);
+}
+
+int BENCH_keysetup(int argc, char** argv)
+{
+	const CipherDescriptor* filter = BENCH_cipher_option(argc, argv);
+	long iterations = BENCH_long_option(argc, argv, "-n", 20000);
+	double share[11];
+	int i;
+	int k;
+	int n;
+
+	BENCH_random_bytes(&keys[0][0], sizeof(keys));
+	BENCH_random_bytes(blocks, sizeof(blocks));
+
+	printf("%-9s %4s %11s %11s %11s %11s %9s %9s |", "cipher", "key", "init ns", "enc-init ns", "many ns/key", "block ns", "model N*", "meas. N*");
+	for (n = 1; n <= MAX_BLOCKS; n *= 2)
+	{
+		printf(" %5d", n);
+	}
+	printf("   (init share %% of new key + N blocks)\n");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		for (k = 0; k < cipher->nrKeyLengths; k++)
+		{
+			uint16_t keyLen = cipher->keyLengths[k];
+			double init = initLatency(cipher, keyLen, 0, iterations);
+			double initEncrypt = initLatency(cipher, keyLen, 1, iterations);
+			double initMany = initManyLatency(cipher, keyLen, iterations);
+			double block = blockLatency(cipher, keyLen, iterations);
+			int measured = 0;
+			int column = 0;
+
+			for (n = 1; n <= MAX_BLOCKS; n *= 2)
+			{
+				double total = newKeyLatency(cipher, keyLen, n, iterations);
+
+				share[column] = total > initEncrypt ? 100 * initEncrypt / total : 100;
+				if (measured == 0 && share[column] < 50)
+				{
+					measured = n;
+				}
+				column++;
+			}
+
+			printf("%-9s %4u %11.1f %11.1f %11.1f %11.1f %9.0f ", cipher->name, keyLen, init, initEncrypt, initMany, block, initEncrypt / block + 0.5);
+			if (measured != 0)
+			{
+				printf("%9d |", measured);
+			}
+			else
+			{
+				printf("%9s |", ">1024");
+			}
+			for (n = 0; n < column; n++)
+			{
+				printf(" %5.1f", share[n]);
+			}
+			printf("\n");
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
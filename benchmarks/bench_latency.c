@@ -0,0 +1,269 @@
+/* bench_latency.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Tail latency benchmark. Every operation is timed individually and
+ * the samples go to a log-bucketed histogram (HDR style, 32 linear
+ * sub-buckets per power of two, so about 3% of resolution), from which
+ * p50/p90/p99/p99.9 and max are reported. Operations:
+ *		- block:     a single block encryption
+ *		- ctr-64:    CTR over a 64 bytes packet
+ *		- ctr-1500:  CTR over a 1500 bytes packet
+ *		- seal/open: GCM over 64 and 1500 bytes packets, 16 bytes of
+ *		             AAD, 128 bits block ciphers only
+ *
+ * Each operation is measured with a fixed key and again paying the
+ * key setup (encryption key schedule, plus the GHASH table for GCM)
+ * on every operation, as a request-per-key service would.
+ *
+ */
+
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/MODES/MODES.h"
+#include "../algorithms/GCM/GCM.h"
+
+#define SUB_BITS 5
+#define SUB_COUNT (1 << SUB_BITS)
+#define NR_BUCKETS (2 * SUB_COUNT + 40 * SUB_COUNT)
+#define MAX_PACKET 1500
+#define AAD_SIZE 16
+
+typedef enum
+{
+	OP_BLOCK,
+	OP_CTR,
+	OP_SEAL,
+	OP_OPEN
+} OperationKind;
+
+typedef struct
+{
+	const char* name;
+	OperationKind kind;
+	size_t length;
+} Operation;
+
+typedef struct
+{
+	uint64_t counts[NR_BUCKETS];
+	uint64_t total;
+	uint64_t max;
+} Histogram;
+
+static const Operation operations[] =
+{
+	{ "block", OP_BLOCK, 0 },
+	{ "ctr-64", OP_CTR, 64 },
+	{ "ctr-1500", OP_CTR, 1500 },
+	{ "seal-64", OP_SEAL, 64 },
+	{ "open-64", OP_OPEN, 64 },
+	{ "seal-1500", OP_SEAL, 1500 },
+	{ "open-1500", OP_OPEN, 1500 }
+};
+
+static Histogram histogram;
+static uint64_t timerOverhead;
+static uint8_t input[MAX_PACKET];
+static uint8_t sealed[MAX_PACKET];
+static uint8_t output[MAX_PACKET];
+static uint8_t aad[AAD_SIZE];
+
+// values below 2 * SUB_COUNT are exact, above keep the SUB_BITS + 1 top bits
+static int bucketIndex(uint64_t value)
+{
+	int shift;
+
+	if (value < 2 * SUB_COUNT)
+	{
+		return (int)value;
+	}
+
+	shift = 63 - __builtin_clzll(value) - SUB_BITS;
+	if (shift > 40)
+	{
+		return NR_BUCKETS - 1;
+	}
+
+	return 2 * SUB_COUNT + (shift - 1) * SUB_COUNT + (int)(value >> shift) - SUB_COUNT;
+}
+
+// highest value that falls into the bucket
+static uint64_t bucketValue(int index)
+{
+	int shift;
+	uint64_t top;
+
+	if (index < 2 * SUB_COUNT)
+	{
+		return index;
+	}
+
+	shift = (index - 2 * SUB_COUNT) / SUB_COUNT + 1;
+	top = (index - 2 * SUB_COUNT) % SUB_COUNT + SUB_COUNT;
+
+	return ((top + 1) << shift) - 1;
+}
+
+static void record(Histogram* h, uint64_t value)
+{
+	h->counts[bucketIndex(value)]++;
+	h->total++;
+	if (value > h->max)
+	{
+		h->max = value;
+	}
+}
+
+static uint64_t percentile(const Histogram* h, double p)
+{
+	uint64_t rank = (uint64_t)(p / 100 * h->total + 0.5);
+	uint64_t seen = 0;
+	int i;
+
+	if (rank == 0)
+	{
+		rank = 1;
+	}
+
+	for (i = 0; i < NR_BUCKETS; i++)
+	{
+		seen += h->counts[i];
+		if (seen >= rank)
+		{
+			// never above the largest value actually seen
+			return bucketValue(i) < h->max ? bucketValue(i) : h->max;
+		}
+	}
+
+	return h->max;
+}
+
+static void measureTimerOverhead(void)
+{
+	static double samples[1001];
+	uint64_t start;
+	int i;
+
+	for (i = 0; i < 1001; i++)
+	{
+		start = BENCH_now();
+		samples[i] = BENCH_now() - start;
+	}
+	timerOverhead = (uint64_t)BENCH_median(samples, 1001);
+}
+
+static void setup(CipherContext* context, GcmContext* gcm, const CipherDescriptor* cipher, const uint8_t* key, int aead)
+{
+	CIPHER_init_encrypt(context, cipher->id, key, cipher->keyLengths[0]);
+	if (aead)
+	{
+		GCM_init(gcm, context);
+	}
+}
+
+static void run(const CipherDescriptor* cipher, const Operation* operation, const uint8_t* key, int rekey, long nrSamples)
+{
+	int aead = operation->kind == OP_SEAL || operation->kind == OP_OPEN;
+	uint8_t counter[CIPHER_MAX_BLOCK_SIZE];
+	uint8_t nonce[12] = { 0 };
+	uint8_t tag[GCM_TAG_SIZE];
+	CipherContext context;
+	GcmContext gcm;
+	uint64_t start;
+	uint64_t elapsed;
+	long i;
+
+	setup(&context, &gcm, cipher, key, aead);
+	if (operation->kind == OP_OPEN)
+	{
+		GCM_seal(&gcm, nonce, sizeof(nonce), aad, AAD_SIZE, input, sealed, operation->length, tag, GCM_TAG_SIZE);
+	}
+
+	memset(&histogram, 0, sizeof(histogram));
+
+	// the first samples warm up caches and branch predictors
+	for (i = -nrSamples / 10; i < nrSamples; i++)
+	{
+		start = BENCH_now();
+
+		if (rekey)
+		{
+			setup(&context, &gcm, cipher, key, aead);
+		}
+
+		switch (operation->kind)
+		{
+		case OP_BLOCK:
+			CIPHER_encrypt(&context, input, output);
+			break;
+		case OP_CTR:
+			memset(counter, 0, cipher->blockSize);
+			MODES_ctr_crypt(&context, counter, input, output, operation->length);
+			break;
+		case OP_SEAL:
+			GCM_seal(&gcm, nonce, sizeof(nonce), aad, AAD_SIZE, input, output, operation->length, tag, GCM_TAG_SIZE);
+			break;
+		case OP_OPEN:
+			GCM_open(&gcm, nonce, sizeof(nonce), aad, AAD_SIZE, sealed, output, operation->length, tag, GCM_TAG_SIZE);
+			break;
+		}
+
+		elapsed = BENCH_now() - start;
+		if (i >= 0)
+		{
+			record(&histogram, elapsed > timerOverhead ? elapsed - timerOverhead : 0);
+		}
+	}
+
+	printf("%-9s %-9s %-6s %9llu %9llu %9llu %9llu %9llu\n", cipher->name, operation->name, rekey ? "per-op" : "fixed",
+		(unsigned long long)percentile(&histogram, 50), (unsigned long long)percentile(&histogram, 90),
+		(unsigned long long)percentile(&histogram, 99), (unsigned long long)percentile(&histogram, 99.9),
+		(unsigned long long)histogram.max);
+}
+
+int BENCH_latency(int argc, char** argv)
+{
+	const CipherDescriptor* filter = BENCH_cipher_option(argc, argv);
+	long nrSamples = BENCH_long_option(argc, argv, "-n", 20000);
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	size_t o;
+	int rekey;
+	int i;
+
+	measureTimerOverhead();
+
+	BENCH_random_bytes(key, sizeof(key));
+	BENCH_random_bytes(input, sizeof(input));
+	BENCH_random_bytes(aad, sizeof(aad));
+
+	printf("%ld samples per row, latencies in ns\n", nrSamples);
+	printf("%-9s %-9s %-6s %9s %9s %9s %9s %9s\n", "cipher", "operation", "key", "p50", "p90", "p99", "p99.9", "max");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		for (o = 0; o < sizeof(operations) / sizeof(operations[0]); o++)
+		{
+			if ((operations[o].kind == OP_SEAL || operations[o].kind == OP_OPEN) && cipher->blockSize != GCM_BLOCK_SIZE)
+			{
+				continue;
+			}
+
+			for (rekey = 0; rekey <= 1; rekey++)
+			{
+				run(cipher, &operations[o], key, rekey, nrSamples);
+			}
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
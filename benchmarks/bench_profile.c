@@ -0,0 +1,94 @@
+/* bench_profile.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Per-function cycle attribution, for the profiling build only
+ * (make clean && make PROFILE=1). For every cipher with profiled
+ * internal steps it encrypts -s bytes in ECB -n times and reports the
+ * calls, net cycles, cycles per call and share of the workload of:
+ *		- ARIA:     A() diffusion layer
+ *		- CAMELLIA: F() against FL()/FLINV()
+ *		- GOST:     GOST_round() (S-box extraction, rotation)
+ *		- IDEA:     mul() modulo 2^16 + 1
+ *		- PRESENT:  bit permutation loop
+ *		- SEED:     G() S-box layer
+ *
+ * The rest of the cost (key addition, S-box layers that are not
+ * wrapped, loads and stores) is reported as "other". Cycles are TSC
+ * reference cycles.
+ *
+ */
+
+#include <stdlib.h>
+
+#include "bench.h"
+#include "../algorithms/PROFILE/PROFILE.h"
+
+int BENCH_profile(int argc, char** argv)
+{
+	const CipherDescriptor* filter = BENCH_cipher_option(argc, argv);
+	size_t length = (size_t)BENCH_long_option(argc, argv, "-s", 4096);
+	long iterations = BENCH_long_option(argc, argv, "-n", 100);
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	CipherContext context;
+	uint8_t* data;
+	uint64_t start;
+	uint64_t total;
+	long r;
+	int i;
+	int s;
+
+	if (!PROFILE_enabled())
+	{
+		printf("not a profiling build, rebuild with: make clean && make PROFILE=1\n");
+		return 1;
+	}
+
+	BENCH_random_bytes(key, sizeof(key));
+	data = malloc(length + CIPHER_MAX_BLOCK_SIZE);
+	BENCH_random_bytes(data, length + CIPHER_MAX_BLOCK_SIZE);
+
+	printf("ecb over %zu bytes x %ld, timer overhead %llu cycles per call (subtracted)\n", length, iterations,
+		(unsigned long long)PROFILE_overhead());
+	printf("%-9s %-17s %12s %12s %10s %8s\n", "cipher", "function", "calls", "cycles", "cyc/call", "share");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+		size_t nrBlocks = (length + cipher->blockSize - 1) / cipher->blockSize;
+		int profiled = 0;
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		for (s = 0; s < PROFILE_COUNT; s++)
+		{
+			profiled |= PROFILE_cipher(s) == cipher->id;
+		}
+		if (!profiled)
+		{
+			continue;
+		}
+
+		CIPHER_init(&context, cipher->id, key, cipher->keyLengths[0]);
+		CIPHER_encrypt_blocks(&context, data, data, nrBlocks);
+
+		// reset after the key schedule, so only the workload is attributed
+		PROFILE_reset();
+		start = PROFILE_timestamp();
+		for (r = 0; r < iterations; r++)
+		{
+			CIPHER_encrypt_blocks(&context, data, data, nrBlocks);
+		}
+		total = PROFILE_timestamp() - start;
+
+		PROFILE_report(stdout, cipher->id, total);
+	}
+
+	free(data);
+
+	return 0;
+}
\ No newline at end of file
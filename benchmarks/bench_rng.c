@@ -0,0 +1,181 @@
+/* bench_rng.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Counter-based generator over SPECK or SIMON (-c, SPECK by default,
+ * -r reduced rounds), -n values per fill (1 << 22):
+ *		- next: one RNG_next call per 64 bits value
+ *		- fill: RNG_fill_u64/u32/double/float
+ *
+ * Checks that the fills give the RNG_next sequence, that RNG_generate
+ * and RNG_seek give the same words at random positions, that substreams
+ * differ and that floating point values are in [0, 1).
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/RNG/RNG.h"
+
+static double throughput(uint64_t nanoseconds, size_t length)
+{
+	return (double)length / nanoseconds * 1000;
+}
+
+static int check(RngContext* context, uint64_t* words, size_t count)
+{
+	uint64_t slice[1000];
+	uint64_t other[64];
+	double doubles[1000];
+	float floats[1000];
+	uint64_t position;
+	size_t length;
+	int failures = 0;
+	size_t i;
+	int t;
+
+	RNG_seek(context, 0);
+	RNG_fill_u64(context, words, count);
+	RNG_seek(context, 0);
+	for (i = 0; i < 1000 && i < count; i++)
+	{
+		if (RNG_next(context) != words[i])
+		{
+			printf("FAIL: RNG_fill_u64 differs from RNG_next at word %zu\n", i);
+			failures++;
+			break;
+		}
+	}
+
+	for (t = 0; t < 100; t++)
+	{
+		BENCH_random_bytes((uint8_t*)&position, sizeof(position));
+		position %= count - 1000;
+		length = (size_t)(position % 1000);
+
+		RNG_generate(context, context->stream, position, slice, length);
+		if (memcmp(slice, words + position, length * sizeof(uint64_t)) != 0)
+		{
+			printf("FAIL: RNG_generate differs from the sequence at word %llu\n", (unsigned long long)position);
+			failures++;
+			break;
+		}
+
+		RNG_seek(context, position);
+		RNG_fill_u64(context, slice, length);
+		if (memcmp(slice, words + position, length * sizeof(uint64_t)) != 0)
+		{
+			printf("FAIL: RNG_seek differs from the sequence at word %llu\n", (unsigned long long)position);
+			failures++;
+			break;
+		}
+	}
+
+	RNG_generate(context, context->stream + 1, 0, other, 64);
+	if (memcmp(other, words, sizeof(other)) == 0)
+	{
+		printf("FAIL: substreams are equal\n");
+		failures++;
+	}
+
+	RNG_fill_double(context, doubles, 1000);
+	RNG_fill_float(context, floats, 1000);
+	for (i = 0; i < 1000; i++)
+	{
+		if (doubles[i] < 0 || doubles[i] >= 1 || floats[i] < 0 || floats[i] >= 1)
+		{
+			printf("FAIL: floating point value out of [0, 1)\n");
+			failures++;
+			break;
+		}
+	}
+
+	return failures;
+}
+
+int BENCH_rng(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	size_t count = (size_t)BENCH_long_option(argc, argv, "-n", 1 << 22);
+	uint8_t rounds = (uint8_t)BENCH_long_option(argc, argv, "-r", 0);
+	static const char* names[] = { "next u64", "fill u64", "fill u32", "fill double", "fill float" };
+	double speeds[5] = { 0 };
+	double speed;
+	RngContext context;
+	uint64_t seed;
+	uint64_t* words;
+	void* data;
+	uint64_t start;
+	size_t i;
+	int failures;
+	int k;
+	int t;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_SPECK);
+	}
+	if (count < 2000)
+	{
+		count = 2000;
+	}
+
+	BENCH_random_bytes((uint8_t*)&seed, sizeof(seed));
+	if (RNG_init(&context, cipher->id, seed, 0, rounds) != CIPHER_OK)
+	{
+		printf("%s with %u rounds is not supported\n", cipher->name, rounds);
+		return 1;
+	}
+
+	words = malloc(count * sizeof(uint64_t));
+	data = malloc(count * sizeof(uint64_t));
+
+	for (t = 0; t < BENCH_TRIALS; t++)
+	{
+		for (k = 0; k < 5; k++)
+		{
+			RNG_seek(&context, 0);
+			start = BENCH_now();
+			switch (k)
+			{
+			case 0:
+				for (i = 0; i < count; i++)
+				{
+					((uint64_t*)data)[i] = RNG_next(&context);
+				}
+				break;
+			case 1:
+				RNG_fill_u64(&context, data, count);
+				break;
+			case 2:
+				RNG_fill_u32(&context, data, 2 * count);
+				break;
+			case 3:
+				RNG_fill_double(&context, data, count);
+				break;
+			default:
+				RNG_fill_float(&context, data, 2 * count);
+				break;
+			}
+			speed = throughput(BENCH_now() - start, count * sizeof(uint64_t));
+			speeds[k] = speed > speeds[k] ? speed : speeds[k];
+		}
+	}
+
+	printf("%s, %u rounds, %zu bytes per fill\n", cipher->name,
+		cipher->id == CIPHER_SPECK ? context.cipher.speck.nrSubkeys : context.cipher.simon.nrSubkeys, count * sizeof(uint64_t));
+	for (k = 0; k < 5; k++)
+	{
+		printf("%-12s %10.1f MB/s\n", names[k], speeds[k]);
+	}
+
+	failures = check(&context, words, count);
+
+	free(words);
+	free(data);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
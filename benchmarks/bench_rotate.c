@@ -0,0 +1,264 @@
+/* bench_rotate.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Hot key rotation under load: -t threads (4) each run -n operations
+ * (200000) of -b blocks (4) over a shared key (-c, ARIA by default),
+ * while another thread rotates it through 4 keys every -r microseconds
+ * (100):
+ *		- fixed: a shared context without rotation, the floor
+ *		- mutex: a lock around every operation and every rotation
+ *		- handle: KEYHANDLE, one atomic load per operation and a read
+ *		  section per -k operations (64)
+ *
+ * Every output must be the encryption under one of the keys (a torn or
+ * wiped context would give neither), and every retired version of the
+ * handle must be reclaimed at the end.
+ *
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+#include "../algorithms/KEYHANDLE/KEYHANDLE.h"
+
+#define NR_KEYS 4
+#define MAX_BLOCKS 64
+
+typedef enum
+{
+	PATH_FIXED = 0,
+	PATH_MUTEX,
+	PATH_HANDLE,
+	PATH_COUNT
+} Path;
+
+typedef struct
+{
+	Path path;
+	const CipherDescriptor* cipher;
+	uint8_t keys[NR_KEYS][CIPHER_MAX_KEY_SIZE];
+	uint8_t plaintext[MAX_BLOCKS * CIPHER_MAX_BLOCK_SIZE];
+	uint8_t expected[NR_KEYS][MAX_BLOCKS * CIPHER_MAX_BLOCK_SIZE];
+	size_t length;
+	size_t nrBlocks;
+	long operations;
+	long section;
+	long period;
+	CipherContext fixed;
+	pthread_mutex_t lock;
+	CipherContext locked;
+	KeyHandle handle;
+	int stop;
+	long rotations;
+} Shared;
+
+typedef struct
+{
+	pthread_t thread;
+	Shared* shared;
+	uint64_t nanoseconds;
+	long mismatches;
+} Worker;
+
+static const char* pathNames[PATH_COUNT] = { "fixed", "mutex", "handle" };
+
+static int known(const Shared* shared, const uint8_t* out)
+{
+	int k;
+
+	for (k = 0; k < NR_KEYS; k++)
+	{
+		if (memcmp(out, shared->expected[k], shared->length) == 0)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static void* workerMain(void* argument)
+{
+	Worker* worker = argument;
+	Shared* shared = worker->shared;
+	uint8_t out[MAX_BLOCKS * CIPHER_MAX_BLOCK_SIZE];
+	uint64_t start = BENCH_now();
+	long i;
+	long j;
+
+	for (i = 0; i < shared->operations; i += shared->section)
+	{
+		if (shared->path == PATH_HANDLE)
+		{
+			KEYHANDLE_read_begin();
+		}
+
+		for (j = i; j < i + shared->section && j < shared->operations; j++)
+		{
+			switch (shared->path)
+			{
+			case PATH_FIXED:
+				CIPHER_encrypt_blocks(&shared->fixed, shared->plaintext, out, shared->nrBlocks);
+				break;
+			case PATH_MUTEX:
+				pthread_mutex_lock(&shared->lock);
+				CIPHER_encrypt_blocks(&shared->locked, shared->plaintext, out, shared->nrBlocks);
+				pthread_mutex_unlock(&shared->lock);
+				break;
+			default:
+				CIPHER_encrypt_blocks(KEYHANDLE_get(&shared->handle), shared->plaintext, out, shared->nrBlocks);
+				break;
+			}
+
+			worker->mismatches += !known(shared, out);
+		}
+
+		if (shared->path == PATH_HANDLE)
+		{
+			KEYHANDLE_read_end();
+		}
+	}
+
+	worker->nanoseconds = BENCH_now() - start;
+
+	return NULL;
+}
+
+static void* rotatorMain(void* argument)
+{
+	Shared* shared = argument;
+	struct timespec period = { shared->period / 1000000, shared->period % 1000000 * 1000 };
+	const uint8_t* key;
+
+	while (!__atomic_load_n(&shared->stop, __ATOMIC_ACQUIRE))
+	{
+		nanosleep(&period, NULL);
+
+		key = shared->keys[(shared->rotations + 1) % NR_KEYS];
+		if (shared->path == PATH_MUTEX)
+		{
+			pthread_mutex_lock(&shared->lock);
+			CIPHER_init(&shared->locked, shared->cipher->id, key, shared->cipher->keyLengths[0]);
+			pthread_mutex_unlock(&shared->lock);
+		}
+		else
+		{
+			KEYHANDLE_rotate(&shared->handle, key, shared->cipher->keyLengths[0]);
+		}
+		shared->rotations++;
+	}
+
+	return NULL;
+}
+
+int BENCH_rotate(int argc, char** argv)
+{
+	const CipherDescriptor* cipher = BENCH_cipher_option(argc, argv);
+	long nrThreads = BENCH_long_option(argc, argv, "-t", 4);
+	Shared* shared = malloc(sizeof(Shared));
+	Worker* workers;
+	pthread_t rotator;
+	CipherContext context;
+	uint64_t slowest;
+	long mismatches;
+	size_t left;
+	int failures = 0;
+	int path;
+	long t;
+	int k;
+
+	if (cipher == NULL)
+	{
+		cipher = CIPHER_get(CIPHER_ARIA);
+	}
+	nrThreads = nrThreads < 1 ? 1 : nrThreads;
+
+	memset(shared, 0, sizeof(Shared));
+	shared->cipher = cipher;
+	shared->nrBlocks = (size_t)BENCH_long_option(argc, argv, "-b", 4);
+	shared->nrBlocks = shared->nrBlocks < 1 ? 1 : shared->nrBlocks > MAX_BLOCKS ? MAX_BLOCKS : shared->nrBlocks;
+	shared->length = shared->nrBlocks * cipher->blockSize;
+	shared->operations = BENCH_long_option(argc, argv, "-n", 200000);
+	shared->section = BENCH_long_option(argc, argv, "-k", 64);
+	shared->section = shared->section < 1 ? 1 : shared->section;
+	shared->period = BENCH_long_option(argc, argv, "-r", 100);
+
+	BENCH_random_bytes((uint8_t*)shared->keys, sizeof(shared->keys));
+	BENCH_random_bytes(shared->plaintext, shared->length);
+	for (k = 0; k < NR_KEYS; k++)
+	{
+		CIPHER_init(&context, cipher->id, shared->keys[k], cipher->keyLengths[0]);
+		CIPHER_encrypt_blocks(&context, shared->plaintext, shared->expected[k], shared->nrBlocks);
+	}
+
+	workers = malloc(nrThreads * sizeof(Worker));
+
+	printf("%s, %ld threads, %ld operations of %zu blocks, rotation every %ld us\n", cipher->name, nrThreads,
+		shared->operations, shared->nrBlocks, shared->period);
+	printf("%-7s %10s %10s %10s\n", "path", "ns/op", "rotations", "bad");
+
+	for (path = 0; path < PATH_COUNT; path++)
+	{
+		shared->path = path;
+		shared->stop = 0;
+		shared->rotations = 0;
+		CIPHER_init(&shared->fixed, cipher->id, shared->keys[0], cipher->keyLengths[0]);
+		CIPHER_init(&shared->locked, cipher->id, shared->keys[0], cipher->keyLengths[0]);
+		pthread_mutex_init(&shared->lock, NULL);
+		KEYHANDLE_init(&shared->handle, cipher->id, shared->keys[0], cipher->keyLengths[0]);
+
+		for (t = 0; t < nrThreads; t++)
+		{
+			workers[t].shared = shared;
+			workers[t].mismatches = 0;
+			pthread_create(&workers[t].thread, NULL, workerMain, &workers[t]);
+		}
+		if (path != PATH_FIXED)
+		{
+			pthread_create(&rotator, NULL, rotatorMain, shared);
+		}
+
+		slowest = 0;
+		mismatches = 0;
+		for (t = 0; t < nrThreads; t++)
+		{
+			pthread_join(workers[t].thread, NULL);
+			slowest = workers[t].nanoseconds > slowest ? workers[t].nanoseconds : slowest;
+			mismatches += workers[t].mismatches;
+		}
+		__atomic_store_n(&shared->stop, 1, __ATOMIC_RELEASE);
+		if (path != PATH_FIXED)
+		{
+			pthread_join(rotator, NULL);
+		}
+
+		printf("%-7s %10.1f %10ld %10ld\n", pathNames[path], (double)slowest / shared->operations, shared->rotations, mismatches);
+
+		if (mismatches > 0)
+		{
+			printf("FAIL: %s path gave %ld outputs under none of the keys\n", pathNames[path], mismatches);
+			failures++;
+		}
+
+		// no reader is left, so nothing may stay retired
+		left = KEYHANDLE_reclaim(&shared->handle);
+		if (left > 0)
+		{
+			printf("FAIL: %zu retired versions left after the readers exited\n", left);
+			failures++;
+		}
+
+		KEYHANDLE_destroy(&shared->handle);
+		pthread_mutex_destroy(&shared->lock);
+	}
+
+	free(workers);
+	free(shared);
+
+	return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,357 @@
+/* bench_scaling.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Multi-thread scaling benchmark. Every thread runs the same workload
+ * (a mode of operation over its own buffer) and the aggregate throughput
+ * is reported for 1..N threads, together with the speedup and the
+ * parallel efficiency over the single thread run of the same setup.
+ *
+ * Setups compared:
+ *		- context:   one context shared by every thread, or a replica
+ *		             allocated (first touch) by each thread
+ *		- pinning:   threads left to the scheduler, or pinned to one CPU
+ *		- placement: CPUs of one socket first (compact), or round-robin
+ *		             over the sockets (spread), only when pinned
+ *
+ * Replicated tables are out of scope: the S-box tables are static const
+ * data that the ciphers address directly, so there is a single read-only
+ * copy per process in every setup; only the contexts are replicated.
+ *
+ * -s must be a multiple of the block size of the ciphers tested.
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/PROBES/PROBES.h"
+#include "../algorithms/MODES/MODES.h"
+
+#define MAX_THREADS 256
+#define MAX_SOCKETS 16
+
+typedef struct
+{
+	_Alignas(64) pthread_t thread;
+	int index;
+	int cpu; // -1 when not pinned
+	int replicate;
+	ModeId mode;
+	size_t length;
+	long passes;
+	CipherContext* shared;
+	pthread_barrier_t* barrier;
+	uint64_t start;
+	uint64_t end;
+} Worker;
+
+static int cpus[MAX_THREADS];
+static int sockets[MAX_THREADS];
+static int nrCpus;
+static int nrSockets;
+
+static void discoverTopology(void)
+{
+	cpu_set_t allowed;
+	char path[128];
+	FILE* file;
+	int socket;
+	int cpu;
+
+	sched_getaffinity(0, sizeof(allowed), &allowed);
+
+	nrCpus = 0;
+	nrSockets = 1;
+	for (cpu = 0; cpu < CPU_SETSIZE && nrCpus < MAX_THREADS; cpu++)
+	{
+		if (!CPU_ISSET(cpu, &allowed))
+		{
+			continue;
+		}
+
+		socket = 0;
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+		file = fopen(path, "r");
+		if (file != NULL)
+		{
+			if (fscanf(file, "%d", &socket) != 1 || socket < 0 || socket >= MAX_SOCKETS)
+			{
+				socket = 0;
+			}
+			fclose(file);
+		}
+
+		cpus[nrCpus] = cpu;
+		sockets[nrCpus] = socket;
+		nrCpus++;
+		if (socket + 1 > nrSockets)
+		{
+			nrSockets = socket + 1;
+		}
+	}
+}
+
+// CPU order used to pin threads: socket by socket, or alternating sockets
+static void placementOrder(int spread, int* order)
+{
+	int count = 0;
+	int round;
+	int socket;
+	int i;
+
+	if (!spread)
+	{
+		for (socket = 0; socket < nrSockets; socket++)
+		{
+			for (i = 0; i < nrCpus; i++)
+			{
+				if (sockets[i] == socket)
+				{
+					order[count++] = cpus[i];
+				}
+			}
+		}
+		return;
+	}
+
+	for (round = 0; count < nrCpus; round++)
+	{
+		for (socket = 0; socket < nrSockets; socket++)
+		{
+			int seen = 0;
+
+			for (i = 0; i < nrCpus; i++)
+			{
+				if (sockets[i] == socket && seen++ == round)
+				{
+					order[count++] = cpus[i];
+					break;
+				}
+			}
+		}
+	}
+}
+
+// thread counts of the sweep: powers of two, then every thread (past the end after it)
+static int nextThreads(int threads, int maxThreads)
+{
+	if (threads == maxThreads)
+	{
+		return maxThreads + 1;
+	}
+
+	return threads * 2 < maxThreads ? threads * 2 : maxThreads;
+}
+
+static void runMode(CipherContext* context, ModeId mode, uint8_t* iv, uint8_t* buffer, size_t length)
+{
+	switch (mode)
+	{
+	case MODE_ECB:
+		MODES_ecb_encrypt(context, buffer, buffer, length);
+		break;
+	case MODE_CBC:
+		MODES_cbc_encrypt(context, iv, buffer, buffer, length);
+		break;
+	default:
+		MODES_ctr_crypt(context, iv, buffer, buffer, length);
+		break;
+	}
+}
+
+static void* workerMain(void* argument)
+{
+	Worker* worker = (Worker*)argument;
+	CipherContext* context = worker->shared;
+	uint8_t iv[CIPHER_MAX_BLOCK_SIZE] = { 0 };
+	uint8_t* buffer;
+	long i;
+
+	if (worker->cpu >= 0)
+	{
+		cpu_set_t set;
+
+		CPU_ZERO(&set);
+		CPU_SET(worker->cpu, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	}
+
+	// allocated after pinning, so the pages are local to the thread's node
+	if (worker->replicate)
+	{
+		context = aligned_alloc(64, (sizeof(CipherContext) + 63) & ~(size_t)63);
+		memcpy(context, worker->shared, sizeof(CipherContext));
+	}
+	buffer = aligned_alloc(64, worker->length);
+	memset(buffer, 0x5a, worker->length);
+
+	// warm up caches and branch predictors
+	runMode(context, worker->mode, iv, buffer, worker->length);
+
+	pthread_barrier_wait(worker->barrier);
+
+	worker->start = BENCH_now();
+	for (i = 0; i < worker->passes; i++)
+	{
+		PROBE_CHUNK_ENTRY(context->cipher->id, worker->length, worker->index);
+		runMode(context, worker->mode, iv, buffer, worker->length);
+		PROBE_CHUNK_EXIT(context->cipher->id, worker->length, worker->index);
+	}
+	worker->end = BENCH_now();
+
+	free(buffer);
+	if (worker->replicate)
+	{
+		free(context);
+	}
+
+	return NULL;
+}
+
+// aggregate throughput in MB/s of nrThreads identical workers
+static double runThreads(CipherContext* shared, ModeId mode, int nrThreads, int replicate, const int* order, size_t length, long passes)
+{
+	static Worker workers[MAX_THREADS];
+	pthread_barrier_t barrier;
+	uint64_t start = UINT64_MAX;
+	uint64_t end = 0;
+	int i;
+
+	pthread_barrier_init(&barrier, NULL, nrThreads);
+
+	for (i = 0; i < nrThreads; i++)
+	{
+		workers[i].index = i;
+		workers[i].cpu = order != NULL ? order[i % nrCpus] : -1;
+		workers[i].replicate = replicate;
+		workers[i].mode = mode;
+		workers[i].length = length;
+		workers[i].passes = passes;
+		workers[i].shared = shared;
+		workers[i].barrier = &barrier;
+		pthread_create(&workers[i].thread, NULL, workerMain, &workers[i]);
+	}
+
+	for (i = 0; i < nrThreads; i++)
+	{
+		pthread_join(workers[i].thread, NULL);
+		if (workers[i].start < start)
+		{
+			start = workers[i].start;
+		}
+		if (workers[i].end > end)
+		{
+			end = workers[i].end;
+		}
+	}
+
+	pthread_barrier_destroy(&barrier);
+
+	return (double)nrThreads * length * passes / ((end - start) / 1e9) / 1e6;
+}
+
+int BENCH_scaling(int argc, char** argv)
+{
+	const CipherDescriptor* filter = BENCH_cipher_option(argc, argv);
+	const char* modeName = BENCH_string_option(argc, argv, "-m", NULL);
+	long maxThreads = BENCH_long_option(argc, argv, "-t", 0);
+	size_t length = (size_t)BENCH_long_option(argc, argv, "-s", 64 * 1024);
+	long passes = BENCH_long_option(argc, argv, "-r", 16);
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	int order[MAX_THREADS];
+	CipherContext* shared;
+	int placement;
+	int replicate;
+	int pinned;
+	int m;
+	int i;
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+
+		if ((filter == NULL || filter == cipher) && (length == 0 || length % cipher->blockSize != 0))
+		{
+			printf("-s must be a multiple of the %s block size (%d bytes)\n", cipher->name, cipher->blockSize);
+			return 1;
+		}
+	}
+
+	discoverTopology();
+	if (maxThreads <= 0 || maxThreads > MAX_THREADS)
+	{
+		maxThreads = nrCpus;
+	}
+
+	printf("%d CPUs, %d socket(s), %zu bytes x %ld passes per thread\n", nrCpus, nrSockets, length, passes);
+	printf("%-9s %-4s %-10s %-8s %-9s %7s %10s %8s %10s\n", "cipher", "mode", "context", "pinning", "placement", "threads", "MB/s", "speedup", "efficiency");
+
+	BENCH_random_bytes(key, sizeof(key));
+	shared = aligned_alloc(64, (sizeof(CipherContext) + 63) & ~(size_t)63);
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		CIPHER_init(shared, cipher->id, key, cipher->keyLengths[0]);
+
+		for (m = 0; m < MODE_COUNT; m++)
+		{
+			if (modeName != NULL && strcmp(modeName, MODES_name(m)) != 0)
+			{
+				continue;
+			}
+
+			for (replicate = 0; replicate <= 1; replicate++)
+			{
+				for (pinned = 0; pinned <= 1; pinned++)
+				{
+					// spreading over the sockets only differs when pinned on a multi-socket machine
+					for (placement = 0; placement <= (pinned && nrSockets > 1); placement++)
+					{
+						double single = 0;
+						int threads;
+
+						if (pinned)
+						{
+							placementOrder(placement, order);
+						}
+
+						for (threads = 1; threads <= maxThreads; threads = nextThreads(threads, maxThreads))
+						{
+							double throughput = runThreads(shared, m, threads, replicate, pinned ? order : NULL, length, passes);
+
+							if (threads == 1)
+							{
+								single = throughput;
+							}
+
+							printf("%-9s %-4s %-10s %-8s %-9s %7d %10.1f %8.2f %9.1f%%\n",
+								cipher->name, MODES_name(m),
+								replicate ? "replicated" : "shared",
+								pinned ? "pinned" : "unpinned",
+								pinned ? (placement ? "spread" : "compact") : "-",
+								threads, throughput, throughput / single, 100 * throughput / single / threads);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	free(shared);
+
+	return 0;
+}
\ No newline at end of file
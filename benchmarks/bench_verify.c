@@ -0,0 +1,412 @@
+/* bench_verify.c
+*
+ * Author: Vinicius Borba da Rocha
+ * Created: 18/10/2026
+ *
+ * Differential equivalence harness. Every kernel of every cipher and
+ * key length is checked against the reference single block routines:
+ *		- known answers: the SELFTEST vectors, in every lane of a batch
+ *		- edge cases: all-zero and all-ones keys and blocks, and for IDEA
+ *		  keys and blocks with zero 16 bits words (zero multiplicands)
+ *		- random keys (-k, 10000 by default) with random batches whose
+ *		  size cycles through 1 .. 4 * lanes + 3, so counts that are not
+ *		  a multiple of the lane count are covered, in and out of place
+ *
+ * The default of -k is sized for a quick check (a few seconds). For a
+ * deployment gate, raise it to millions of keys (-k 1000000 runs a few
+ * minutes), which gives tens of millions of blocks per kernel.
+ *
+ * Encryption and decryption are compared block by block with the
+ * reference, the first mismatch of each kernel is printed and the exit
+ * status is 1 when any check fails. CIPHER_init_many is compared with
+ * CIPHER_init on every key, context by context, for batches of random
+ * keys of 1 .. MAX_KEYS keys, and CIPHER_encrypt_keyed with CIPHER_init +
+ * CIPHER_encrypt, for 1 to 3 blocks per key.
+ *
+ */
+
+#include <string.h>
+
+#include "bench.h"
+#include "../algorithms/SELFTEST/SELFTEST.h"
+
+#define MAX_BATCH 256
+#define MAX_KEYS 150
+
+static uint8_t input[MAX_BATCH * CIPHER_MAX_BLOCK_SIZE];
+static uint8_t expected[MAX_BATCH * CIPHER_MAX_BLOCK_SIZE];
+static uint8_t output[MAX_BATCH * CIPHER_MAX_BLOCK_SIZE];
+static uint8_t keys[MAX_KEYS * CIPHER_MAX_KEY_SIZE];
+static CipherContext single[MAX_KEYS];
+static CipherContext many[MAX_KEYS];
+static int nrFailures;
+
+static void fromHex(const char* hex, uint8_t* out)
+{
+	size_t i;
+
+	for (i = 0; hex[2 * i] != 0; i++)
+	{
+		unsigned int value;
+
+		sscanf(hex + 2 * i, "%2x", &value);
+		out[i] = (uint8_t)value;
+	}
+}
+
+static void printHex(const char* label, const uint8_t* data, size_t length)
+{
+	size_t i;
+
+	printf("\t%-10s ", label);
+	for (i = 0; i < length; i++)
+	{
+		printf("%02x", data[i]);
+	}
+	printf("\n");
+}
+
+static int fail(CipherContext* context, const char* check, const uint8_t* key, size_t index, const uint8_t* got, const uint8_t* want)
+{
+	size_t blockSize = context->cipher->blockSize;
+
+	if (nrFailures++ < 10)
+	{
+		printf("FAIL %s %d %s: %s, block %zu\n", context->cipher->name, context->keyLen,
+			CIPHER_kernel_name(context->cipher, context->kernel), check, index);
+		printHex("key", key, context->keyLen / 8);
+		printHex("got", got, blockSize);
+		printHex("expected", want, blockSize);
+	}
+
+	return 0;
+}
+
+// one batch through the kernel of the context, against the reference
+static int checkBatch(CipherContext* context, const uint8_t* key, size_t nrBlocks, int inPlace)
+{
+	size_t blockSize = context->cipher->blockSize;
+	size_t i;
+
+	for (i = 0; i < nrBlocks; i++)
+	{
+		CIPHER_encrypt(context, input + i * blockSize, expected + i * blockSize);
+	}
+
+	memcpy(output, input, nrBlocks * blockSize);
+	CIPHER_encrypt_blocks(context, inPlace ? output : input, output, nrBlocks);
+	for (i = 0; i < nrBlocks; i++)
+	{
+		if (memcmp(output + i * blockSize, expected + i * blockSize, blockSize) != 0)
+		{
+			return fail(context, "encrypt", key, i, output + i * blockSize, expected + i * blockSize);
+		}
+	}
+
+	// decrypting the reference ciphertext must give the input back
+	memcpy(output, expected, nrBlocks * blockSize);
+	CIPHER_decrypt_blocks(context, inPlace ? output : expected, output, nrBlocks);
+	for (i = 0; i < nrBlocks; i++)
+	{
+		if (memcmp(output + i * blockSize, input + i * blockSize, blockSize) != 0)
+		{
+			return fail(context, "decrypt", key, i, output + i * blockSize, input + i * blockSize);
+		}
+	}
+
+	return 1;
+}
+
+static int checkKnownAnswers(const CipherDescriptor* cipher, int kernel)
+{
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	uint8_t ciphertext[CIPHER_MAX_BLOCK_SIZE];
+	CipherContext context;
+	size_t lanes = CIPHER_kernel_lanes(cipher, kernel);
+	size_t nrBlocks = 2 * lanes + 1;
+	const SelftestVector* vectors;
+	int nrVectors;
+	size_t i;
+	int v;
+
+	vectors = SELFTEST_vectors(&nrVectors);
+	for (v = 0; v < nrVectors; v++)
+	{
+		const SelftestVector* answer = &vectors[v];
+
+		if (answer->id != cipher->id)
+		{
+			continue;
+		}
+
+		fromHex(answer->key, key);
+		fromHex(answer->ciphertext, ciphertext);
+		CIPHER_init(&context, cipher->id, key, answer->keyLen);
+		CIPHER_set_kernel(&context, kernel);
+
+		// the vector in every lane of a batch
+		for (i = 0; i < nrBlocks; i++)
+		{
+			fromHex(answer->plaintext, input + i * cipher->blockSize);
+		}
+
+		CIPHER_encrypt_blocks(&context, input, output, nrBlocks);
+		for (i = 0; i < nrBlocks; i++)
+		{
+			if (memcmp(output + i * cipher->blockSize, ciphertext, cipher->blockSize) != 0)
+			{
+				return fail(&context, "known answer", key, i, output + i * cipher->blockSize, ciphertext);
+			}
+		}
+
+		if (!checkBatch(&context, key, nrBlocks, 0))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int checkEdgeCases(const CipherDescriptor* cipher, uint16_t keyLen, int kernel)
+{
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	CipherContext context;
+	size_t blockSize = cipher->blockSize;
+	size_t nrBlocks = 2 * CIPHER_kernel_lanes(cipher, kernel) + 1;
+	size_t i;
+	int k;
+
+	for (k = 0; k < 4; k++)
+	{
+		switch (k)
+		{
+		case 0:
+			memset(key, 0x00, sizeof(key));
+			break;
+		case 1:
+			memset(key, 0xff, sizeof(key));
+			break;
+		default:
+			// every other 16 bits word zero (IDEA subkeys and multiplicands)
+			BENCH_random_bytes(key, sizeof(key));
+			for (i = (k == 2 ? 0 : 2); i < sizeof(key); i += 4)
+			{
+				key[i] = 0;
+				key[i + 1] = 0;
+			}
+			break;
+		}
+
+		CIPHER_init(&context, cipher->id, key, keyLen);
+		CIPHER_set_kernel(&context, kernel);
+
+		// all-zero, all-ones and zero-word blocks, alternating
+		for (i = 0; i < nrBlocks * blockSize; i++)
+		{
+			switch (i / blockSize % 3)
+			{
+			case 0:
+				input[i] = 0x00;
+				break;
+			case 1:
+				input[i] = 0xff;
+				break;
+			default:
+				input[i] = (i / 2) % 2 ? 0x00 : (uint8_t)(i * 37 + 1);
+				break;
+			}
+		}
+
+		if (!checkBatch(&context, key, nrBlocks, 0) || !checkBatch(&context, key, nrBlocks, 1))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int checkRandom(const CipherDescriptor* cipher, uint16_t keyLen, int kernel, long nrKeys, long* nrBlocksChecked)
+{
+	uint8_t key[CIPHER_MAX_KEY_SIZE];
+	CipherContext context;
+	size_t maxBatch = 4 * CIPHER_kernel_lanes(cipher, kernel) + 3;
+	size_t nrBlocks;
+	long k;
+
+	if (maxBatch > MAX_BATCH)
+	{
+		maxBatch = MAX_BATCH;
+	}
+
+	for (k = 0; k < nrKeys; k++)
+	{
+		BENCH_random_bytes(key, sizeof(key));
+		CIPHER_init(&context, cipher->id, key, keyLen);
+		CIPHER_set_kernel(&context, kernel);
+
+		nrBlocks = 1 + k % maxBatch;
+		BENCH_random_bytes(input, nrBlocks * cipher->blockSize);
+
+		if (!checkBatch(&context, key, nrBlocks, k % 2))
+		{
+			return 0;
+		}
+		*nrBlocksChecked += nrBlocks;
+	}
+
+	return 1;
+}
+
+// contexts of CIPHER_init_many against those of CIPHER_init, byte by byte
+static int checkInitMany(const CipherDescriptor* cipher, uint16_t keyLen, long nrBatches)
+{
+	size_t keySize = keyLen / 8;
+	size_t nrKeys;
+	size_t i;
+	long b;
+
+	for (b = 0; b < nrBatches; b++)
+	{
+		nrKeys = 1 + b % MAX_KEYS;
+		BENCH_random_bytes(keys, nrKeys * keySize);
+
+		// zeroed, so the bytes a schedule leaves alone compare equal
+		memset(single, 0, nrKeys * sizeof(CipherContext));
+		memset(many, 0, nrKeys * sizeof(CipherContext));
+		for (i = 0; i < nrKeys; i++)
+		{
+			CIPHER_init(&single[i], cipher->id, keys + i * keySize, keyLen);
+		}
+		CIPHER_init_many(many, cipher->id, keys, keyLen, nrKeys);
+
+		for (i = 0; i < nrKeys; i++)
+		{
+			if (memcmp(&single[i], &many[i], sizeof(CipherContext)) != 0)
+			{
+				if (nrFailures++ < 10)
+				{
+					printf("FAIL %s %d: init_many context %zu of %zu differs from init\n", cipher->name, keyLen, i, nrKeys);
+					printHex("key", keys + i * keySize, keySize);
+				}
+				return 0;
+			}
+		}
+	}
+
+	return 1;
+}
+
+// CIPHER_encrypt_keyed against CIPHER_init + CIPHER_encrypt of every block
+static int checkEncryptKeyed(const CipherDescriptor* cipher, uint16_t keyLen, long nrBatches)
+{
+	size_t keySize = keyLen / 8;
+	size_t blockSize = cipher->blockSize;
+	size_t blocksPerKey;
+	size_t nrKeys;
+	size_t i;
+	long b;
+
+	for (b = 0; b < nrBatches; b++)
+	{
+		blocksPerKey = 1 + b % 3;
+		nrKeys = 1 + b % (MAX_BATCH / blocksPerKey < MAX_KEYS ? MAX_BATCH / blocksPerKey : MAX_KEYS);
+		BENCH_random_bytes(keys, nrKeys * keySize);
+		BENCH_random_bytes(input, nrKeys * blocksPerKey * blockSize);
+
+		for (i = 0; i < nrKeys * blocksPerKey; i++)
+		{
+			CIPHER_init(&single[0], cipher->id, keys + i / blocksPerKey * keySize, keyLen);
+			CIPHER_encrypt(&single[0], input + i * blockSize, expected + i * blockSize);
+		}
+		CIPHER_encrypt_keyed(cipher->id, keys, keyLen, input, output, nrKeys, blocksPerKey);
+
+		if (memcmp(output, expected, nrKeys * blocksPerKey * blockSize) != 0)
+		{
+			if (nrFailures++ < 10)
+			{
+				printf("FAIL %s %d: keyed encryption of %zu keys x %zu blocks differs from init + encrypt\n",
+					cipher->name, keyLen, nrKeys, blocksPerKey);
+			}
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+int BENCH_verify(int argc, char** argv)
+{
+	const CipherDescriptor* filter = BENCH_cipher_option(argc, argv);
+	long nrKeys = BENCH_long_option(argc, argv, "-k", 10000);
+	CipherStatus status;
+	uint64_t start;
+	uint64_t elapsed;
+	int i;
+	int k;
+	int l;
+
+	// the uncached power-on self-test of every cipher, as run on first use
+	start = BENCH_now();
+	status = CIPHER_OK;
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		if (SELFTEST_run(i) != CIPHER_OK)
+		{
+			status = CIPHER_ERROR_SELFTEST;
+		}
+	}
+	elapsed = BENCH_now() - start;
+	printf("selftest of every cipher: %s in %.1f us\n\n", status == CIPHER_OK ? "ok" : "FAIL", elapsed / 1000.0);
+	nrFailures += status != CIPHER_OK;
+
+	printf("%-9s %4s %-12s %6s %6s %10s  %s\n", "cipher", "key", "kernel", "KAT", "edges", "blocks", "result");
+
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		for (k = 0; k < CIPHER_kernel_count(cipher); k++)
+		{
+			int known = checkKnownAnswers(cipher, k);
+
+			for (l = 0; l < cipher->nrKeyLengths; l++)
+			{
+				long nrBlocks = 0;
+				int edges = checkEdgeCases(cipher, cipher->keyLengths[l], k);
+				int random = checkRandom(cipher, cipher->keyLengths[l], k, nrKeys, &nrBlocks);
+
+				printf("%-9s %4d %-12s %6s %6s %10ld  %s\n", cipher->name, cipher->keyLengths[l], CIPHER_kernel_name(cipher, k),
+					known ? "ok" : "FAIL", edges ? "ok" : "FAIL", nrBlocks, known && edges && random ? "ok" : "FAIL");
+			}
+		}
+	}
+
+	printf("\n%-9s %4s %-12s %6s\n", "cipher", "key", "", "result");
+	for (i = 0; i < CIPHER_COUNT; i++)
+	{
+		const CipherDescriptor* cipher = CIPHER_get(i);
+
+		if (filter != NULL && filter != cipher)
+		{
+			continue;
+		}
+
+		for (l = 0; l < cipher->nrKeyLengths; l++)
+		{
+			printf("%-9s %4d %-12s %6s\n", cipher->name, cipher->keyLengths[l], "init_many",
+				checkInitMany(cipher, cipher->keyLengths[l], 2 * MAX_KEYS) ? "ok" : "FAIL");
+			printf("%-9s %4d %-12s %6s\n", cipher->name, cipher->keyLengths[l], "keyed",
+				checkEncryptKeyed(cipher, cipher->keyLengths[l], 2 * MAX_KEYS) ? "ok" : "FAIL");
+		}
+	}
+
+	printf("%d failure(s)\n", nrFailures);
+	return nrFailures > 0 ? 1 : 0;
+}
\ No newline at end of file